@@ -0,0 +1,54 @@
+"""Runs RideDistributor with different time horizons and prints score and matrix size.
+
+Usage: python benchmark_horizon.py <RideDistributor> <input>... [-- <extra options>]
+Runs taking longer than TIMEOUT seconds are aborted.
+"""
+from sys import argv
+import re
+import os
+import subprocess
+import tempfile
+import time
+
+HORIZONS = [100, 1000, 5000, 20000, 0, -1]
+TIMEOUT = 600
+
+
+def run(binary, inputFile, horizon, extra):
+    command = [binary] + extra
+    if horizon >= 0:
+        command += ['--horizon', str(horizon)]
+    command += [inputFile, os.path.join(tempfile.gettempdir(), 'horizon.out')]
+
+    start = time.time()
+    try:
+        output = subprocess.run(command, capture_output=True, text=True,
+                                timeout=TIMEOUT).stdout
+    except subprocess.TimeoutExpired:
+        output = ''
+    seconds = time.time() - start
+
+    def value(pattern):
+        match = re.search(pattern, output)
+        return match.group(1) if match else '-'
+
+    return (value(r'Average score matrix width: ([\d.]+)'),
+            value(r'Score after assigning rides: (\d+)'),
+            value(r'Final score: (\d+)'), seconds)
+
+
+def main(binary, inputFiles, extra):
+    print('| Input | H | Columns | Assignment score | Final score | Time [s] |')
+    print('| :---- | -: | ------: | ---------------: | ----------: | -------: |')
+
+    for inputFile in inputFiles:
+        for horizon in HORIZONS:
+            name = {0: 'adaptive', -1: 'all'}.get(horizon, str(horizon))
+            columns, assigned, final, seconds = run(binary, inputFile, horizon, extra)
+            print(f'| {inputFile.split("/")[-1]} | {name} | {columns} | {assigned} | '
+                  f'{final} | {seconds:.1f} |', flush=True)
+
+
+if __name__ == '__main__':
+    split = argv.index('--') if '--' in argv else len(argv)
+    main(argv[1], argv[2:split], argv[split + 1:])
@@ -0,0 +1,66 @@
+"""Runs RideDistributor on synthetic inputs of growing size and prints score and time.
+
+Usage: python benchmark_scaling.py <build directory> [-- <extra options>]
+The inputs are created by RideInstanceGenerator as binary snapshots in the temporary
+directory. Runs taking longer than TIMEOUT seconds are aborted.
+"""
+from sys import argv
+import re
+import os
+import subprocess
+import tempfile
+import time
+
+# (rides, cars)
+SIZES = [(1000, 10), (10000, 100), (100000, 1000), (1000000, 10000)]
+DISTRIBUTIONS = ['uniform', 'hotspot', 'rush-hour']
+TIMEOUT = 600
+
+
+def generate(build, distribution, rides, cars):
+    path = os.path.join(tempfile.gettempdir(), f'scaling_{distribution}_{rides}.bin')
+    # steps grow with the number of rides per car, so that cars stay busy
+    subprocess.run([os.path.join(build, 'RideInstanceGenerator'), '--binary',
+                    '--distribution', distribution, '--rides', str(rides),
+                    '--cars', str(cars), '--steps', str(max(10000, rides * 1000 // cars)),
+                    path], check=True, capture_output=True)
+    return path
+
+
+def run(build, inputFile, extra):
+    command = [os.path.join(build, 'RideDistributor')] + extra
+    command += [inputFile, os.path.join(tempfile.gettempdir(), 'scaling.out')]
+
+    start = time.time()
+    try:
+        output = subprocess.run(command, capture_output=True, text=True,
+                                timeout=TIMEOUT).stdout
+    except subprocess.TimeoutExpired:
+        output = ''
+    seconds = time.time() - start
+
+    def value(pattern):
+        match = re.search(pattern, output)
+        return match.group(1) if match else '-'
+
+    return (value(r'Score after assigning rides: (\d+)'),
+            value(r'Final score: (\d+)'), seconds if output else '> ' + str(TIMEOUT))
+
+
+def main(build, extra):
+    print('| Distribution | Rides | Cars | Assignment score | Final score | Time [s] |')
+    print('| :----------- | ----: | ---: | ---------------: | ----------: | -------: |')
+
+    for distribution in DISTRIBUTIONS:
+        for rides, cars in SIZES:
+            inputFile = generate(build, distribution, rides, cars)
+            assigned, final, seconds = run(build, inputFile, extra)
+            seconds = f'{seconds:.1f}' if isinstance(seconds, float) else seconds
+            print(f'| {distribution} | {rides} | {cars} | {assigned} | {final} | '
+                  f'{seconds} |', flush=True)
+            os.remove(inputFile)
+
+
+if __name__ == '__main__':
+    split = argv.index('--') if '--' in argv else len(argv)
+    main(argv[1], argv[split + 1:])
@@ -1,48 +1,389 @@
+#include <algorithm>
+#include <chrono>
+#include <memory>
 #include <numeric>
 #include <cmath>
+#include <iomanip>
+#include <thread>
 #include "Algorithm.hpp"
+#include "LocalSearch.hpp"
+#include "Annealing.hpp"
+#include "Dispatcher.hpp"
+#include "StreamDispatcher.hpp"
+#include "Decomposition.hpp"
+#include "FlowPlanner.hpp"
+#include "SearchGraphNode.hpp"
 
-bool Algorithm::isCarDataValid(Types::CarData& carData, unsigned T) {
-    bool result = true;
+Algorithm::Algorithm(InputData& inputData, std::string outputPath, const Options& options,
+                     std::ostream& log) :
+    inputData(inputData), outputPath(outputPath), options(options), log(log),
+    portfolioNames(options.portfolio) {
+    // rides are only chained for the generators of the offline modes
+    const bool chained = options.chainLength > 1 && options.streamLead < 0;
 
-    for(int i = 0; i < carData.t.getSize(); i++) {
-        if(carData.t(i) > T) {
-            result = false;
-            break;
+    if(options.successors > 0 || chained) {
+        const unsigned maxSuccessors = options.successors > 0 ? options.successors :
+                                       CHAIN_SUCCESSORS;
+        const auto start = std::chrono::steady_clock::now();
+
+        if(!options.successorCache.empty()) {
+            try {
+                successors = SuccessorGraph::genCached(inputData, maxSuccessors,
+                                                       options.successorCache, options.threads);
+            } catch(const std::ios_base::failure&) {
+                log << "Can't write " << options.successorCache << ", successor graph not cached."
+                    << std::endl;
+            }
+        }
+
+        if(!successors) {
+            successors = SuccessorGraph::genFromInput(inputData, maxSuccessors, options.threads);
         }
+
+        log << "Successor graph has " << successors->getEdgeCount() << " edges ("
+            << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+            << " s)." << std::endl;
     }
 
-    return result;
+    if(chained) {
+        chains.reset(new RideChains(inputData, *successors, options.chainLength,
+                                    options.chainGap));
+        log << "Chained " << chains->getChainedCount() << " rides into jobs, "
+            << chains->getJobs()->nRides << " jobs." << std::endl;
+    }
+
+    generator = Generator::create(problem(), options.scoring);
+
+    if(portfolioNames.size() == 1 && portfolioNames[0] == "all") {
+        portfolioNames = Generator::scoringNames();
+    }
+
+    for(const std::string& name : portfolioNames) {
+        portfolio.push_back(Generator::create(problem(), name));
+    }
+
+    generator->setHorizon(options.horizon);
+    generator->setLookahead(options.lookahead, options.threads);
+    generator->setDualPruning(options.dualPruning);
+    generator->setApproximation(options.greedyColumns, options.auctionBids);
+    generator->setRLAPDeadline(options.rlapDeadline);
+
+    // the heuristics of the portfolio run concurrently, one thread each
+    for(std::unique_ptr<Generator>& heuristic : portfolio) {
+        heuristic->setHorizon(options.horizon);
+        heuristic->setLookahead(options.lookahead);
+        heuristic->setDualPruning(options.dualPruning);
+        heuristic->setApproximation(options.greedyColumns, options.auctionBids);
+        heuristic->setRLAPDeadline(options.rlapDeadline);
+    }
+
+    if(chains) {
+        generator->setJobPoints(chains->getPoints(), chains->getBonuses());
+
+        for(std::unique_ptr<Generator>& heuristic : portfolio) {
+            heuristic->setJobPoints(chains->getPoints(), chains->getBonuses());
+        }
+    }
+}
+
+InputData& Algorithm::problem() {
+    return chains ? *chains->getJobs() : inputData;
 }
 
-void Algorithm::printStatus(const std::vector<int>& unassigned) {
-    std::cout << std::round((inputData.nRides - unassigned.size()) * 100.0 / inputData.nRides)
-              << "% of rides are assigned." << std::endl;
+Solution Algorithm::toSolution(const SearchGraphNode& node) const {
+    return chains ? node.toSolution(inputData.fleetSize, chains->getMembers()) :
+           node.toSolution(inputData.fleetSize);
 }
 
-void Algorithm::run() {
-    std::vector<int> unassigned(inputData.nRides);
+void Algorithm::printStatus(const std::vector<int>& unassigned, const Generator& generator,
+                            const unsigned nActive, int& printed) {
+    const unsigned retired = generator.getRetiredCount();
+    const unsigned nRides = problem().nRides;
+    const int percentage = std::round((nRides - unassigned.size() - retired) * 100.0 / nRides);
+
+    // small batches of the event-driven mode would flood the console
+    if(percentage == printed) {return;}
+
+    printed = percentage;
+    log << percentage << "% of rides are assigned, " << retired << " retired, "
+        << nActive << " cars active." << std::endl;
+}
+
+RoutePlan Algorithm::solve(Generator& generator, const Deadline& deadline,
+                           const double reserve, Checkpoint* checkpoint, const bool verbose,
+                           const unsigned nThreads) {
+    std::vector<int> unassigned(problem().nRides);
     std::iota(unassigned.begin(), unassigned.end(), 0);
     Types::CarData cars(inputData.fleetSize);
-    std::shared_ptr<SearchGraphNode> root;
+    std::shared_ptr<SearchGraphNode> currentNode;
+
+    // lockstep rounds over all active cars or event-driven batches
+    const bool eventDriven = options.dispatchWindow >= 0;
+    Dispatcher dispatcher(generator, options.dispatchWindow);
+    auto generate = [&]() {
+        return eventDriven ? dispatcher.generate(unassigned, cars, currentNode) :
+               generator.generate(unassigned, cars, currentNode);
+    };
+    auto countActive = [&]() -> unsigned {
+        return eventDriven ? dispatcher.getActiveCount() : generator.getActiveCars().size();
+    };
+
+    if(eventDriven) {dispatcher.reset(cars);}
+
+    // local, the heuristics of the portfolio solve concurrently
+    int printedPercentage = -1;
+    auto iterationStart = std::chrono::steady_clock::now();
+    currentNode = generate();
+    double iterationTime = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                           iterationStart).count();
+
+    if(verbose) {printStatus(unassigned, generator, countActive(), printedPercentage);}
+
+    // stop early if the next iteration probably won't finish before the deadline
+    while(unassigned.size() > 0 && countActive() > 0 &&
+          !deadline.expired(reserve + 2 * iterationTime)) {
+        if(checkpoint && currentNode && checkpoint->isDue()) {
+            Solution solution = toSolution(*currentNode);
+            checkpoint->offer(solution, RoutePlan(inputData, solution).getScore());
+        }
+
+        iterationStart = std::chrono::steady_clock::now();
+        currentNode = generate();
+        iterationTime = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                        iterationStart).count();
+
+        if(verbose) {printStatus(unassigned, generator, countActive(), printedPercentage);}
+    }
+
+    // post-optimization of the found routes
+    RoutePlan plan(inputData, currentNode ? toSolution(*currentNode) :
+                   Solution(inputData.fleetSize));
+
+    if(verbose) {
+        log << "Score after assigning rides: " << plan.getScore() << std::endl;
+        log << "Retired rides saved " << generator.getSavedColumns() << " matrix columns."
+            << std::endl;
+        log << "Average score matrix width: " << generator.getAverageColumns() << " columns."
+            << std::endl;
+
+        if(options.lookahead > 0) {
+            log << "Lookahead computed " << generator.getRecomputedFollowUps()
+                << " follow-up values." << std::endl;
+        }
+
+        if(options.dualPruning >= 0) {
+            log << "Reduced costs pruned " << generator.getPrunedColumns() << " columns ("
+                << 100 * generator.getPrunedShare() << "% of all columns), "
+                << generator.getUncertifiedIterations()
+                << " iterations uncertified (loss at most "
+                << generator.getPruningLossBound() << ")." << std::endl;
+        }
+
+        if(options.greedyColumns > 0) {
+            log << "Greedy regret solved " << generator.getApproximatedIterations()
+                << " RLAPs." << std::endl;
+        }
+
+        if(options.rlapDeadline > 0) {
+            log << "RLAP deadline expired " << generator.getDeadlineHits()
+                << " times (loss at most " << generator.getDeadlineLossBound()
+                << ", at most " << generator.getMaxDeadlineLoss() << " per RLAP)." << std::endl;
+        }
+    }
+
+    if(checkpoint) {
+        checkpoint->offer(plan.toSolution(), plan.getScore());
+    }
+
+    const unsigned nMoves = LocalSearch(inputData, nThreads).run(plan, deadline, reserve);
+
+    if(verbose) {log << "Local search applied " << nMoves << " moves." << std::endl;}
+
+    if(checkpoint) {
+        checkpoint->offer(plan.toSolution(), plan.getScore());
+    }
 
-    std::shared_ptr<SearchGraphNode> currentNode = generator.generate(unassigned, cars, root);
+    return plan;
+}
+
+RoutePlan Algorithm::runPortfolio(const Deadline& deadline, const double reserve,
+                                  Checkpoint* checkpoint) {
+    std::vector<std::unique_ptr<RoutePlan>> plans(portfolio.size());
+    std::vector<double> times(portfolio.size());
+    std::vector<std::thread> threads;
 
-    printStatus(unassigned);
+    // the input data is only read, all heuristics share it
+    for(unsigned i = 0; i < portfolio.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            const auto start = std::chrono::steady_clock::now();
+            plans[i].reset(new RoutePlan(solve(*portfolio[i], deadline, reserve, checkpoint,
+                                               false, 1)));
+            times[i] = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                       start).count();
+        });
+    }
 
-    while(unassigned.size() > 0 && isCarDataValid(cars, inputData.maxTime)) {
-        currentNode = generator.generate(unassigned, cars, currentNode);
-        printStatus(unassigned);
+    for(std::thread& thread : threads) {
+        thread.join();
     }
 
-    unsigned score = 0;
+    unsigned best = 0;
 
-    for(int i = 0; i < inputData.fleetSize; ++i) {
-        score += cars.p(i);
+    for(unsigned i = 1; i < plans.size(); ++i) {
+        if(plans[i]->getScore() > plans[best]->getScore()) {best = i;}
     }
 
-    std::cout << "Final score: " << score << std::endl;
+    const std::ios::fmtflags flags = log.flags();
+    const std::streamsize precision = log.precision();
+    log << std::left << std::setw(16) << "Heuristic" << std::setw(12) << "Score"
+        << "Time [s]" << std::endl;
+
+    for(unsigned i = 0; i < plans.size(); ++i) {
+        log << std::setw(16) << portfolioNames[i] << std::setw(12)
+            << plans[i]->getScore() << std::fixed << std::setprecision(2) << times[i]
+            << (i == best ? "  (best)" : "") << std::endl;
+    }
+
+    log.flags(flags);
+    log.precision(precision);
+    log << "Heuristic " << portfolioNames[best] << " won." << std::endl;
+    return *plans[best];
+}
+
+RoutePlan Algorithm::runDecomposition(const Deadline& deadline, const double reserve,
+                                      Checkpoint* checkpoint) {
+    Decomposition decomposition(inputData, options.scoring, options.regions,
+                                options.timeSlices, options.horizon, options.threads);
+    const auto start = std::chrono::steady_clock::now();
+    RoutePlan plan = decomposition.run(deadline, reserve);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                           start).count();
+
+    log << "Solved " << decomposition.getSubproblemCount() << " subproblems in "
+        << seconds << " s, score: " << decomposition.getRegionScore() << std::endl;
+    log << "Border exchange assigned " << decomposition.getExchanged() << " rides."
+        << std::endl;
+    log << "Score after assigning rides: " << plan.getScore() << std::endl;
+
+    if(checkpoint) {
+        checkpoint->offer(plan.toSolution(), plan.getScore());
+    }
+
+    const unsigned nMoves = LocalSearch(inputData, options.threads).run(plan, deadline, reserve);
+    log << "Local search applied " << nMoves << " moves." << std::endl;
+
+    if(checkpoint) {
+        checkpoint->offer(plan.toSolution(), plan.getScore());
+    }
+
+    return plan;
+}
+
+RoutePlan Algorithm::runFlow(const Deadline& deadline, const double reserve,
+                             Checkpoint* checkpoint) {
+    FlowPlanner planner(inputData, options.flowChain);
+    const auto start = std::chrono::steady_clock::now();
+    RoutePlan plan = planner.run(deadline, reserve);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                           start).count();
+
+    log << "Min-cost flow assigned " << planner.getAssigned() << " rides in "
+        << planner.getSolveCount() << " solves (" << seconds << " s)." << std::endl;
+    log << "Score after assigning rides: " << plan.getScore() << std::endl;
+
+    if(checkpoint) {
+        checkpoint->offer(plan.toSolution(), plan.getScore());
+    }
+
+    const unsigned nMoves = LocalSearch(inputData, options.threads).run(plan, deadline, reserve);
+    log << "Local search applied " << nMoves << " moves." << std::endl;
+
+    if(checkpoint) {
+        checkpoint->offer(plan.toSolution(), plan.getScore());
+    }
+
+    return plan;
+}
+
+long Algorithm::runStream() {
+    StreamDispatcher dispatcher(inputData, *generator, options.streamLead,
+                                std::max(options.dispatchWindow, 0));
+    const StreamDispatcher::Report report = dispatcher.run();
+    const RoutePlan plan(inputData, report.solution);
+
+    log << "Assigned " << report.assigned << " of " << inputData.nRides
+        << " streamed rides, score: " << plan.getScore() << std::endl;
+    log << "Decision latency (" << report.latencies.size() << " decisions): p50 "
+        << report.latency(0.5) * 1000 << " ms, p99 " << report.latency(0.99) * 1000
+        << " ms, max " << report.latency(1) * 1000 << " ms" << std::endl;
+    log << "Throughput: " << report.throughput(inputData.nRides) << " rides/s"
+        << std::endl;
+
+    log << "Writing output to: " << outputPath << std::endl;
+    report.solution.writeToFile(outputPath);
+    return plan.getScore();
+}
+
+void Algorithm::setWorkspace(std::shared_ptr<Generator::Workspace> workspace) {
+    generator->setWorkspace(workspace);
+}
+
+RoutePlan Algorithm::computeRoutes(const Deadline& deadline, const double reserve,
+                                   Checkpoint* checkpoint) {
+    const RoutePlan plan = options.flowChain > 0 ? runFlow(deadline, reserve, checkpoint) :
+                           options.regions > 1 || options.timeSlices > 1 ?
+                           runDecomposition(deadline, reserve, checkpoint) :
+                           portfolio.empty() ?
+                           solve(*generator, deadline, reserve, checkpoint, true,
+                                 options.threads) :
+                           runPortfolio(deadline, reserve, checkpoint);
+
+    // annealing only runs if asked for, the deadline caps its time
+    double timeLimit = options.timeLimit;
+
+    if(deadline.isSet()) {
+        timeLimit = std::min(timeLimit, std::max(0.0, deadline.remaining() - reserve));
+    }
+
+    if(timeLimit <= 0) {
+        log << "Final score: " << plan.getScore() << std::endl;
+        return plan;
+    }
+
+    RoutePlan improved(inputData, Annealing(inputData, timeLimit,
+                                            options.threads).run(plan, checkpoint));
+
+    log << "Final score: " << improved.getScore() << std::endl;
+    return improved;
+}
+
+long Algorithm::run() {
+    if(options.streamLead >= 0) {
+        return runStream();
+    }
+
+    const Deadline deadline(options.deadline);
+    std::unique_ptr<Checkpoint> checkpoint;
+    // time reserved to write the final solution
+    double reserve = 0;
+
+    // anytime mode: an empty solution is a valid output from the start
+    if(deadline.isSet()) {
+        checkpoint.reset(new Checkpoint(outputPath, options.checkpointInterval, deadline));
+        checkpoint->offer(Solution(inputData.fleetSize), 0);
+        reserve = 2 * checkpoint->getSafetyMargin();
+    }
+
+    const RoutePlan improved = computeRoutes(deadline, reserve, checkpoint.get());
+
+    log << "Writing output to: " << outputPath << std::endl;
+
+    if(checkpoint) {
+        checkpoint->offer(improved.toSolution(), improved.getScore());
+        checkpoint->flush();
+    } else {
+        improved.toSolution().writeToFile(outputPath);
+    }
 
-    std::cout << "Writing output to: " << outputPath << std::endl;
-    currentNode->writeToFile(outputPath, inputData.fleetSize);
+    return improved.getScore();
 }
@@ -1,15 +1,23 @@
 #ifndef ALGORITHM_H
 #define ALGORHITM_H
 
+#include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 #include "InputData.hpp"
+#include "SuccessorGraph.hpp"
+#include "RideChains.hpp"
+#include "Options.hpp"
 #include "Generator.hpp"
+#include "RoutePlan.hpp"
+#include "Deadline.hpp"
+#include "Checkpoint.hpp"
 
 /**
  * Algorithm solving the problem statement of the HashCode online quallification round 2018
  * by build a search graph containing available choices.
- * Only the best choices are taken into consideration until there all rides has been assigned or no new ones can be assigned anymore.
+ * Only the best choices are taken into consideration until there all rides has been assigned or no car can finish any of them in time anymore.
  */
 class Algorithm {
 public:
@@ -19,40 +27,157 @@ public:
      *
      * \param [in]	inputData	InputData representing the simulation enviroment.
      * \param [out]	outputPath	Path of output file containing the calculated solution.
+     * \param [in]	options		Options of the improvement stages.
+     * \param [out]	log		Stream the progress is printed to.
+     * \throw std::invalid_argument if a scoring heuristic of the options is unknown
      */
-    Algorithm(InputData& inputData, std::string outputPath) :
-        inputData(inputData), outputPath(outputPath), generator(inputData) {};
+    Algorithm(InputData& inputData, std::string outputPath,
+              const Options& options = Options(), std::ostream& log = std::cout);
+
+    /**
+     * Lets the generator reuse the matrices of a workspace (see Generator::setWorkspace).
+     * Heuristics of the portfolio keep their own workspaces.
+     *
+     * \param [in]	workspace	Matrices reused by the generator.
+     */
+    void setWorkspace(std::shared_ptr<Generator::Workspace> workspace);
+
+    /**
+     * Successors of the rides built at load time.
+     *
+     * \return std::shared_ptr<const SuccessorGraph> graph (nullptr: neither Options#successors
+     *         nor Options#chainLength is set)
+     */
+    std::shared_ptr<const SuccessorGraph> getSuccessors() const {return successors;}
 
     /**
      * Run the algorithm, until all rides have been assigned or no new ones can be assigned anymore.
      * Best choice is writen to the outputPath.
+     *
+     * \return long score of the written solution.
      */
-    void run();
+    long run();
+
+    /**
+     * Assigns rides and improves the routes by all enabled stages without writing them
+     * (offline modes only, Options#streamLead is ignored).
+     *
+     * \param [in]	deadline	Deadline of the whole computation.
+     * \param [in]	reserve		Seconds before the deadline at which the stages stop.
+     * \param [in,out]	checkpoint	Receives intermediate solutions in anytime mode (optional).
+     * \return RoutePlan routes found.
+     */
+    RoutePlan computeRoutes(const Deadline& deadline = Deadline(), const double reserve = 0,
+                            Checkpoint* checkpoint = nullptr);
 
 private:
 
+    /** Successors per ride of the graph built for RideChains if Options#successors is 0. */
+    static constexpr unsigned CHAIN_SUCCESSORS = 8;
+
+    /**
+     * InputData the generators work on.
+     *
+     * \return InputData& the jobs if rides are chained, otherwise the InputData
+     */
+    InputData& problem();
+
+    /**
+     * Creates the routes of all cars from a search path of the generators.
+     *
+     * \param [in] node last node of the search path
+     * \return Solution routes of the rides (jobs are expanded)
+     */
+    Solution toSolution(const SearchGraphNode& node) const;
+
+    /**
+     * Assigns rides using a generator until all rides have been assigned, no active car is
+     * left or the deadline is near, then improves the routes by local search.
+     *
+     * \param [in,out]	generator	Generator trying to find the best choices.
+     * \param [in]	deadline	Deadline of the whole run.
+     * \param [in]	reserve		Seconds before the deadline reserved to write the output.
+     * \param [in,out]	checkpoint	Receives intermediate solutions in anytime mode (optional).
+     * \param [in]	verbose		Print the progress to Algorithm#log.
+     * \param [in]	nThreads	Number of threads of the local search (0: one per core).
+     * \return RoutePlan routes found.
+     */
+    RoutePlan solve(Generator& generator, const Deadline& deadline, const double reserve,
+                    Checkpoint* checkpoint, const bool verbose, const unsigned nThreads);
+
+    /**
+     * Runs Algorithm#solve for all heuristics of Options#portfolio concurrently, one thread
+     * each, and prints the score and time of each heuristic.
+     *
+     * \param [in]	deadline	Deadline of the whole run.
+     * \param [in]	reserve		Seconds before the deadline reserved to write the output.
+     * \param [in,out]	checkpoint	Receives intermediate solutions in anytime mode (optional).
+     * \return RoutePlan best routes found by any heuristic.
+     */
+    RoutePlan runPortfolio(const Deadline& deadline, const double reserve,
+                           Checkpoint* checkpoint);
+
+    /**
+     * Assigns rides by solving regions of the grid independently (see Decomposition),
+     * then improves the routes by local search.
+     *
+     * \param [in]	deadline	Deadline of the whole run.
+     * \param [in]	reserve		Seconds before the deadline reserved to write the output.
+     * \param [in,out]	checkpoint	Receives intermediate solutions in anytime mode (optional).
+     * \return RoutePlan routes found.
+     */
+    RoutePlan runDecomposition(const Deadline& deadline, const double reserve,
+                               Checkpoint* checkpoint);
+
+    /**
+     * Assigns chains of rides to the cars by min-cost flows (see FlowPlanner), then improves
+     * the routes by local search.
+     *
+     * \param [in]	deadline	Deadline of the whole run.
+     * \param [in]	reserve		Seconds before the deadline reserved to write the output.
+     * \param [in,out]	checkpoint	Receives intermediate solutions in anytime mode (optional).
+     * \return RoutePlan routes found.
+     */
+    RoutePlan runFlow(const Deadline& deadline, const double reserve, Checkpoint* checkpoint);
+
     /**
-     * Check if carData is still within a given simulation time.
+     * Online mode: replays the input as a stream of rides (see StreamDispatcher), prints the
+     * decision latencies and throughput and writes the committed routes.
      *
-     * \param [in]	carData	CarData to check.
-     * \param [in]	T		Max. valid simulation time.
-     * \return bool true if carData is valid, otherwise false.
+     * \return long score of the committed routes.
      */
-    bool isCarDataValid(Types::CarData& carData, unsigned T);
+    long runStream();
 
     /**
-     * Prints the percentage of assigned rides
+     * Prints the percentage of assigned rides, the number of retired rides and active cars
+     * if the percentage changed since the last call.
      *
      * \param unassigned indices of all unassigned rides
+     * \param generator Generator retiring rides
+     * \param nActive number of active cars
+     * \param printed percentage printed last by the calling solve (updated)
      */
-    void printStatus(const std::vector<int>& unassigned);
+    void printStatus(const std::vector<int>& unassigned, const Generator& generator,
+                     const unsigned nActive, int& printed);
 
     /** InputData representing the simulation enviroment. */
     InputData& inputData;
     /** Path of output file. */
     std::string outputPath;
+    /** Options of the improvement stages. */
+    Options options;
+    /** Stream the progress is printed to. */
+    std::ostream& log;
     /** Generator trying to find the best choices. */
-    Generator generator;
+    std::unique_ptr<Generator> generator;
+    /** Names of the scoring heuristics of the portfolio (see Options#portfolio). */
+    std::vector<std::string> portfolioNames;
+    /** Generators of the portfolio. */
+    std::vector<std::unique_ptr<Generator>> portfolio;
+    /** Successors of the rides, built at load time (nullptr: not needed). */
+    std::shared_ptr<const SuccessorGraph> successors;
+    /** Composite jobs the generators work on (nullptr: rides aren't chained). */
+    std::unique_ptr<RideChains> chains;
 };
 
 #endif // ALGORITHM_H
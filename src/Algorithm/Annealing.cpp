@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "Annealing.hpp"
+
+/** Number of iterations between two checks of the clock. */
+#define CLOCK_CHECK_INTERVAL 256
+
+struct Annealing::SharedBest {
+    /** Guards all members. */
+    std::mutex mutex;
+    /** Best solution of all chains. */
+    Solution solution;
+    /** Score of Annealing::SharedBest::solution. */
+    long score;
+};
+
+Annealing::Annealing(const InputData& inputData, const double timeLimit,
+                     const unsigned nChains, const double exchangeInterval, const unsigned seed):
+    inputData(inputData), timeLimit(timeLimit), nChains(nChains),
+    exchangeInterval(exchangeInterval), seed(seed) {
+    if(this->nChains == 0) {
+        this->nChains = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // at the start losing a tenth of a ride of average length (with bonus) is accepted with a
+    // probability of 1/e, losing a whole one with exp(-10) (about 4.5e-5)
+    double meanDistance = 0;
+
+    for(unsigned ride = 0; ride < inputData.nRides; ++ride) {
+        meanDistance += inputData.distances(ride);
+    }
+
+    meanDistance /= std::max(1u, inputData.nRides);
+    startTemperature = std::max(1.0, 0.1 * (meanDistance + inputData.bonus));
+    endTemperature = 0.1;
+}
+
+bool Annealing::step(RoutePlan& plan, const double temperature, std::mt19937& rng,
+                     unsigned& carA, unsigned& carB) const {
+    auto randomIndex = [&rng](const unsigned n) {
+        return std::uniform_int_distribution<unsigned>(0, n - 1)(rng);
+    };
+    // position next to the slot of a point in time (randomly before or after the slot)
+    auto randomSlot = [&rng, &plan](const unsigned car, const int time) {
+        const unsigned slot = plan.slotOf(car, time);
+        return slot > 0 && (rng() & 1) ? slot - 1 : slot;
+    };
+
+    enum MoveType { RELOCATE, SWAP, EXCHANGE, INSERT, REMOVE, N_MOVE_TYPES };
+    const MoveType type = static_cast<MoveType>(randomIndex(N_MOVE_TYPES));
+    carA = randomIndex(plan.getRouteCount());
+    carB = randomIndex(plan.getRouteCount());
+    const std::vector<unsigned>& ridesA = plan.getRoute(carA).rides;
+    const std::vector<unsigned>& ridesB = plan.getRoute(carB).rides;
+    const std::vector<unsigned>& unassigned = plan.getUnassigned();
+    unsigned posA = 0, posB = 0, ride = 0;
+    int delta;
+
+    switch(type) {
+    case RELOCATE:
+        if(ridesA.empty() || carA == carB) {return false;}
+
+        posA = randomIndex(ridesA.size());
+        posB = randomSlot(carB, inputData.startT(ridesA[posA]));
+        delta = plan.removeDelta(carA, posA) + plan.insertDelta(carB, posB, ridesA[posA]);
+        break;
+
+    case SWAP:
+        if(ridesA.empty() || ridesB.empty() || carA == carB) {return false;}
+
+        posA = randomIndex(ridesA.size());
+        posB = std::min<unsigned>(randomSlot(carB, inputData.startT(ridesA[posA])),
+                                  ridesB.size() - 1);
+        delta = plan.replaceDelta(carA, posA, ridesB[posB]) +
+                plan.replaceDelta(carB, posB, ridesA[posA]);
+        break;
+
+    case EXCHANGE:
+        if(carA == carB) {return false;}
+
+        posA = randomIndex(ridesA.size() + 1);
+        posB = randomSlot(carB, plan.stateAfter(carA, posA).t);
+        delta = plan.exchangeDelta(carA, posA, carB, posB);
+        break;
+
+    case INSERT:
+        if(unassigned.empty()) {return false;}
+
+        carB = carA;
+        ride = unassigned[randomIndex(unassigned.size())];
+        posA = randomSlot(carA, inputData.startT(ride));
+        delta = plan.insertDelta(carA, posA, ride);
+        break;
+
+    default:
+        if(ridesA.empty()) {return false;}
+
+        carB = carA;
+        posA = randomIndex(ridesA.size());
+        delta = plan.removeDelta(carA, posA);
+        break;
+    }
+
+    if(delta < 0 &&
+       std::uniform_real_distribution<double>(0, 1)(rng) >= std::exp(delta / temperature)) {
+        return false;
+    }
+
+    switch(type) {
+    case RELOCATE:
+        plan.relocate(carA, posA, carB, posB);
+        break;
+
+    case SWAP:
+        plan.swap(carA, posA, carB, posB);
+        break;
+
+    case EXCHANGE:
+        plan.exchange(carA, posA, carB, posB);
+        break;
+
+    case INSERT:
+        plan.insert(carA, posA, ride);
+        break;
+
+    default:
+        plan.remove(carA, posA);
+        break;
+    }
+
+    return true;
+}
+
+void Annealing::runChain(const RoutePlan& plan, const unsigned chain,
+                         SharedBest& shared, Checkpoint* checkpoint) const {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    const Clock::duration budget = std::chrono::duration_cast<Clock::duration>
+                                   (std::chrono::duration<double>(timeLimit));
+    const Clock::duration interval = std::chrono::duration_cast<Clock::duration>
+                                     (std::chrono::duration<double>(exchangeInterval));
+    Clock::time_point nextExchange = start + interval;
+
+    std::mt19937 rng(seed + chain);
+    std::unique_ptr<RoutePlan> current(new RoutePlan(plan));
+    Solution best = plan.toSolution();
+    long bestScore = plan.getScore();
+    double temperature = startTemperature;
+
+    // routes that differ between the current and the best solution
+    std::vector<bool> changed(plan.getRouteCount(), false);
+    std::vector<unsigned> changedCars;
+
+    for(unsigned long iteration = 0;; ++iteration) {
+        if(iteration % CLOCK_CHECK_INTERVAL == 0) {
+            const Clock::time_point now = Clock::now();
+
+            if(now - start >= budget) {break;}
+
+            // geometric cooling over the time budget
+            const double progress = std::chrono::duration<double>(now - start).count() / timeLimit;
+            temperature = startTemperature * std::pow(endTemperature / startTemperature, progress);
+
+            if(now >= nextExchange) {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+
+                if(bestScore > shared.score) {
+                    shared.solution = best;
+                    shared.score = bestScore;
+                } else if(shared.score > bestScore) {
+                    best = shared.solution;
+                    bestScore = shared.score;
+                    current.reset(new RoutePlan(inputData, best));
+
+                    for(unsigned car : changedCars) {changed[car] = false;}
+
+                    changedCars.clear();
+                }
+
+                if(checkpoint && checkpoint->isDue()) {
+                    checkpoint->offer(shared.solution, shared.score);
+                }
+
+                nextExchange = now + interval;
+            }
+        }
+
+        unsigned carA, carB;
+
+        if(!step(*current, temperature, rng, carA, carB)) {continue;}
+
+        for(unsigned car : {carA, carB}) {
+            if(!changed[car]) {
+                changed[car] = true;
+                changedCars.push_back(car);
+            }
+        }
+
+        // only routes changed since the last improvement have to be copied
+        if(current->getScore() > bestScore) {
+            for(unsigned car : changedCars) {
+                best.routes[car] = current->getRoute(car).rides;
+                changed[car] = false;
+            }
+
+            changedCars.clear();
+            bestScore = current->getScore();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    if(bestScore > shared.score) {
+        shared.solution = best;
+        shared.score = bestScore;
+    }
+}
+
+Solution Annealing::run(const RoutePlan& plan, Checkpoint* checkpoint) const {
+    SharedBest shared;
+    shared.solution = plan.toSolution();
+    shared.score = plan.getScore();
+
+    if(timeLimit <= 0) {
+        return shared.solution;
+    }
+
+    std::vector<std::thread> threads;
+
+    for(unsigned chain = 0; chain < nChains; ++chain) {
+        threads.emplace_back(&Annealing::runChain, this, std::cref(plan), chain,
+                             std::ref(shared), checkpoint);
+    }
+
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    return shared.solution;
+}
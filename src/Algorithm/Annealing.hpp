@@ -0,0 +1,93 @@
+#ifndef ANNEALING_H
+#define ANNEALING_H
+
+#include <random>
+#include "InputData.hpp"
+#include "Solution.hpp"
+#include "RoutePlan.hpp"
+#include "Checkpoint.hpp"
+
+/**
+ * Time-budgeted improvement of a solution by simulated annealing.
+ *
+ * One independent chain runs per thread. Each chain applies random relocate, swap,
+ * exchange, insert and remove moves (see RoutePlan) and accepts worse solutions with a
+ * probability that decreases with the remaining time. The chains periodically exchange
+ * their best solutions: chains that fell behind continue from the best one found so far.
+ */
+class Annealing {
+public:
+
+    /**
+     * Creates an annealing engine.
+     *
+     * \param [in] inputData InputData representing the simulation enviroment
+     * \param [in] timeLimit wall-clock budget in seconds
+     * \param [in] nChains number of parallel chains (0: one per core)
+     * \param [in] exchangeInterval seconds between two exchanges of the best solution
+     * \param [in] seed seed of the random number generators
+     */
+    Annealing(const InputData& inputData, const double timeLimit, const unsigned nChains = 0,
+              const double exchangeInterval = 1.0, const unsigned seed = 0);
+
+    /**
+     * Improves a solution until the time limit is reached.
+     *
+     * \param [in] plan initial solution of all chains
+     * \param [in,out] checkpoint receives the best solution at every exchange (optional)
+     * \return Solution best solution found (never worse than the initial one)
+     */
+    Solution run(const RoutePlan& plan, Checkpoint* checkpoint = nullptr) const;
+
+private:
+
+    /** Best solution shared between all chains. */
+    struct SharedBest;
+
+    /**
+     * Runs a single annealing chain.
+     *
+     * \param [in] plan initial solution
+     * \param [in] chain index of the chain (used for seeding)
+     * \param [in,out] shared best solution of all chains
+     * \param [in,out] checkpoint receives the best solution at every exchange (optional)
+     */
+    void runChain(const RoutePlan& plan, const unsigned chain, SharedBest& shared,
+                  Checkpoint* checkpoint) const;
+
+    /**
+     * Proposes a random move, applies it if it's accepted.
+     *
+     * \param [in,out] plan current solution of the chain
+     * \param [in] temperature current temperature
+     * \param [in,out] rng random number generator of the chain
+     * \param [out] carA first changed route
+     * \param [out] carB second changed route
+     * \return bool true if the move was accepted
+     */
+    bool step(RoutePlan& plan, const double temperature, std::mt19937& rng,
+              unsigned& carA, unsigned& carB) const;
+
+    /** InputData representing the simulation enviroment. */
+    const InputData& inputData;
+
+    /** Wall-clock budget in seconds. */
+    const double timeLimit;
+
+    /** Number of parallel chains. */
+    unsigned nChains;
+
+    /** Seconds between two exchanges of the best solution. */
+    const double exchangeInterval;
+
+    /** Seed of the random number generators. */
+    const unsigned seed;
+
+    /** Temperature at the start of the annealing process. */
+    double startTemperature;
+
+    /** Temperature at the end of the annealing process. */
+    double endTemperature;
+};
+
+#endif // ANNEALING_H
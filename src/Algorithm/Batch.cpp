@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include "Batch.hpp"
+#include "InputData.hpp"
+#include "Algorithm.hpp"
+
+/**
+ * Checks if a file name matches a pattern.
+ *
+ * \param [in] name file name
+ * \param [in] pattern file name containing wildcards (*: any characters, ?: one character)
+ * \return bool true if the name matches
+ */
+static bool matches(const std::string& name, const std::string& pattern) {
+    // position after the last * and the name position it has been matched up to
+    std::size_t star = std::string::npos;
+    std::size_t starName = 0;
+    std::size_t n = 0;
+    std::size_t p = 0;
+
+    while(n < name.size()) {
+        if(p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            ++n;
+            ++p;
+        } else if(p < pattern.size() && pattern[p] == '*') {
+            star = ++p;
+            starName = n;
+        } else if(star != std::string::npos) {
+            p = star;
+            n = ++starName;
+        } else {
+            return false;
+        }
+    }
+
+    while(p < pattern.size() && pattern[p] == '*') {++p;}
+
+    return p == pattern.size();
+}
+
+std::vector<std::string> Batch::expand(const std::string& pattern) {
+    const std::filesystem::path path(pattern);
+    const std::string name = path.filename().string();
+
+    if(name.find_first_of("*?") == std::string::npos) {
+        return std::filesystem::is_regular_file(path) ? std::vector<std::string>({pattern}) :
+               std::vector<std::string>();
+    }
+
+    const std::filesystem::path directory = path.has_parent_path() ? path.parent_path() : ".";
+    std::vector<std::string> result;
+    std::error_code error;
+
+    for(const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if(entry.is_regular_file() && matches(entry.path().filename().string(), name)) {
+            result.push_back((path.has_parent_path() ? directory / entry.path().filename() :
+                              entry.path().filename()).string());
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+Batch::Batch(const Options& options): options(options) {
+    // input file of each output file, two jobs must not overwrite each other's solution
+    std::map<std::string, std::string> outputs;
+
+    for(const std::string& pattern : options.inputPaths) {
+        const std::vector<std::string> paths = expand(pattern);
+
+        if(paths.empty()) {
+            throw std::invalid_argument("No input file matches: " + pattern);
+        }
+
+        for(const std::string& path : paths) {
+            Job job;
+            job.inputPath = path;
+            std::filesystem::path output(options.batchDirectory);
+            output /= std::filesystem::path(path).stem();
+            job.outputPath = output.string() + ".out";
+            const auto inserted = outputs.emplace(job.outputPath, path);
+
+            if(!inserted.second) {
+                throw std::invalid_argument("Input files " + inserted.first->second + " and " +
+                                            path + " have the same output file: " +
+                                            job.outputPath);
+            }
+
+            // the header is enough to estimate the size of the job
+            std::ifstream file(path);
+            unsigned rows, cols;
+
+            if(!(file >> rows >> cols >> job.fleetSize >> job.nRides)) {
+                job.fleetSize = 0;
+                job.nRides = 0;
+            }
+
+            jobs.push_back(job);
+        }
+    }
+}
+
+void Batch::solve(Job& job, std::shared_ptr<Generator::Workspace> workspace) const {
+    const auto start = std::chrono::steady_clock::now();
+    Options jobOptions = options;
+    jobOptions.inputPath = job.inputPath;
+    jobOptions.outputPath = job.outputPath;
+    // the jobs run in parallel, the checkpoint watchdog would terminate all of them
+    jobOptions.threads = 1;
+    jobOptions.deadline = 0;
+
+    try {
+        std::shared_ptr<InputData> inputData = InputData::genFromFile(job.inputPath);
+        std::ostringstream log;
+        Algorithm algorithm(*inputData, job.outputPath, jobOptions, log);
+        algorithm.setWorkspace(workspace);
+        job.score = algorithm.run();
+    } catch(const std::exception& e) {
+        job.error = e.what();
+    }
+
+    job.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                  start).count();
+}
+
+unsigned Batch::run() {
+    const auto start = std::chrono::steady_clock::now();
+    std::filesystem::create_directories(options.batchDirectory);
+    std::vector<unsigned> order(jobs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](const unsigned a, const unsigned b) {
+        return static_cast<unsigned long>(jobs[a].nRides) * jobs[a].fleetSize >
+               static_cast<unsigned long>(jobs[b].nRides) * jobs[b].fleetSize;
+    });
+
+    unsigned nWorkers = options.threads > 0 ? options.threads :
+                        std::max(1u, std::thread::hardware_concurrency());
+    nWorkers = std::min<unsigned>(nWorkers, jobs.size());
+    std::atomic<unsigned> next(0);
+    std::vector<std::thread> workers;
+
+    for(unsigned w = 0; w < nWorkers; ++w) {
+        workers.emplace_back([&]() {
+            std::shared_ptr<Generator::Workspace> workspace =
+                std::make_shared<Generator::Workspace>();
+
+            for(unsigned i = next++; i < order.size(); i = next++) {
+                solve(jobs[order[i]], workspace);
+            }
+        });
+    }
+
+    for(std::thread& worker : workers) {
+        worker.join();
+    }
+
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return std::count_if(jobs.begin(), jobs.end(), [](const Job& job) {
+        return !job.error.empty();
+    });
+}
+
+void Batch::printSummary(std::ostream& out) const {
+    std::size_t width = 12;
+
+    for(const Job& job : jobs) {
+        width = std::max(width, std::filesystem::path(job.inputPath).filename().string().size() + 2);
+    }
+
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::left << std::setw(width) << "Input" << std::setw(10) << "Rides"
+        << std::setw(8) << "Cars" << std::setw(12) << "Score" << "Time [s]" << std::endl;
+
+    long totalScore = 0;
+    double totalSeconds = 0;
+
+    for(const Job& job : jobs) {
+        out << std::setw(width) << std::filesystem::path(job.inputPath).filename().string()
+            << std::setw(10) << job.nRides << std::setw(8) << job.fleetSize;
+
+        if(job.error.empty()) {
+            out << std::setw(12) << job.score << std::fixed << std::setprecision(2)
+                << job.seconds << std::endl;
+        } else {
+            out << "failed: " << job.error << std::endl;
+        }
+
+        totalScore += job.score;
+        totalSeconds += job.seconds;
+    }
+
+    out << std::setw(width) << "Total" << std::setw(18) << "" << std::setw(12) << totalScore
+        << std::fixed << std::setprecision(2) << totalSeconds << " (wall " << seconds << ")"
+        << std::endl;
+    out.flags(flags);
+    out.precision(precision);
+}
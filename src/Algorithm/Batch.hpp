@@ -0,0 +1,100 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Options.hpp"
+#include "Generator.hpp"
+
+/**
+ * Solves many input files in one process.
+ *
+ * The jobs are scheduled on a pool of Options#threads worker threads, largest input
+ * (number of rides times number of cars) first, so that no worker is left with a large job
+ * at the end. Each worker keeps one Generator::Workspace for all its jobs. The stages of a
+ * job run single-threaded and their progress is not printed; the anytime mode
+ * (Options#deadline) is not available, since it terminates the process.
+ */
+class Batch {
+public:
+
+    /** Input file and result of its job. */
+    struct Job {
+        /** Path of the input file. */
+        std::string inputPath;
+        /** Path of the output file. */
+        std::string outputPath;
+        /** Number of rides of the input. */
+        unsigned nRides = 0;
+        /** Number of cars of the input. */
+        unsigned fleetSize = 0;
+        /** Score of the written solution. */
+        long score = 0;
+        /** Wall-clock time of the job in seconds. */
+        double seconds = 0;
+        /** Error message if the job failed (empty: success). */
+        std::string error;
+    };
+
+    /**
+     * Creates the jobs of all input files.
+     *
+     * \param [in] options options of all jobs, Options#inputPaths may contain wildcard
+     *             patterns (* and ? in the file name)
+     * \throw std::invalid_argument if a path or pattern doesn't match any file or two input
+     *        files have the same output file (same file name without extension)
+     */
+    Batch(const Options& options);
+
+    /**
+     * Expands the wildcards (* and ?) of the file name of a pattern.
+     *
+     * \param [in] pattern path of a file, whose name may contain wildcards
+     * \return std::vector<std::string> sorted paths of all matching files
+     */
+    static std::vector<std::string> expand(const std::string& pattern);
+
+    /**
+     * Solves all jobs.
+     *
+     * \return unsigned number of failed jobs
+     */
+    unsigned run();
+
+    /**
+     * Prints a table with the rides, cars, score and time of each job.
+     *
+     * \param [out] out stream the table is printed to
+     */
+    void printSummary(std::ostream& out) const;
+
+    /**
+     * Jobs in the order of the input files.
+     *
+     * \return const std::vector<Job>& all jobs
+     */
+    const std::vector<Job>& getJobs() const {return jobs;}
+
+private:
+
+    /**
+     * Solves a job.
+     *
+     * \param [in,out] job job to solve
+     * \param [in] workspace matrices of the worker
+     */
+    void solve(Job& job, std::shared_ptr<Generator::Workspace> workspace) const;
+
+    /** Options of all jobs. */
+    Options options;
+
+    /** Jobs in the order of the input files. */
+    std::vector<Job> jobs;
+
+    /** Wall-clock time of Batch::run in seconds. */
+    double seconds = 0;
+};
+
+#endif // BATCH_H
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include "Checkpoint.hpp"
+
+/** Time between two checks of the watchdog. */
+#define WATCHDOG_PERIOD std::chrono::milliseconds(10)
+
+/** Forwards SIGTERM as a stop request to all deadlines. */
+extern "C" void handleTerminate(int) {
+    Deadline::requestStop();
+}
+
+Checkpoint::Checkpoint(const std::string outputPath, const double interval,
+                       const Deadline& deadline):
+    outputPath(outputPath),
+    interval(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>
+             (interval))),
+    deadline(deadline),
+    safetyMargin(std::min(0.5, 0.05 * deadline.getBudget())),
+    bestScore(-1),
+    written(true),
+    lastWrite(Clock::time_point()),
+    finished(false) {
+    std::signal(SIGTERM, handleTerminate);
+    watchdog = std::thread(&Checkpoint::watch, this);
+}
+
+Checkpoint::~Checkpoint() {
+    finished = true;
+    watchdog.join();
+    std::signal(SIGTERM, SIG_DFL);
+}
+
+bool Checkpoint::isDue() const {
+    return Clock::now() - lastWrite.load() >= interval || Deadline::stopRequested();
+}
+
+long Checkpoint::getBestScore() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return bestScore;
+}
+
+void Checkpoint::offer(const Solution& solution, const long score) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if(score > bestScore) {
+        best = solution;
+        bestScore = score;
+        written = false;
+    }
+
+    // offers come from worker threads, a failed write is retried by the next one
+    if(!written && isDue()) {
+        try {
+            write();
+        } catch(const std::fstream::failure& e) {
+            std::cerr << e.what() << std::endl;
+        }
+    }
+}
+
+void Checkpoint::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if(!written) {
+        write();
+    }
+}
+
+void Checkpoint::write() {
+    const std::string tmpPath = outputPath + ".tmp";
+    best.writeToFile(tmpPath);
+
+    // replacing a file by renaming is atomic, readers never see a partial output
+    if(std::rename(tmpPath.c_str(), outputPath.c_str()) != 0) {
+        throw std::fstream::failure("Can't replace " + outputPath);
+    }
+
+    written = true;
+    lastWrite = Clock::now();
+}
+
+void Checkpoint::watch() {
+    while(!finished) {
+        std::this_thread::sleep_for(WATCHDOG_PERIOD);
+
+        if(!deadline.expired(safetyMargin)) {continue;}
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        try {
+            if(!written) {write();}
+        } catch(const std::fstream::failure& e) {
+            std::cerr << e.what() << std::endl;
+            std::_Exit(1);
+        }
+
+        std::cout << (Deadline::stopRequested() ? "Terminated" : "Deadline reached")
+                  << ", best score written: " << bestScore << std::endl;
+        std::_Exit(0);
+    }
+}
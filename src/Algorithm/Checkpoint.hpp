@@ -0,0 +1,121 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Solution.hpp"
+#include "Deadline.hpp"
+
+/**
+ * Keeps the best solution seen so far and writes it to the output file
+ * in regular intervals, so that an interrupted run still produces a valid output.
+ *
+ * Files are written atomically (temporary file + rename). A watchdog thread writes the
+ * best solution and terminates the process when SIGTERM is received or the deadline is
+ * about to pass while the computation is still busy.
+ */
+class Checkpoint {
+public:
+
+    /**
+     * Starts the watchdog and installs the SIGTERM handler.
+     *
+     * \param [in] outputPath path of the output file
+     * \param [in] interval minimal number of seconds between two writes
+     * \param [in] deadline wall-clock budget of the whole run
+     */
+    Checkpoint(const std::string outputPath, const double interval, const Deadline& deadline);
+
+    /** Stops the watchdog and restores the default SIGTERM handler. */
+    ~Checkpoint();
+
+    /**
+     * Checks if a new solution would be written by Checkpoint::offer.
+     *
+     * \return bool true if the interval has passed since the last write
+     */
+    bool isDue() const;
+
+    /**
+     * Keeps a solution if it's better than the best one so far and writes it if due.
+     * A failed write is reported on std::cerr and retried by the next offer.
+     *
+     * \param [in] solution routes of all cars
+     * \param [in] score points of the solution
+     */
+    void offer(const Solution& solution, const long score);
+
+    /**
+     * Writes the best solution if it hasn't been written yet.
+     *
+     * \throw std::fstream::failure if the output file can't be written
+     */
+    void flush();
+
+    /**
+     * Time the computation has to stop before the deadline so that the final solution
+     * can be written.
+     *
+     * \return double seconds
+     */
+    double getSafetyMargin() const {return safetyMargin;};
+
+    /**
+     * Score of the best solution so far.
+     *
+     * \return long points (-1 if no solution has been offered)
+     */
+    long getBestScore();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Atomically writes the best solution (needs a lock of Checkpoint::mutex).
+     */
+    void write();
+
+    /**
+     * Watchdog loop, writes the best solution and exits the process on SIGTERM or if the
+     * deadline is reached.
+     */
+    void watch();
+
+    /** Path of the output file. */
+    const std::string outputPath;
+
+    /** Minimal time between two writes. */
+    const Clock::duration interval;
+
+    /** Wall-clock budget of the whole run. */
+    const Deadline deadline;
+
+    /** Seconds before the deadline at which the watchdog terminates the process. */
+    const double safetyMargin;
+
+    /** Guards the best solution. */
+    std::mutex mutex;
+
+    /** Best solution so far. */
+    Solution best;
+
+    /** Score of Checkpoint::best. */
+    long bestScore;
+
+    /** True if Checkpoint::best has been written. */
+    bool written;
+
+    /** Point in time of the last write. */
+    std::atomic<Clock::time_point> lastWrite;
+
+    /** Set to stop the watchdog. */
+    std::atomic<bool> finished;
+
+    /** Thread running Checkpoint::watch. */
+    std::thread watchdog;
+};
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,87 @@
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+/**
+ * Wall-clock budget of a computation.
+ * Additionally, a stop can be requested at any time (e.g. by a signal handler),
+ * which expires all deadlines.
+ */
+class Deadline {
+public:
+
+    /**
+     * Starts a new budget.
+     *
+     * \param [in] seconds budget in seconds (0: no deadline)
+     */
+    Deadline(const double seconds = 0):
+        budget(seconds), end(Clock::now() + std::chrono::duration_cast<Clock::duration>
+                             (std::chrono::duration<double>(seconds))) {};
+
+    /**
+     * Checks if a budget has been set.
+     *
+     * \return bool true if this deadline can expire without a stop request
+     */
+    bool isSet() const {return budget > 0;};
+
+    /**
+     * Total budget.
+     *
+     * \return double budget in seconds (0: no deadline)
+     */
+    double getBudget() const {return budget;};
+
+    /**
+     * Remaining time of the budget.
+     *
+     * \return double remaining seconds (infinity if no budget has been set)
+     */
+    double remaining() const {
+        if(!isSet()) {return std::numeric_limits<double>::infinity();}
+
+        return std::chrono::duration<double>(end - Clock::now()).count();
+    };
+
+    /**
+     * Checks if the deadline has (almost) passed or a stop has been requested.
+     *
+     * \param [in] reserve seconds that have to remain for the deadline not to be expired
+     * \return bool true if the computation should stop
+     */
+    bool expired(const double reserve = 0) const {
+        return stopRequested() || remaining() <= reserve;
+    };
+
+    /**
+     * Requests all computations to stop.
+     *
+     * \note This is async-signal-safe.
+     */
+    static void requestStop() {stopFlag.store(true);};
+
+    /**
+     * Checks if a stop has been requested.
+     *
+     * \return bool true if Deadline::requestStop has been called
+     */
+    static bool stopRequested() {return stopFlag.load();};
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /** Budget in seconds. */
+    double budget;
+
+    /** Point in time the budget ends. */
+    Clock::time_point end;
+
+    /** Set by Deadline::requestStop. */
+    static inline std::atomic<bool> stopFlag{false};
+};
+
+#endif // DEADLINE_H
@@ -0,0 +1,289 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include "Decomposition.hpp"
+#include "Generator.hpp"
+#include "SearchGraphNode.hpp"
+
+Decomposition::Decomposition(const InputData& inputData, const std::string& scoring,
+                             const unsigned gridSize, const unsigned timeSlices,
+                             const int horizon, const unsigned nThreads):
+    inputData(inputData), scoring(scoring), gridSize(std::max(1u, gridSize)),
+    timeSlices(std::max(1u, timeSlices)), horizon(horizon), nThreads(nThreads) {
+    if(this->nThreads == 0) {
+        this->nThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::vector<int> startX(inputData.nRides);
+    std::vector<int> startY(inputData.nRides);
+
+    for(unsigned ride = 0; ride < inputData.nRides; ++ride) {
+        startX[ride] = inputData.startX(ride);
+        startY[ride] = inputData.startY(ride);
+    }
+
+    rowBorders = quantiles(std::move(startX), inputData.rows);
+    colBorders = quantiles(std::move(startY), inputData.cols);
+}
+
+std::vector<int> Decomposition::quantiles(std::vector<int> coordinates, const int size) const {
+    std::vector<int> borders(gridSize + 1, 0);
+    std::sort(coordinates.begin(), coordinates.end());
+    borders[gridSize] = size;
+
+    for(unsigned i = 1; i < gridSize && !coordinates.empty(); ++i) {
+        borders[i] = coordinates[coordinates.size() * i / gridSize];
+    }
+
+    return borders;
+}
+
+unsigned Decomposition::regionOf(const int x, const int y) const {
+    // index of the last border not greater than the coordinate
+    const unsigned row = std::upper_bound(rowBorders.begin() + 1, rowBorders.end() - 1, x) -
+                         rowBorders.begin() - 1;
+    const unsigned col = std::upper_bound(colBorders.begin() + 1, colBorders.end() - 1, y) -
+                         colBorders.begin() - 1;
+    return row * gridSize + col;
+}
+
+std::vector<std::vector<unsigned>> Decomposition::distributeCars(const Types::CarData& cars,
+                                const std::vector<std::vector<unsigned>>& rides) const {
+    const unsigned nRegions = rides.size();
+    std::vector<std::vector<unsigned>> result(nRegions);
+    std::vector<long> work(nRegions, 0);
+    long totalWork = 0;
+
+    // every ride counts at least one step, so regions of zero length rides get cars too
+    for(unsigned region = 0; region < nRegions; ++region) {
+        for(const unsigned ride : rides[region]) {
+            work[region] += inputData.distances(ride) + 1;
+        }
+
+        totalWork += work[region];
+    }
+
+    if(totalWork == 0) {return result;}
+
+    // largest remainder method
+    std::vector<unsigned> quota(nRegions);
+    std::vector<double> remainders(nRegions);
+    unsigned distributed = 0;
+
+    for(unsigned region = 0; region < nRegions; ++region) {
+        const double exact = static_cast<double>(work[region]) * inputData.fleetSize / totalWork;
+        quota[region] = std::floor(exact);
+        remainders[region] = exact - quota[region];
+        distributed += quota[region];
+    }
+
+    std::vector<unsigned> order(nRegions);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](const unsigned a, const unsigned b) {
+        return remainders[a] > remainders[b];
+    });
+
+    for(unsigned i = 0; distributed < inputData.fleetSize; ++i, ++distributed) {
+        ++quota[order[i % nRegions]];
+    }
+
+    // cars stay in their region as long as it needs cars
+    std::vector<unsigned> others;
+
+    for(unsigned car = 0; car < inputData.fleetSize; ++car) {
+        const unsigned region = regionOf(cars.x(car), cars.y(car));
+
+        if(quota[region] > 0) {
+            result[region].push_back(car);
+            --quota[region];
+        } else {
+            others.push_back(car);
+        }
+    }
+
+    // the remaining cars move to the nearest region that needs cars
+    for(const unsigned car : others) {
+        unsigned nearest = 0;
+        int nearestDistance = std::numeric_limits<int>::max();
+
+        for(unsigned region = 0; region < nRegions; ++region) {
+            if(quota[region] == 0) {continue;}
+
+            const unsigned row = region / gridSize;
+            const unsigned col = region % gridSize;
+            const int centerX = (rowBorders[row] + rowBorders[row + 1]) / 2;
+            const int centerY = (colBorders[col] + colBorders[col + 1]) / 2;
+            const int distance = std::abs(cars.x(car) - centerX) + std::abs(cars.y(car) - centerY);
+
+            if(distance < nearestDistance) {
+                nearest = region;
+                nearestDistance = distance;
+            }
+        }
+
+        result[nearest].push_back(car);
+        --quota[nearest];
+    }
+
+    return result;
+}
+
+void Decomposition::solveRegion(const std::vector<unsigned>& rides,
+                                const std::vector<unsigned>& regionCars, Types::CarData& cars,
+                                Solution& solution, std::vector<unsigned>& leftover,
+                                const Deadline& deadline, const double reserve) const {
+    std::shared_ptr<InputData> regionData = InputData::genFromRides(inputData, rides,
+                                            regionCars.size());
+    std::unique_ptr<Generator> generator = Generator::create(*regionData, scoring);
+    generator->setHorizon(horizon);
+
+    // cars continue from their state at the end of the previous time slice
+    Types::CarData regionState(regionCars.size());
+
+    for(unsigned i = 0; i < regionCars.size(); ++i) {
+        regionState.x(i) = cars.x(regionCars[i]);
+        regionState.y(i) = cars.y(regionCars[i]);
+        regionState.t(i) = cars.t(regionCars[i]);
+        regionState.p(i) = cars.p(regionCars[i]);
+    }
+
+    std::vector<int> unassigned(rides.size());
+    std::iota(unassigned.begin(), unassigned.end(), 0);
+    std::shared_ptr<SearchGraphNode> node;
+
+    do {
+        node = generator->generate(unassigned, regionState, node);
+    } while(!unassigned.empty() && !generator->getActiveCars().empty() &&
+            !deadline.expired(reserve));
+
+    const Solution regionSolution = node ? node->toSolution(regionCars.size()) :
+                                    Solution(regionCars.size());
+
+    // regions have distinct cars, no synchronization needed
+    for(unsigned i = 0; i < regionCars.size(); ++i) {
+        for(const unsigned ride : regionSolution.routes[i]) {
+            solution.routes[regionCars[i]].push_back(rides[ride]);
+        }
+
+        cars.x(regionCars[i]) = regionState.x(i);
+        cars.y(regionCars[i]) = regionState.y(i);
+        cars.t(regionCars[i]) = regionState.t(i);
+        cars.p(regionCars[i]) = regionState.p(i);
+    }
+
+    for(const int ride : unassigned) {
+        leftover.push_back(rides[ride]);
+    }
+}
+
+unsigned Decomposition::exchange(RoutePlan& plan) const {
+    // the list of unassigned rides changes while inserting
+    const std::vector<unsigned> rides = plan.getUnassigned();
+    unsigned inserted = 0;
+
+    for(const unsigned ride : rides) {
+        int bestDelta = 0;
+        unsigned bestCar = 0;
+        unsigned bestPos = 0;
+
+        for(unsigned car = 0; car < plan.getRouteCount(); ++car) {
+            const unsigned pos = plan.slotOf(car, inputData.startT(ride));
+            const int delta = plan.insertDelta(car, pos, ride);
+
+            if(delta > bestDelta) {
+                bestDelta = delta;
+                bestCar = car;
+                bestPos = pos;
+            }
+        }
+
+        if(bestDelta > 0) {
+            plan.insert(bestCar, bestPos, ride);
+            ++inserted;
+        }
+    }
+
+    return inserted;
+}
+
+RoutePlan Decomposition::run(const Deadline& deadline, const double reserve) {
+    const unsigned nRegions = gridSize * gridSize;
+    Types::CarData cars(inputData.fleetSize);
+    Solution solution(inputData.fleetSize);
+    std::vector<unsigned> order(inputData.nRides);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](const unsigned a, const unsigned b) {
+        return inputData.startT(a) < inputData.startT(b);
+    });
+
+    // rides left over by previous time slices
+    std::vector<unsigned> pending;
+    auto next = order.begin();
+    subproblems = 0;
+
+    for(unsigned slice = 0; slice < timeSlices && !deadline.expired(reserve); ++slice) {
+        const long sliceEnd = static_cast<long>(inputData.maxTime) * (slice + 1) / timeSlices;
+        std::vector<std::vector<unsigned>> rides(nRegions);
+
+        for(const unsigned ride : pending) {
+            rides[regionOf(inputData.startX(ride), inputData.startY(ride))].push_back(ride);
+        }
+
+        for(; next != order.end() && (slice + 1 == timeSlices || inputData.startT(*next) < sliceEnd);
+            ++next) {
+            rides[regionOf(inputData.startX(*next), inputData.startY(*next))].push_back(*next);
+        }
+
+        const std::vector<std::vector<unsigned>> regionCars = distributeCars(cars, rides);
+        std::vector<unsigned> regions;
+        pending.clear();
+
+        for(unsigned region = 0; region < nRegions; ++region) {
+            if(rides[region].empty()) {continue;}
+
+            if(regionCars[region].empty()) {
+                pending.insert(pending.end(), rides[region].begin(), rides[region].end());
+            } else {
+                regions.push_back(region);
+            }
+        }
+
+        // largest regions first, so no thread is left with a large region at the end
+        std::sort(regions.begin(), regions.end(), [&](const unsigned a, const unsigned b) {
+            return rides[a].size() > rides[b].size();
+        });
+
+        std::vector<std::vector<unsigned>> leftovers(nRegions);
+        std::atomic<unsigned> nextRegion(0);
+        std::vector<std::thread> threads;
+
+        for(unsigned t = 0; t < std::min<unsigned>(nThreads, regions.size()); ++t) {
+            threads.emplace_back([&]() {
+                for(unsigned i = nextRegion++; i < regions.size(); i = nextRegion++) {
+                    solveRegion(rides[regions[i]], regionCars[regions[i]], cars, solution,
+                                leftovers[regions[i]], deadline, reserve);
+                }
+            });
+        }
+
+        for(std::thread& thread : threads) {
+            thread.join();
+        }
+
+        subproblems += regions.size();
+
+        for(const std::vector<unsigned>& leftover : leftovers) {
+            pending.insert(pending.end(), leftover.begin(), leftover.end());
+        }
+    }
+
+    RoutePlan plan(inputData, solution);
+    regionScore = plan.getScore();
+    exchanged = exchange(plan);
+    return plan;
+}
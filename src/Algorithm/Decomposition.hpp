@@ -0,0 +1,161 @@
+#ifndef DECOMPOSITION_H
+#define DECOMPOSITION_H
+
+#include <string>
+#include <vector>
+#include "Types.hpp"
+#include "InputData.hpp"
+#include "Solution.hpp"
+#include "RoutePlan.hpp"
+#include "Deadline.hpp"
+
+/**
+ * Splits the problem into independent subproblems that are solved in parallel.
+ *
+ * The grid is divided into gridSize x gridSize regions and the simulation time into
+ * time slices. The borders of the regions are quantiles of the ride starts, so regions get
+ * about the same number of rides even if the rides are concentrated in a city center.
+ * Rides belong to the region of their start and the slice of their earliest start. Slices are solved one after another: at the beginning of each slice the cars are
+ * distributed among the regions in proportion to the ride distance of the regions, preferring
+ * cars that are already inside a region. Every region gets its own InputData and Generator,
+ * the regions are solved by a pool of threads. Cars keep their state between slices and
+ * rides left over by a slice stay available for the next one.
+ *
+ * Finally, a border exchange inserts the rides no region could assign (e.g. rides of regions
+ * that ran out of cars) into the best position of any route.
+ */
+class Decomposition {
+public:
+
+    /**
+     * Creates a decomposition.
+     *
+     * \param [in] inputData InputData representing the simulation enviroment
+     * \param [in] scoring name of the scoring heuristic of the region generators
+     * \param [in] gridSize number of regions per grid dimension
+     * \param [in] timeSlices number of time slices
+     * \param [in] horizon time horizon of the region generators (see Generator::setHorizon)
+     * \param [in] nThreads number of threads solving regions (0: one per core)
+     */
+    Decomposition(const InputData& inputData, const std::string& scoring,
+                  const unsigned gridSize, const unsigned timeSlices = 1, const int horizon = -1,
+                  const unsigned nThreads = 0);
+
+    /**
+     * Solves all subproblems and applies the border exchange.
+     *
+     * \param [in] deadline regions stop assigning rides when the deadline expired
+     * \param [in] reserve seconds before the deadline at which the regions stop
+     * \return RoutePlan routes of all cars
+     */
+    RoutePlan run(const Deadline& deadline = Deadline(), const double reserve = 0);
+
+    /**
+     * Sum of the points of all regions before the border exchange.
+     *
+     * \return long points
+     */
+    long getRegionScore() const {return regionScore;}
+
+    /**
+     * Number of rides assigned by the border exchange.
+     *
+     * \return unsigned number of rides
+     */
+    unsigned getExchanged() const {return exchanged;}
+
+    /**
+     * Number of solved subproblems (regions containing rides in each time slice).
+     *
+     * \return unsigned number of subproblems
+     */
+    unsigned getSubproblemCount() const {return subproblems;}
+
+private:
+
+    /**
+     * Region containing an intersection.
+     *
+     * \param [in] x row coordinate
+     * \param [in] y column coordinate
+     * \return unsigned index of the region
+     */
+    unsigned regionOf(const int x, const int y) const;
+
+    /**
+     * Borders of the regions in one grid dimension at quantiles of the given coordinates.
+     *
+     * \param [in] coordinates coordinate of each ride start
+     * \param [in] size size of the grid dimension
+     * \return std::vector<int> gridSize + 1 borders, region i covers [border i, border i + 1)
+     */
+    std::vector<int> quantiles(std::vector<int> coordinates, const int size) const;
+
+    /**
+     * Distributes the cars among the regions in proportion to the ride distance of the regions.
+     *
+     * \param [in] cars current state of all cars
+     * \param [in] rides indices of the rides of each region
+     * \return std::vector<std::vector<unsigned>> indices of the cars of each region
+     */
+    std::vector<std::vector<unsigned>> distributeCars(const Types::CarData& cars,
+                                    const std::vector<std::vector<unsigned>>& rides) const;
+
+    /**
+     * Assigns the rides of a region to its cars using a Generator.
+     *
+     * \param [in] rides indices of the rides of the region
+     * \param [in] regionCars indices of the cars of the region
+     * \param [in,out] cars state of all cars (only cars of the region are changed)
+     * \param [in,out] solution the rides are appended to the routes of the region's cars
+     * \param [out] leftover indices of rides that haven't been assigned
+     * \param [in] deadline stop assigning when the deadline expired
+     * \param [in] reserve seconds before the deadline at which the region stops
+     */
+    void solveRegion(const std::vector<unsigned>& rides, const std::vector<unsigned>& regionCars,
+                     Types::CarData& cars, Solution& solution, std::vector<unsigned>& leftover,
+                     const Deadline& deadline, const double reserve) const;
+
+    /**
+     * Inserts unassigned rides into the route and position gaining the most points.
+     *
+     * \param [in,out] plan routes of all cars
+     * \return unsigned number of inserted rides
+     */
+    unsigned exchange(RoutePlan& plan) const;
+
+    /** InputData representing the simulation enviroment. */
+    const InputData& inputData;
+
+    /** Name of the scoring heuristic of the region generators. */
+    const std::string scoring;
+
+    /** Number of regions per grid dimension. */
+    const unsigned gridSize;
+
+    /** Number of time slices. */
+    const unsigned timeSlices;
+
+    /** Time horizon of the region generators. */
+    const int horizon;
+
+    /** Number of threads solving regions. */
+    unsigned nThreads;
+
+    /** Row borders of the regions. */
+    std::vector<int> rowBorders;
+
+    /** Column borders of the regions. */
+    std::vector<int> colBorders;
+
+    /** Sum of the points of all regions before the border exchange. */
+    long regionScore = 0;
+
+    /** Number of rides assigned by the border exchange. */
+    unsigned exchanged = 0;
+
+    /** Number of solved subproblems. */
+    unsigned subproblems = 0;
+};
+
+#endif // DECOMPOSITION_H
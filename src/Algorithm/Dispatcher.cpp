@@ -0,0 +1,33 @@
+#include "Dispatcher.hpp"
+
+void Dispatcher::reset(Types::CarData& cars) {
+    events = decltype(events)();
+
+    for(unsigned car = 0; car < cars.t.getSize(); ++car) {
+        events.push({cars.t(car), car});
+    }
+}
+
+std::shared_ptr<SearchGraphNode> Dispatcher::generate(std::vector<int>& unassigned,
+        Types::CarData& cars, std::shared_ptr<SearchGraphNode>& prevNode) {
+    if(events.empty()) {return prevNode;}
+
+    std::vector<unsigned> batch;
+    const int batchEnd = events.top().first + window;
+
+    while(!events.empty() && events.top().first <= batchEnd && batch.size() < maxBatchSize) {
+        batch.push_back(events.top().second);
+        events.pop();
+    }
+
+    batchSize = batch.size();
+    std::shared_ptr<SearchGraphNode> node = generator.generate(unassigned, cars, prevNode,
+                                            batch);
+
+    // retired cars have been removed from the batch, the others are free again later
+    for(const unsigned car : batch) {
+        events.push({cars.t(car), car});
+    }
+
+    return node;
+}
@@ -0,0 +1,91 @@
+#ifndef DISPATCHER_H
+#define DISPATCHER_H
+
+#include <functional>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "Types.hpp"
+#include "InputData.hpp"
+#include "Generator.hpp"
+#include "SearchGraphNode.hpp"
+
+/**
+ * Event-driven alternative to the lockstep rounds of Generator::generate.
+ *
+ * Cars are kept in a min-heap ordered by the point in time at which they are free.
+ * Each call takes the earliest car and all cars that become free within a time window
+ * after it (at most Dispatcher#maxBatchSize) and solves a small RLAP only for this batch.
+ */
+class Dispatcher {
+public:
+
+    /**
+     * Creates a dispatcher.
+     *
+     * \param [in] generator Generator solving the RLAP of each batch
+     * \param [in] window cars free at most this many steps after the earliest car join its batch
+     * \param [in] maxBatchSize maximum number of cars of a batch
+     */
+    Dispatcher(Generator& generator, const int window, const unsigned maxBatchSize = 32):
+        generator(generator), window(window), maxBatchSize(maxBatchSize) {};
+
+    /**
+     * Starts a new search path, all cars are active.
+     *
+     * \param [in] cars represents the current state of all cars
+     */
+    void reset(Types::CarData& cars);
+
+    /**
+     * Assigns rides to the next batch of cars.
+     *
+     * \note This method should be called repeatedly using its result until
+     *       no active car is left, starting with Dispatcher::reset.
+     *
+     * \param [in,out] unassigned a list of indices of all unassigned rides
+     * \param [in,out] cars represents the current state of all cars
+     * \param [in] prevNode is referenced by the new SearchGraphNode
+     * \return std::shared_ptr<SearchGraphNode> rides assigned to the batch
+     */
+    std::shared_ptr<SearchGraphNode> generate(std::vector<int>& unassigned,
+            Types::CarData& cars, std::shared_ptr<SearchGraphNode>& prevNode);
+
+    /**
+     * Number of cars that can still finish an unassigned ride in time.
+     * The search path is complete if there are none.
+     *
+     * \return unsigned number of active cars
+     */
+    unsigned getActiveCount() const {return events.size();}
+
+    /**
+     * Number of cars in the last batch.
+     *
+     * \return unsigned batch size
+     */
+    unsigned getBatchSize() const {return batchSize;}
+
+private:
+
+    /** Point in time at which a car is free and index of the car. */
+    typedef std::pair<int, unsigned> Event;
+
+    /** Solves the RLAP of each batch. */
+    Generator& generator;
+
+    /** Cars free at most this many steps after the earliest car join its batch. */
+    const int window;
+
+    /** Maximum number of cars of a batch (keeps the RLAP small when many cars are free). */
+    const unsigned maxBatchSize;
+
+    /** Active cars ordered by the point in time at which they are free. */
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+
+    /** Number of cars in the last batch. */
+    unsigned batchSize = 0;
+};
+
+#endif // DISPATCHER_H
@@ -0,0 +1,40 @@
+#include <algorithm>
+#include <numeric>
+#include "ExpiryIndex.hpp"
+
+ExpiryIndex::ExpiryIndex(const InputData& inputData):
+    latestStarts(inputData.nRides), order(inputData.nRides), next(0),
+    expired(inputData.nRides, false) {
+    for(unsigned ride = 0; ride < inputData.nRides; ++ride) {
+        latestStarts[ride] = inputData.endT(ride) - inputData.distances(ride);
+    }
+
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](const int a, const int b) {
+        return latestStarts[a] < latestStarts[b];
+    });
+}
+
+unsigned ExpiryIndex::retire(std::vector<int>& unassigned, const int time) {
+    const unsigned first = next;
+
+    while(next < order.size() && latestStarts[order[next]] < time) {
+        expired[order[next++]] = true;
+    }
+
+    if(first == next) {return 0;}
+
+    const unsigned size = unassigned.size();
+    unassigned.erase(std::remove_if(unassigned.begin(), unassigned.end(),
+    [this](const int ride) {return expired[ride];}), unassigned.end());
+
+    for(unsigned i = first; i < next; ++i) {
+        expired[order[i]] = false;
+    }
+
+    return size - unassigned.size();
+}
+
+void ExpiryIndex::reset() {
+    next = 0;
+}
@@ -0,0 +1,52 @@
+#ifndef EXPIRY_INDEX_H
+#define EXPIRY_INDEX_H
+
+#include <vector>
+#include "InputData.hpp"
+
+/**
+ * Index of all rides ordered by their latest feasible start (endT - distance).
+ *
+ * A ride that can't be started before its latest feasible start by any car can't earn
+ * points anymore (neither distance nor bonus). Since the points in time of the cars never
+ * decrease, such rides can be retired permanently: a cursor walks through the index
+ * as the earliest car time advances, each ride is visited only once per search path.
+ */
+class ExpiryIndex {
+public:
+
+    /**
+     * Creates the index of all rides.
+     *
+     * \param [in] inputData InputData containing the rides
+     */
+    ExpiryIndex(const InputData& inputData);
+
+    /**
+     * Removes all rides from unassigned that can't be started in time anymore.
+     *
+     * \param [in,out] unassigned sorted indices of all unassigned rides
+     * \param [in] time earliest point in time at which any car can start a ride
+     * \return unsigned number of removed rides
+     */
+    unsigned retire(std::vector<int>& unassigned, const int time);
+
+    /** Starts a new search path, all rides are considered unexpired again. */
+    void reset();
+
+private:
+
+    /** Latest feasible start of all rides. */
+    std::vector<int> latestStarts;
+
+    /** Indices of all rides ordered by their latest feasible start. */
+    std::vector<int> order;
+
+    /** Position in ExpiryIndex#order of the first ride that hasn't expired yet. */
+    unsigned next;
+
+    /** Marks the rides removed by the current call of ExpiryIndex#retire. */
+    std::vector<bool> expired;
+};
+
+#endif // EXPIRY_INDEX_H
@@ -0,0 +1,335 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include "FlowPlanner.hpp"
+
+/** Node of the source. */
+static constexpr unsigned SOURCE = 0;
+
+/** Node of the sink. */
+static constexpr unsigned SINK = 1;
+
+/** Distance of nodes that haven't been reached. */
+static constexpr long UNREACHED = std::numeric_limits<long>::max();
+
+FlowPlanner::FlowPlanner(const InputData& inputData, const unsigned chainLength):
+    inputData(inputData), chainLength(std::max(1u, chainLength)) {}
+
+FlowPlanner::Move FlowPlanner::evaluate(const int x, const int y, const int t,
+                                        const unsigned ride) const {
+    const int arrival = t + std::abs(x - inputData.startX(ride)) +
+                        std::abs(y - inputData.startY(ride));
+    const int start = std::max(arrival, inputData.startT(ride));
+    Move move;
+    move.finish = start + inputData.distances(ride);
+    move.feasible = move.finish <= inputData.endT(ride);
+    move.points = inputData.distances(ride) +
+                  (start == inputData.startT(ride) ? inputData.bonus : 0);
+    move.cost = (start - t) - POINT_WEIGHT * move.points;
+    return move;
+}
+
+void FlowPlanner::addEdge(const unsigned from, const unsigned to, const long cost) {
+    // forward edges have even, reverse edges odd indices
+    adjacency[from].push_back(edges.size());
+    edges.push_back({to, static_cast<unsigned>(edges.size() + 1), 1, cost});
+    adjacency[to].push_back(edges.size());
+    edges.push_back({from, static_cast<unsigned>(edges.size() - 1), 0, -cost});
+}
+
+void FlowPlanner::buildNetwork(const Types::CarData& cars, const std::vector<unsigned>& active,
+                               const std::vector<unsigned>& candidates) {
+    nCars = active.size();
+    const unsigned firstRide = 2 + nCars;
+    // in and out node of each candidate in each layer (chain position)
+    const unsigned layerSize = 2 * candidates.size();
+    edges.clear();
+    adjacency.resize(firstRide + chainLength * layerSize);
+
+    for(std::vector<unsigned>& outgoing : adjacency) {
+        outgoing.clear();
+    }
+
+    // cheapest feasible moves, (cost, candidate position)
+    std::vector<std::pair<long, unsigned>> moves;
+    auto keepCheapest = [&](const unsigned count) {
+        if(moves.size() > count) {
+            std::nth_element(moves.begin(), moves.begin() + count, moves.end());
+            moves.resize(count);
+        }
+    };
+
+    for(unsigned row = 0; row < nCars; ++row) {
+        const unsigned car = active[row];
+        addEdge(SOURCE, 2 + row, 0);
+        moves.clear();
+
+        for(unsigned pos = 0; pos < candidates.size(); ++pos) {
+            const Move move = evaluate(cars.x(car), cars.y(car), cars.t(car), candidates[pos]);
+
+            if(move.feasible) {moves.push_back({move.cost, pos});}
+        }
+
+        keepCheapest(CAR_EDGES_PER_SLOT * chainLength);
+
+        for(const auto& move : moves) {
+            addEdge(2 + row, firstRide + 2 * move.second, move.first);
+        }
+    }
+
+    for(unsigned pos = 0; pos < candidates.size(); ++pos) {
+        const unsigned ride = candidates[pos];
+
+        for(unsigned layer = 0; layer < chainLength; ++layer) {
+            const unsigned in = firstRide + layer * layerSize + 2 * pos;
+            addEdge(in, in + 1, 0);
+            addEdge(in + 1, SINK, 0);
+        }
+
+        if(chainLength == 1) {continue;}
+
+        // transitions assume the ride started on time and only lead to later candidates in
+        // the next layer, which keeps the network acyclic and the chains at k rides
+        const int finish = inputData.startT(ride) + inputData.distances(ride);
+        const unsigned last = std::min(static_cast<unsigned>(candidates.size()),
+                                       pos + 1 + TRANSITION_SCAN);
+        moves.clear();
+
+        for(unsigned next = pos + 1; next < last; ++next) {
+            const Move move = evaluate(inputData.endX(ride), inputData.endY(ride), finish,
+                                       candidates[next]);
+
+            if(move.feasible) {moves.push_back({move.cost, next});}
+        }
+
+        keepCheapest(TRANSITIONS);
+
+        for(unsigned layer = 0; layer + 1 < chainLength; ++layer) {
+            const unsigned out = firstRide + layer * layerSize + 2 * pos + 1;
+
+            for(const auto& move : moves) {
+                addEdge(out, firstRide + (layer + 1) * layerSize + 2 * move.second, move.first);
+            }
+        }
+    }
+}
+
+unsigned FlowPlanner::solveFlow(const bool anyCost) {
+    const unsigned nNodes = adjacency.size();
+    std::vector<long> distance(nNodes, UNREACHED);
+    std::vector<unsigned> parent(nNodes);
+
+    // initial potentials: shortest distances in topological order
+    // (source, cars, ride nodes by layer and candidate order, sink)
+    distance[SOURCE] = 0;
+
+    for(unsigned i = 0; i < nNodes; ++i) {
+        const unsigned node = i == 0 ? SOURCE : i == nNodes - 1 ? SINK : i + 1;
+
+        if(distance[node] == UNREACHED) {continue;}
+
+        for(const unsigned index : adjacency[node]) {
+            const Edge& edge = edges[index];
+
+            if(edge.capacity > 0) {
+                distance[edge.to] = std::min(distance[edge.to], distance[node] + edge.cost);
+            }
+        }
+    }
+
+    // nodes that can't be reached now never can
+    potential.resize(nNodes);
+
+    for(unsigned node = 0; node < nNodes; ++node) {
+        potential[node] = distance[node] == UNREACHED ? 0 : distance[node];
+    }
+
+    using Entry = std::pair<long, unsigned>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    unsigned flow = 0;
+
+    while(true) {
+        // Dijkstra on reduced costs, stops when the sink is reached
+        std::fill(distance.begin(), distance.end(), UNREACHED);
+        distance[SOURCE] = 0;
+        queue = decltype(queue)();
+        queue.push({0, SOURCE});
+
+        while(!queue.empty()) {
+            const Entry entry = queue.top();
+            queue.pop();
+
+            if(entry.first > distance[entry.second]) {continue;}
+
+            if(entry.second == SINK) {break;}
+
+            for(const unsigned index : adjacency[entry.second]) {
+                const Edge& edge = edges[index];
+
+                if(edge.capacity <= 0) {continue;}
+
+                const long reduced = entry.first + edge.cost + potential[entry.second] -
+                                     potential[edge.to];
+
+                if(reduced < distance[edge.to]) {
+                    distance[edge.to] = reduced;
+                    parent[edge.to] = index;
+                    queue.push({reduced, edge.to});
+                }
+            }
+        }
+
+        // stop when sending more flow doesn't lower the cost anymore
+        if(distance[SINK] == UNREACHED ||
+           (!anyCost && distance[SINK] + potential[SINK] - potential[SOURCE] >= 0)) {
+            break;
+        }
+
+        for(unsigned node = 0; node < nNodes; ++node) {
+            potential[node] += std::min(distance[node], distance[SINK]);
+        }
+
+        for(unsigned node = SINK; node != SOURCE;) {
+            Edge& edge = edges[parent[node]];
+            edge.capacity -= 1;
+            edges[edge.reverse].capacity += 1;
+            node = edges[edge.reverse].to;
+        }
+
+        ++flow;
+    }
+
+    return flow;
+}
+
+std::vector<unsigned> FlowPlanner::chainOf(const unsigned row,
+        const std::vector<unsigned>& candidates) const {
+    const unsigned firstRide = 2 + nCars;
+    std::vector<unsigned> chain;
+    unsigned node = 2 + row;
+
+    while(node != SINK) {
+        unsigned next = SINK;
+        bool found = false;
+
+        // forward edge carrying flow
+        for(const unsigned index : adjacency[node]) {
+            if(index % 2 == 0 && edges[index].capacity == 0) {
+                next = edges[index].to;
+                found = true;
+                break;
+            }
+        }
+
+        if(!found) {break;}
+
+        // ride nodes: in node followed by out node, one layer after another
+        if(next != SINK && (next - firstRide) % 2 == 0) {
+            chain.push_back(candidates[(next - firstRide) / 2 % candidates.size()]);
+        }
+
+        node = next;
+    }
+
+    return chain;
+}
+
+RoutePlan FlowPlanner::run(const Deadline& deadline, const double reserve) {
+    solves = 0;
+    assigned = 0;
+    Solution solution(inputData.fleetSize);
+    Types::CarData cars(inputData.fleetSize);
+    std::vector<bool> isAssigned(inputData.nRides, false);
+
+    // unassigned rides ordered by earliest start
+    std::vector<unsigned> unassigned(inputData.nRides);
+    std::iota(unassigned.begin(), unassigned.end(), 0);
+    std::sort(unassigned.begin(), unassigned.end(), [&](const unsigned a, const unsigned b) {
+        return inputData.startT(a) < inputData.startT(b) ||
+               (inputData.startT(a) == inputData.startT(b) && a < b);
+    });
+
+    std::vector<unsigned> active;
+    std::vector<unsigned> candidates;
+
+    while(!deadline.expired(reserve)) {
+        active.clear();
+        int earliest = inputData.maxTime;
+
+        for(unsigned car = 0; car < inputData.fleetSize; ++car) {
+            if(cars.t(car) < static_cast<int>(inputData.maxTime)) {
+                active.push_back(car);
+                earliest = std::min(earliest, cars.t(car));
+            }
+        }
+
+        // cars never get earlier, rides the earliest car can't finish are lost
+        unassigned.erase(std::remove_if(unassigned.begin(), unassigned.end(),
+        [&](const unsigned ride) {
+            return isAssigned[ride] ||
+                   earliest + inputData.distances(ride) > inputData.endT(ride);
+        }), unassigned.end());
+
+        if(active.empty() || unassigned.empty()) {break;}
+
+        // the earliest rides are candidates, more if no car wants any of them
+        unsigned stepAssigned = 0;
+        std::size_t window = CANDIDATES_PER_SLOT * chainLength * active.size();
+        bool anyCost = false;
+
+        while(stepAssigned == 0) {
+            window = std::min(window, unassigned.size());
+            candidates.assign(unassigned.begin(), unassigned.begin() + window);
+            buildNetwork(cars, active, candidates);
+            ++solves;
+
+            if(solveFlow(anyCost) > 0) {
+                for(unsigned row = 0; row < active.size(); ++row) {
+                    const unsigned car = active[row];
+                    const std::vector<unsigned> chain = chainOf(row, candidates);
+                    unsigned length = 0;
+
+                    // the chain is simulated exactly, late rides and rides another car
+                    // took in a different layer are skipped
+                    for(const unsigned ride : chain) {
+                        if(isAssigned[ride]) {continue;}
+
+                        const Move move = evaluate(cars.x(car), cars.y(car), cars.t(car), ride);
+
+                        if(!move.feasible) {continue;}
+
+                        solution.routes[car].push_back(ride);
+                        cars.x(car) = inputData.endX(ride);
+                        cars.y(car) = inputData.endY(ride);
+                        cars.t(car) = move.finish;
+                        cars.p(car) += move.points;
+                        isAssigned[ride] = true;
+                        ++length;
+                    }
+
+                    stepAssigned += length;
+                }
+            }
+
+            if(stepAssigned == 0 && !anyCost) {
+                // no chain is worth its time within k rides, the cars take the cheapest ones
+                anyCost = true;
+                continue;
+            }
+
+            if(stepAssigned == 0 && window == unassigned.size()) {break;}
+
+            window *= 2;
+        }
+
+        if(stepAssigned == 0) {break;}
+
+        assigned += stepAssigned;
+    }
+
+    return RoutePlan(inputData, solution);
+}
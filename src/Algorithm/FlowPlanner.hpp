@@ -0,0 +1,181 @@
+#ifndef FLOW_PLANNER_H
+#define FLOW_PLANNER_H
+
+#include <vector>
+#include "Types.hpp"
+#include "InputData.hpp"
+#include "Solution.hpp"
+#include "RoutePlan.hpp"
+#include "Deadline.hpp"
+
+/**
+ * Assigns chains of up to k rides to each car per step by a min-cost flow instead of one
+ * ride per car and RLAP.
+ *
+ * Each step builds a network over the earliest candidate rides: every car sends at most one
+ * unit of flow from the source through a chain of rides to the sink. The ride nodes are
+ * layered by their position in the chain: car-to-ride edges lead to the first layer,
+ * transition edges from layer i to layer i + 1, so a chain holds at most k rides and no ride
+ * is reserved past the end of a chain. In each layer a ride is split into an in and an out
+ * node with capacity 1; a ride planned in two layers is taken by the first car simulated.
+ * Car-to-ride edges use the exact state of the car, ride-to-ride transition edges assume that
+ * the previous ride started on time. The cost of an edge is the time the car spends driving empty and waiting minus
+ * FlowPlanner#POINT_WEIGHT times the points of the ride, so cars only take rides worth their
+ * time. The flow is computed by successive shortest paths with potentials (Dijkstra); the
+ * network is acyclic (transitions lead to rides starting later), so the initial potentials
+ * are shortest distances in topological order.
+ *
+ * The chains are simulated exactly; rides that can't be finished in time anymore (because an
+ * earlier ride started late) stay unassigned for the next step. If no chain of any car has a
+ * negative cost, every car takes its cheapest chain, so the steps don't stop while rides are
+ * left.
+ */
+class FlowPlanner {
+public:
+
+    /**
+     * Creates a planner.
+     *
+     * \param [in] inputData InputData representing the simulation enviroment
+     * \param [in] chainLength maximal number of rides assigned to a car per step (k)
+     */
+    FlowPlanner(const InputData& inputData, const unsigned chainLength);
+
+    /**
+     * Assigns rides until no car can take any remaining ride or the deadline expired.
+     *
+     * \param [in] deadline steps stop when the deadline expired
+     * \param [in] reserve seconds before the deadline at which the steps stop
+     * \return RoutePlan routes of all cars
+     */
+    RoutePlan run(const Deadline& deadline = Deadline(), const double reserve = 0);
+
+    /**
+     * Number of min-cost flow problems solved by the last run.
+     *
+     * \return unsigned number of solves
+     */
+    unsigned getSolveCount() const {return solves;}
+
+    /**
+     * Number of rides assigned by the last run.
+     *
+     * \return unsigned number of rides
+     */
+    unsigned getAssigned() const {return assigned;}
+
+private:
+
+    /** Weight of the points of a ride relative to the time spent driving empty and waiting. */
+    static constexpr long POINT_WEIGHT = 2;
+
+    /** Candidate rides per step and chain position of each car. */
+    static constexpr unsigned CANDIDATES_PER_SLOT = 2;
+
+    /** Car-to-ride edges kept per car and chain position (cheapest ones). */
+    static constexpr unsigned CAR_EDGES_PER_SLOT = 4;
+
+    /** Transition edges kept per ride (cheapest ones). */
+    static constexpr unsigned TRANSITIONS = 8;
+
+    /** Rides following a ride in start order checked for transitions. */
+    static constexpr unsigned TRANSITION_SCAN = 512;
+
+    /** Edge of the residual network. */
+    struct Edge {
+        /** Head of the edge. */
+        unsigned to;
+        /** Index of the reverse edge. */
+        unsigned reverse;
+        /** Remaining capacity. */
+        int capacity;
+        /** Cost per unit of flow. */
+        long cost;
+    };
+
+    /** Cost of a car in a given state taking a ride. */
+    struct Move {
+        /** Cost (see FlowPlanner). */
+        long cost;
+        /** Point in time the ride is finished. */
+        int finish;
+        /** Points gained by the ride. */
+        int points;
+        /** False if the ride can't be finished in time. */
+        bool feasible;
+    };
+
+    /**
+     * Evaluates a car taking a ride.
+     *
+     * \param [in] x row of the car
+     * \param [in] y column of the car
+     * \param [in] t point in time the car is free
+     * \param [in] ride index of the ride
+     * \return Move cost, finish time and points
+     */
+    Move evaluate(const int x, const int y, const int t, const unsigned ride) const;
+
+    /**
+     * Builds the network of a step over the given cars and candidate rides.
+     *
+     * \param [in] cars state of all cars
+     * \param [in] active indices of the cars getting rides
+     * \param [in] candidates candidate rides, sorted by earliest start
+     */
+    void buildNetwork(const Types::CarData& cars, const std::vector<unsigned>& active,
+                      const std::vector<unsigned>& candidates);
+
+    /**
+     * Adds an edge and its reverse edge to the network.
+     *
+     * \param [in] from tail of the edge
+     * \param [in] to head of the edge
+     * \param [in] cost cost per unit of flow
+     */
+    void addEdge(const unsigned from, const unsigned to, const long cost);
+
+    /**
+     * Sends flow along shortest paths until no path of negative cost is left.
+     *
+     * \param [in] anyCost also send flow along paths of positive cost (one per car)
+     * \return unsigned units of flow sent
+     */
+    unsigned solveFlow(const bool anyCost = false);
+
+    /**
+     * Follows the flow from a car node through its chain of rides.
+     *
+     * \param [in] row index of the car in the active cars of the step
+     * \param [in] candidates candidate rides of the step
+     * \return std::vector<unsigned> rides of the chain
+     */
+    std::vector<unsigned> chainOf(const unsigned row,
+                                  const std::vector<unsigned>& candidates) const;
+
+    /** InputData representing the simulation enviroment. */
+    const InputData& inputData;
+
+    /** Maximal number of rides assigned to a car per step. */
+    const unsigned chainLength;
+
+    /** Edges of the network, kept between steps. */
+    std::vector<Edge> edges;
+
+    /** Indices of the outgoing edges of each node. */
+    std::vector<std::vector<unsigned>> adjacency;
+
+    /** Potentials of the nodes. */
+    std::vector<long> potential;
+
+    /** Number of car nodes of the current network. */
+    unsigned nCars = 0;
+
+    /** Number of solved flow problems. */
+    unsigned solves = 0;
+
+    /** Number of assigned rides. */
+    unsigned assigned = 0;
+};
+
+#endif // FLOW_PLANNER_H
@@ -1,73 +1,375 @@
 #include <cmath>
+#include <cstdlib>
+#include <limits>
 #include <numeric>
 #include <algorithm>
 #include <set>
+#include <stdexcept>
+#include <utility>
 #include "Generator.hpp"
-#include "RLAPSolverHungarian.hpp"
-#include "RLAPSolverJV.hpp"
-
-void Generator::createSearchSpace(Tensor<int>& finishTimes,
-                                  Tensor<int>& finishPoints,
-                                  Tensor<int>& scores,
-                                  std::vector<int>& unassigned,
-                                  Types::CarData& cars) {
-    // For each unassigned ride, calculate times and points for all cars
-    auto ride = unassigned.begin();
-
-    for(unsigned uIndex = 0; uIndex < unassigned.size(); ++uIndex, ++ride) {
-        // distance of current ride
-        int rideDistance = inputData.distances(*ride);
-        // earliest possible start of current ride
-        int earliestStart = inputData.startT(*ride);
-        // latest possible finish of current ride
-        int latestFinish = inputData.endT(*ride);
-
-        for(unsigned car = 0; car < inputData.fleetSize; ++car) {
-
-            // current time of the car
-            int carTime = cars.t(car);
-            // distance to ride starting point
-            int ariveDistance = std::abs(cars.x(car) - inputData.startX(*ride)) +
-                                std::abs(cars.y(car) - inputData.startY(*ride));
-            // point in time when the ride can start (car arrived)
-            int startTime = std::max(carTime + ariveDistance, earliestStart);
-
-            finishTimes(car, uIndex) = startTime + rideDistance;
-            finishPoints(car, uIndex) = cars.p(car);
-
-            // ride ended in time (points gained)
-            if(latestFinish >= finishTimes(car, uIndex)) {
-                finishPoints(car, uIndex) += rideDistance;
+
+/**
+ * Creates a PolicyGenerator.
+ *
+ * \param [in] inputData used internally to get specific information about rides
+ * \return std::unique_ptr<Generator> generator using the scoring policy
+ */
+template<typename ScoringPolicy>
+static std::unique_ptr<Generator> makeGenerator(InputData& inputData) {
+    return std::unique_ptr<Generator>(new PolicyGenerator<ScoringPolicy>(inputData));
+}
+
+/** Compile-time dispatch table of all scoring policies selectable by name. */
+static constexpr std::pair<const char*, std::unique_ptr<Generator>(*)(InputData&)>
+GENERATORS[] = {
+    {Scoring::TimeLeftAndPoints::name, &makeGenerator<Scoring::TimeLeftAndPoints>},
+    {Scoring::Points::name, &makeGenerator<Scoring::Points>},
+    {Scoring::IdlePenalty::name, &makeGenerator<Scoring::IdlePenalty>},
+    {Scoring::WeightedBonus::name, &makeGenerator<Scoring::WeightedBonus>},
+    {Scoring::NextCluster::name, &makeGenerator<Scoring::NextCluster>}
+};
+
+std::unique_ptr<Generator> Generator::create(InputData& inputData,
+        const std::string& scoring) {
+    for(const auto& entry : GENERATORS) {
+        if(scoring == entry.first) {return entry.second(inputData);}
+    }
+
+    throw std::invalid_argument("Unknown scoring heuristic: " + scoring);
+}
+
+std::vector<std::string> Generator::scoringNames() {
+    std::vector<std::string> names;
+
+    for(const auto& entry : GENERATORS) {
+        names.push_back(entry.first);
+    }
+
+    return names;
+}
+
+void Generator::retireCars(const std::vector<int>& unassigned, Types::CarData& cars,
+                           std::vector<unsigned>& batch) {
+    auto canReachAnyRide = [&](const unsigned car) {
+        for(const int ride : unassigned) {
+            const int arrival = cars.t(car) + std::abs(cars.x(car) - inputData.startX(ride)) +
+                                std::abs(cars.y(car) - inputData.startY(ride));
+
+            if(std::max(arrival, inputData.startT(ride)) + inputData.distances(ride) <=
+               inputData.endT(ride)) {
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    // cars never get earlier and rides only disappear, retired cars stay retired
+    batch.erase(std::remove_if(batch.begin(), batch.end(),
+    [&](const unsigned car) {return !canReachAnyRide(car);}), batch.end());
+}
+
+std::vector<unsigned> Generator::candidateColumns(Tensor<int>& scores) {
+    const unsigned rows = scores.getDims()[0];
+    const unsigned cols = scores.getDims()[1];
+    std::vector<bool> isCandidate(cols, false);
+    std::vector<unsigned> order(cols);
+
+    for(unsigned row = 0; row < rows; ++row) {
+        std::iota(order.begin(), order.end(), 0);
+        std::nth_element(order.begin(), order.begin() + rows - 1, order.end(),
+        [&](const unsigned a, const unsigned b) {
+            return scores(row, a) > scores(row, b) || (scores(row, a) == scores(row, b) && a < b);
+        });
+
+        for(unsigned i = 0; i < rows; ++i) {
+            isCandidate[order[i]] = true;
+        }
+    }
+
+    std::vector<unsigned> columns;
+
+    for(unsigned col = 0; col < cols; ++col) {
+        if(isCandidate[col]) {columns.push_back(col);}
+    }
+
+    return columns;
+}
+
+std::vector<unsigned> Generator::reducedCostColumns(const Tensor<int>& scores,
+        const std::vector<int>& rides, double& lowerBound, double& threshold) {
+    const unsigned rows = scores.getDims()[0];
+    const unsigned cols = scores.getDims()[1];
+
+    // premiums of the rides over leaving them unassigned (0: not priced yet)
+    std::vector<double> premiums(cols);
+    lowerBound = 0;
+
+    for(unsigned col = 0; col < cols; ++col) {
+        premiums[col] = ridePrices[rides[col]];
+        lowerBound -= premiums[col];
+    }
+
+    // row duals of the minimization problem (negated scores): the best priced column
+    std::vector<double> u(rows, std::numeric_limits<double>::infinity());
+
+    for(unsigned row = 0; row < rows; ++row) {
+        for(unsigned col = 0; col < cols; ++col) {
+            u[row] = std::min(u[row], premiums[col] - scores(row, col));
+        }
+
+        lowerBound += u[row];
+    }
+
+    // greedy assignment on the priced costs, each row takes its best free column
+    std::vector<char> taken(cols, 0);
+    double upperBound = 0;
+
+    for(unsigned row = 0; row < rows; ++row) {
+        unsigned best = cols;
+
+        for(unsigned col = 0; col < cols; ++col) {
+            if(!taken[col] && (best == cols || premiums[col] - scores(row, col) <
+                               premiums[best] - scores(row, best))) {
+                best = col;
             }
+        }
+
+        taken[best] = 1;
+        upperBound -= scores(row, best);
+    }
+
+    threshold = std::min(upperBound - lowerBound, pruningSlack);
+
+    // smallest reduced cost of each column
+    std::vector<double> reduced(cols, std::numeric_limits<double>::infinity());
+
+    for(unsigned row = 0; row < rows; ++row) {
+        for(unsigned col = 0; col < cols; ++col) {
+            reduced[col] = std::min(reduced[col], premiums[col] - scores(row, col) - u[row]);
+        }
+    }
+
+    std::vector<unsigned> columns;
+
+    for(unsigned col = 0; col < cols; ++col) {
+        if(reduced[col] <= threshold + REDUCED_COST_EPSILON) {columns.push_back(col);}
+    }
+
+    // a slack that is too tight leaves too few columns for all rows
+    if(columns.size() < rows || columns.size() == cols) {return {};}
+
+    prunedColumns += cols - columns.size();
+    return columns;
+}
+
+std::vector<int> Generator::ridesWithinHorizon(const std::vector<int>& unassigned,
+        const int time, const unsigned nCars) {
+    if(horizon < 0) {return unassigned;}
+
+    // a fixed horizon is only extended for the current iteration
+    if(horizon > 0) {currentHorizon = horizon;}
+
+    std::vector<int> rides;
+
+    while(true) {
+        const long limit = static_cast<long>(time) + currentHorizon;
+        rides.clear();
+
+        for(const int ride : unassigned) {
+            if(inputData.startT(ride) <= limit) {rides.push_back(ride);}
+        }
+
+        // every car should be able to get a ride
+        if(rides.size() >= nCars || rides.size() == unassigned.size()) {break;}
+
+        currentHorizon *= 2;
+    }
+
+    // adaptive horizon: keep about HORIZON_COLUMNS columns per car
+    const unsigned target = std::max(HORIZON_COLUMNS * nCars, MIN_HORIZON_COLUMNS);
+
+    if(horizon == 0 && rides.size() > 2 * target) {
+        currentHorizon = std::max(1L, currentHorizon / 2);
+    } else if(horizon == 0 && rides.size() < target / 2) {
+        currentHorizon *= 2;
+    }
+
+    return rides;
+}
 
-            // ride started in time (bonus gained)
-            if(earliestStart == startTime) {
-                finishPoints(car, uIndex) += inputData.bonus;
+void Generator::computeFollowUps(const std::vector<int>& unassigned,
+                                 const std::vector<int>& rides) {
+    auto points = [this](const int ride) {
+        return jobPoints.empty() ? inputData.distances(ride) : jobPoints[ride];
+    };
+    auto bonus = [this](const int ride) {
+        return jobPoints.empty() ? static_cast<int>(inputData.bonus) :
+               jobBonuses[ride] * static_cast<int>(inputData.bonus);
+    };
+
+    if(startOrder.empty()) {
+        startOrder.resize(inputData.nRides);
+        std::iota(startOrder.begin(), startOrder.end(), 0);
+        std::stable_sort(startOrder.begin(), startOrder.end(), [this](const int a, const int b) {
+            return inputData.startT(a) < inputData.startT(b);
+        });
+        isUnassigned.assign(inputData.nRides, 0);
+    }
+
+    if(followUpRides.empty()) {
+        followUpRides.assign(inputData.nRides, FOLLOW_UP_UNKNOWN);
+        followUpValues.assign(inputData.nRides, 0);
+    }
+
+    // no ride started later than this after the car is free is worth it
+    int maxValue = 0;
+
+    for(const int ride : unassigned) {
+        isUnassigned[ride] = 1;
+        maxValue = std::max(maxValue, points(ride) + bonus(ride));
+    }
+
+    // rides only disappear on a search path, a follow-up stays the best until it's gone
+    std::vector<int> stale;
+
+    for(const int ride : rides) {
+        const int next = followUpRides[ride];
+
+        if(next == FOLLOW_UP_UNKNOWN || (next >= 0 && !isUnassigned[next])) {
+            stale.push_back(ride);
+        }
+    }
+
+    auto work = [&](const unsigned first, const unsigned last) {
+        for(unsigned i = first; i < last; ++i) {
+            const int ride = stale[i];
+            const int finish = inputData.startT(ride) + inputData.distances(ride);
+            int best = 0;
+            int bestRide = -1;
+
+            for(const int next : startOrder) {
+                if(inputData.startT(next) - finish > maxValue) {break;}
+
+                if(!isUnassigned[next] || next == ride) {continue;}
+
+                const int arrival = finish + std::abs(inputData.endX(ride) -
+                                                      inputData.startX(next)) +
+                                    std::abs(inputData.endY(ride) - inputData.startY(next));
+                const int start = std::max(arrival, inputData.startT(next));
+
+                if(start + inputData.distances(next) > inputData.endT(next)) {continue;}
+
+                const int value = points(next) - (start - finish) +
+                                  (start == inputData.startT(next) ? bonus(next) : 0);
+
+                if(value > best) {
+                    best = value;
+                    bestRide = next;
+                }
             }
 
-            scores(car, uIndex) = std::max(static_cast<int>(inputData.maxTime) - finishTimes(car,
-                                           uIndex), 0) + finishPoints(car, uIndex);
+            followUpRides[ride] = bestRide;
+            followUpValues[ride] = best;
         }
+    };
+
+    // blocks of consecutive stale rides, the first one is computed by this thread
+    const unsigned nBlocks = std::max(1u, std::min(lookaheadThreads,
+                                      static_cast<unsigned>(stale.size())));
+    std::vector<std::thread> threads;
+
+    for(unsigned block = 1; block < nBlocks; ++block) {
+        threads.emplace_back(work, stale.size() * block / nBlocks,
+                             stale.size() * (block + 1) / nBlocks);
+    }
+
+    work(0, stale.size() / nBlocks);
+
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+
+    recomputedFollowUps += stale.size();
+
+    for(const int ride : unassigned) {
+        isUnassigned[ride] = 0;
     }
 }
 
 std::shared_ptr<SearchGraphNode> Generator::selectFromSearchSpace(Types::CarData& cars,
         std::vector<int>& unassigned,
         std::shared_ptr<SearchGraphNode>& prevNode,
+        const std::vector<unsigned>& batch,
+        const std::vector<int>& rides,
         Tensor<int>& finishTimes,
         Tensor<int>& finishPoints,
         Tensor<int>& scores) {
     // no possible choices left
-    const unsigned nAssignments = std::min(inputData.fleetSize,
-                                           static_cast<unsigned>(unassigned.size()));
+    const unsigned nAssignments = std::min(static_cast<unsigned>(batch.size()),
+                                           static_cast<unsigned>(rides.size()));
 
     if(nAssignments == 0) { return {}; }
 
+    std::vector<unsigned> columns;
+    const Tensor<int>* matrix = &scores;
+    double lowerBound = 0;
+    double threshold = 0;
+    bool pruned = false;
+
+    // with few cars only the best columns of each car can be part of an optimal assignment,
+    // otherwise columns whose reduced costs exceed the gap can't be part of one
+    if(static_cast<unsigned long>(batch.size()) * batch.size() < rides.size()) {
+        columns = candidateColumns(scores);
+    } else if(pruningSlack >= 0 && batch.size() < rides.size()) {
+        columns = reducedCostColumns(scores, rides, lowerBound, threshold);
+        pruned = !columns.empty();
+    }
+
+    if(!columns.empty()) {
+        Tensor<int>& candidates = workspace->candidates;
+        candidates.reshape({ static_cast<unsigned>(batch.size()),
+                             static_cast<unsigned>(columns.size())
+                           });
+
+        for(unsigned row = 0; row < batch.size(); ++row) {
+            for(unsigned col = 0; col < columns.size(); ++col) {
+                candidates(row, col) = scores(row, columns[col]);
+            }
+        }
+
+        matrix = &candidates;
+    }
+
     // solve RLAP to maximize gained points
-    //RLAPSolverHungarian solver(scores, maxScore);
-    RLAPSolverJV solver(scores);
     std::unique_ptr<Tensor<unsigned>> searchNodeValue(new Tensor<unsigned>({ nAssignments, 2 }));
-    solver.solve(*searchNodeValue);
+    const bool approximate = approximateSolver && matrix->getDims()[1] >= approximateColumns;
+
+    if(approximate) {
+        approximateSolver->solve(*matrix, RLAPSolver::Objective::maximize, *searchNodeValue);
+        ++approximated;
+    } else if(!workspace->solver.solve(*matrix, RLAPSolver::Objective::maximize,
+                                       *searchNodeValue, Deadline(rlapDeadline))) {
+        ++deadlineHits;
+        deadlineLossBound += workspace->solver.getLossBound();
+        maxDeadlineLoss = std::max(maxDeadlineLoss, workspace->solver.getLossBound());
+    }
+
+    // premiums of the columns over the dummy rows (the largest dual) price the rides of the
+    // next iteration, rides left out of the RLAP have no premium
+    if(pruningSlack >= 0 && !approximate) {
+        const std::vector<double>& duals = workspace->solver.getColumnDuals();
+        const unsigned cols = matrix->getDims()[1];
+        const double outside = *std::max_element(duals.begin(), duals.begin() + cols);
+
+        for(const int ride : rides) {ridePrices[ride] = 0;}
+
+        for(unsigned col = 0; col < cols; ++col) {
+            ridePrices[rides[columns.empty() ? col : columns[col]]] = outside - duals[col];
+        }
+    }
+
+    double cost = 0;
 
     // more efficient structure to remove entries from
     std::set<int> newUnassigned(unassigned.begin(), unassigned.end());
@@ -76,19 +378,30 @@ std::shared_ptr<SearchGraphNode> Generator::selectFromSearchSpace(Types::CarData
 
     // update cars
     for(unsigned i = 0; i < nAssignments; ++i) {
-        const int car = (*searchNodeValue)(i, 0);
-        const int uIndex = (*searchNodeValue)(i, 1);
-        const int ride = unassigned[uIndex];
+        const int row = (*searchNodeValue)(i, 0);
+        const int car = batch[row];
+        const int col = (*searchNodeValue)(i, 1);
+        const int uIndex = columns.empty() ? col : columns[col];
+        const int ride = rides[uIndex];
         newUnassigned.erase(ride);
 
         cars.x(car) = inputData.endX(ride);
         cars.y(car) = inputData.endY(ride);
-        cars.t(car) = finishTimes(car, uIndex);
-        cars.p(car) = finishPoints(car, uIndex);
+        cars.t(car) = finishTimes(row, uIndex);
+        cars.p(car) = finishPoints(row, uIndex);
 
+        cost -= scores(row, uIndex);
+
+        (*searchNodeValue)(i, 0) = car;
         (*searchNodeValue)(i, 1) = ride;
     }
 
+    // the assignment is optimal if no column with a reduced cost above its gap was pruned
+    if(pruned && cost - lowerBound > threshold + REDUCED_COST_EPSILON) {
+        ++uncertified;
+        pruningLossBound += cost - lowerBound;
+    }
+
     // update unassigned vector (without rides that have been assigned)
     unassigned.assign(newUnassigned.begin(), newUnassigned.end());
     return std::make_shared<SearchGraphNode>(prevNode, searchNodeValue);
@@ -97,14 +410,85 @@ std::shared_ptr<SearchGraphNode> Generator::selectFromSearchSpace(Types::CarData
 std::shared_ptr<SearchGraphNode> Generator::generate(std::vector<int>& unassigned,
         Types::CarData& cars,
         std::shared_ptr<SearchGraphNode>& prevNode) {
-    // Time after each car was assigned to each unassigned ride (2D matrix)
-    Tensor<int> finishTimes({ inputData.fleetSize, static_cast<unsigned>(unassigned.size()) });
-    // Points after each car was assigned to each unassigned ride (2D matrix)
-    Tensor<int> finishPoints({ inputData.fleetSize, static_cast<unsigned>(unassigned.size()) });
-    // Scores of each car beeing assigned to each ride
-    Tensor<int> scores({ inputData.fleetSize, static_cast<unsigned>(unassigned.size()) });
-
-    createSearchSpace(finishTimes, finishPoints, scores, unassigned, cars);
-    return selectFromSearchSpace(cars, unassigned, prevNode, finishTimes, finishPoints,
-                                 scores);
+    // a new search path starts with all cars
+    if(!prevNode) {
+        activeCars.resize(inputData.fleetSize);
+        std::iota(activeCars.begin(), activeCars.end(), 0);
+    }
+
+    return generate(unassigned, cars, prevNode, activeCars);
+}
+
+std::shared_ptr<SearchGraphNode> Generator::generate(std::vector<int>& unassigned,
+        Types::CarData& cars,
+        std::shared_ptr<SearchGraphNode>& prevNode,
+        std::vector<unsigned>& batch) {
+    // a new search path starts
+    if(!prevNode) {
+        expiry.reset();
+        retired = 0;
+        savedColumns = 0;
+        iterations = 0;
+        totalColumns = 0;
+        recomputedFollowUps = 0;
+        followUpRides.clear();
+        prunedColumns = 0;
+        uncertified = 0;
+        pruningLossBound = 0;
+        approximated = 0;
+        deadlineHits = 0;
+        deadlineLossBound = 0;
+        maxDeadlineLoss = 0;
+        ridePrices.assign(inputData.nRides, 0);
+        currentHorizon = horizon > 0 ? horizon : std::max(1u, inputData.maxTime / 100);
+    }
+
+    // rides that can't be started in time by the earliest car won't earn any points
+    int earliestCarTime = inputData.maxTime;
+
+    for(const unsigned car : batch) {
+        earliestCarTime = std::min(earliestCarTime, cars.t(car));
+    }
+
+    retired += expiry.retire(unassigned, earliestCarTime);
+    savedColumns += retired;
+    retireCars(unassigned, cars, batch);
+
+    if(unassigned.empty() || batch.empty()) {return prevNode;}
+
+    // only rides starting soon are columns of the matrices
+    std::vector<int> rides = ridesWithinHorizon(unassigned, earliestCarTime, batch.size());
+    ++iterations;
+    totalColumns += rides.size();
+
+    const unsigned nActive = batch.size();
+    // Time after each active car was assigned to each candidate ride (2D matrix)
+    Tensor<int>& finishTimes = workspace->finishTimes;
+    finishTimes.reshape({ nActive, static_cast<unsigned>(rides.size()) });
+    // Points after each active car was assigned to each candidate ride (2D matrix)
+    Tensor<int>& finishPoints = workspace->finishPoints;
+    finishPoints.reshape({ nActive, static_cast<unsigned>(rides.size()) });
+    // Scores of each active car beeing assigned to each candidate ride
+    Tensor<int>& scores = workspace->scores;
+    scores.reshape({ nActive, static_cast<unsigned>(rides.size()) });
+
+    createSearchSpace(finishTimes, finishPoints, scores, rides, cars, batch);
+
+    // two-step lookahead, the follow-up only counts if the candidate ride is finished in time
+    if(lookahead > 0) {
+        computeFollowUps(unassigned, rides);
+
+        for(unsigned col = 0; col < rides.size(); ++col) {
+            const int term = std::lround(lookahead * followUpValues[rides[col]]);
+
+            for(unsigned row = 0; row < nActive; ++row) {
+                if(finishTimes(row, col) <= inputData.endT(rides[col])) {
+                    scores(row, col) += term;
+                }
+            }
+        }
+    }
+
+    return selectFromSearchSpace(cars, unassigned, prevNode, batch, rides, finishTimes,
+                                 finishPoints, scores);
 };
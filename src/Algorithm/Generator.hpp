@@ -1,12 +1,19 @@
 #ifndef GENERATOR_H
 #define GENERATOR_H
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <thread>
 #include <vector>
 #include "Types.hpp"
 #include "Tensor.hpp"
 #include "InputData.hpp"
 #include "SearchGraphNode.hpp"
+#include "ScoringPolicies.hpp"
+#include "ExpiryIndex.hpp"
+#include "RLAPSolverJV.hpp"
+#include "RLAPSolverGreedyRegret.hpp"
 
 /**
  * Finds the best possible way to distribute one ride to each car given
@@ -15,17 +22,61 @@
 class Generator {
 public:
 
+    /**
+     * Matrices and RLAP solver of an iteration. They are kept between iterations and can be shared by
+     * generators running one after another (e.g. jobs of a Batch), so they are only
+     * reallocated when a larger matrix is needed.
+     */
+    struct Workspace {
+        /** Finish time of each batch car taking each candidate ride. */
+        Tensor<int> finishTimes;
+        /** Points of each batch car after taking each candidate ride. */
+        Tensor<int> finishPoints;
+        /** Scores of each batch car taking each candidate ride. */
+        Tensor<int> scores;
+        /** Scores of the candidate columns (see Generator::candidateColumns). */
+        Tensor<int> candidates;
+        /** Solver of the RLAPs, keeps its buffers for the whole run. */
+        RLAPSolverJV solver;
+    };
+
+    /**
+     * Creates a generator using a scoring policy selected by name.
+     *
+     * \param [in] inputData used internally to get specific information about rides
+     * \param [in] scoring name of the policy (see Generator::scoringNames)
+     * \throw std::invalid_argument if the name is unknown
+     * \return std::unique_ptr<Generator> generator using the scoring policy
+     */
+    static std::unique_ptr<Generator> create(InputData& inputData, const std::string& scoring);
+
+    /**
+     * Names of all scoring policies that can be selected.
+     *
+     * \return std::vector<std::string> list of names
+     */
+    static std::vector<std::string> scoringNames();
+
     /**
      * Creates a generator of choices on given input data.
      *
      * \param [in] inputData used internally to get specific information about rides
      */
-    Generator(InputData& inputData): inputData(inputData) {};
+    Generator(InputData& inputData):
+        inputData(inputData), horizon(-1), currentHorizon(0), retired(0), savedColumns(0),
+        iterations(0), totalColumns(0), expiry(inputData),
+        workspace(std::make_shared<Workspace>()) {};
+
+    virtual ~Generator() {};
 
     /**
      * Given the current state of the search process this generates the next optimal choice to take.
      *
      * \note This method should be called repeatedly using its result until the searchpath is complete
+     * \note Rides that can't be finished in time by any car are removed from unassigned
+     *       without being assigned (see Generator::getRetiredCount)
+     * \note Cars that can't finish any unassigned ride in time anymore are retired, only
+     *       active cars get rides (see Generator::getActiveCars)
      *
      * \param [in,out] unassigned a list of indices of all unassigned rides
      * \param [in,out] cars represents the current state of all cars
@@ -36,24 +87,308 @@ public:
             Types::CarData& cars,
             std::shared_ptr<SearchGraphNode>& prevNode);
 
-private:
+    /**
+     * Like Generator::generate, but only the cars of a batch get rides (event-driven dispatch).
+     *
+     * \note The batch has to contain the car with the earliest point in time of all active
+     *       cars, rides that it can't finish in time anymore are retired.
+     *
+     * \param [in,out] unassigned a list of indices of all unassigned rides
+     * \param [in,out] cars represents the current state of all cars
+     * \param [in] prevNode is referenced by the new SearchGraphNode of the returned Choice
+     * \param [in,out] batch cars to assign rides to, cars that can't finish any unassigned
+     *                  ride in time anymore are removed
+     * \return std::shared_ptr<SearchGraphNode> optimal way to assign one ride to each car of
+     *         the batch (prevNode if no ride could be assigned)
+     */
+    std::shared_ptr<SearchGraphNode> generate(std::vector<int>& unassigned,
+            Types::CarData& cars,
+            std::shared_ptr<SearchGraphNode>& prevNode,
+            std::vector<unsigned>& batch);
+
+    /**
+     * Restricts the columns of the matrices to rides starting within a time horizon after
+     * the earliest car of each iteration (takes effect on the next search path).
+     * The horizon is extended if there are fewer rides than cars in it.
+     *
+     * \param [in] horizon steps after the earliest car (-1: all rides, 0: adaptive, starting
+     *             at 1% of the simulation and halved or doubled to keep about
+     *             Generator#HORIZON_COLUMNS columns per car)
+     */
+    void setHorizon(const int horizon) {this->horizon = horizon;}
+
+    /**
+     * Replaces the matrices used by the iterations.
+     *
+     * \note A workspace must not be used by generators running concurrently.
+     *
+     * \param [in] workspace matrices reused by this generator
+     */
+    void setWorkspace(std::shared_ptr<Workspace> workspace) {this->workspace = workspace;}
+
+    /**
+     * Adds a two-step lookahead to the scores: the value of the best follow-up ride after
+     * each candidate ride (see Generator::computeFollowUps) times the weight is added to the
+     * score of every car finishing the candidate ride in time.
+     *
+     * \param [in] weight factor of the follow-up value (0: disabled)
+     * \param [in] nThreads number of threads computing the follow-up values (0: one per core)
+     */
+    void setLookahead(const double weight, const unsigned nThreads = 1) {
+        lookahead = weight;
+        lookaheadThreads = nThreads > 0 ? nThreads :
+                           std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /**
+     * Filters the columns of the RLAP of each iteration by reduced costs. The column duals
+     * of the previous RLAP (see RLAPSolverJV::getColumnDuals) give each ride a premium over
+     * leaving it unassigned. With these prices every row takes its best priced column, which
+     * gives a lower bound of the (minimized, negated) scores, and a greedy assignment gives an
+     * upper bound. A column whose reduced costs exceed the gap between them can't be part of
+     * any optimal assignment. With a finite slack the threshold is at most the slack: the
+     * result is only certified optimal if its gap to the lower bound is within the threshold,
+     * the loss of all other iterations is bounded by that gap (see
+     * Generator::getPruningLossBound). Matrices with few cars are filtered by
+     * Generator::candidateColumns instead.
+     *
+     * \param [in] slack maximal reduced cost of a kept column (negative: disabled,
+     *             infinity: only columns that can't be part of an optimal assignment)
+     */
+    void setDualPruning(const double slack) {pruningSlack = slack;}
+
+    /**
+     * Solves wide RLAPs approximately by RLAPSolverGreedyRegret instead of RLAPSolverJV.
+     * The prices of Generator::setDualPruning are kept from the last exactly solved RLAP.
+     *
+     * \param [in] columns minimal number of columns of an approximately solved RLAP (0: disabled)
+     * \param [in] auctionBids maximal number of bids of the auction polish per RLAP
+     */
+    void setApproximation(const unsigned columns, const unsigned auctionBids = 0) {
+        approximateColumns = columns;
+        approximateSolver.reset(columns > 0 ? new RLAPSolverGreedyRegret(auctionBids) : nullptr);
+    }
+
+    /**
+     * Gives every exactly solved RLAP a deadline (see RLAPSolverJV::solve). Rows left when
+     * it expires are assigned greedily, the loss is bounded by the duals.
+     *
+     * \param [in] seconds budget of each RLAP (0: no deadline)
+     */
+    void setRLAPDeadline(const double seconds) {rlapDeadline = seconds;}
+
+    /**
+     * Sets the points of composite jobs (see RideChains): the distance of a job is its
+     * duration, the points differ from it.
+     *
+     * \param [in] points distances of all rides of each job, gained if it's finished in time
+     * \param [in] bonuses number of bonuses of each job gained if it's started in time
+     */
+    void setJobPoints(const std::vector<int>& points, const std::vector<int>& bonuses) {
+        jobPoints = points;
+        jobBonuses = bonuses;
+    }
+
+    /**
+     * Average number of columns of the score matrix on the current search path.
+     *
+     * \return double average number of columns per iteration
+     */
+    double getAverageColumns() const {return iterations > 0 ? double(totalColumns) / iterations : 0;}
+
+    /**
+     * Number of rides retired on the current search path because no car can finish them in
+     * time anymore. Each of them saves one column of the score matrix per iteration.
+     *
+     * \return unsigned number of retired rides
+     */
+    unsigned getRetiredCount() const {return retired;}
+
+    /**
+     * Number of score matrix columns saved by retiring rides, summed over all iterations of
+     * the current search path.
+     *
+     * \return unsigned long number of saved columns
+     */
+    unsigned long getSavedColumns() const {return savedColumns;}
+
+    /**
+     * Number of columns removed by reduced costs (see Generator::setDualPruning), summed
+     * over all iterations of the current search path.
+     *
+     * \return unsigned long number of pruned columns
+     */
+    unsigned long getPrunedColumns() const {return prunedColumns;}
+
+    /**
+     * Average share of the columns removed by reduced costs per iteration of the current
+     * search path.
+     *
+     * \return double pruned columns divided by all columns
+     */
+    double getPrunedShare() const {return totalColumns > 0 ? double(prunedColumns) / totalColumns : 0;}
+
+    /**
+     * Number of iterations of the current search path whose assignment isn't certified
+     * optimal because the slack of Generator::setDualPruning was tighter than the gap.
+     *
+     * \return unsigned number of uncertified iterations
+     */
+    unsigned getUncertifiedIterations() const {return uncertified;}
+
+    /**
+     * Upper bound of the score lost by pruning with a finite slack, summed over all
+     * uncertified iterations of the current search path.
+     *
+     * \return double maximal loss of scores
+     */
+    double getPruningLossBound() const {return pruningLossBound;}
+
+    /**
+     * Number of follow-up values computed on the current search path (see
+     * Generator::setLookahead), at most one per candidate ride and iteration.
+     *
+     * \return unsigned long number of computed follow-up values
+     */
+    unsigned long getRecomputedFollowUps() const {return recomputedFollowUps;}
+
+    /**
+     * Number of RLAPs of the current search path solved approximately (see
+     * Generator::setApproximation).
+     *
+     * \return unsigned number of approximated iterations
+     */
+    unsigned getApproximatedIterations() const {return approximated;}
+
+    /**
+     * Number of RLAPs of the current search path whose deadline expired before they were
+     * solved optimally (see Generator::setRLAPDeadline).
+     *
+     * \return unsigned number of expired deadlines
+     */
+    unsigned getDeadlineHits() const {return deadlineHits;}
+
+    /**
+     * Upper bound of the score lost by expired deadlines, summed over all RLAPs of the
+     * current search path.
+     *
+     * \return double maximal loss of scores
+     */
+    double getDeadlineLossBound() const {return deadlineLossBound;}
+
+    /**
+     * Largest loss bound of a single RLAP whose deadline expired on the current search path.
+     *
+     * \return double maximal loss of scores of one RLAP
+     */
+    double getMaxDeadlineLoss() const {return maxDeadlineLoss;}
+
+    /**
+     * Cars that could still finish an unassigned ride in time after the last call of
+     * Generator::generate. The search path is complete if there are none.
+     *
+     * \return const std::vector<unsigned>& indices of all active cars
+     */
+    const std::vector<unsigned>& getActiveCars() const {return activeCars;}
+
+protected:
 
     /**
      * Given a list of unassigned rides and current state of each car, this method
      * calculates finish times and finish points for each car taking each unassigned ride
      *
-     * \param [out] finishTimes CxR matrix (C:=numer of cars, R:=number of unassigned rides)
-     * \param [out] finishPoints CxR matrix (C:=numer of cars, R:=number of unassigned rides)
-     * \param [out] scores CxR RLA Matrix to be solved to assign rides optimally (C:=numer of cars, R:=number of unassigned rides)
-     * \param [in] a list of indices of all unassigned rides
+     * \param [out] finishTimes CxR matrix (C:=numer of cars in the batch, R:=number of unassigned rides)
+     * \param [out] finishPoints CxR matrix (C:=numer of cars in the batch, R:=number of unassigned rides)
+     * \param [out] scores CxR RLA Matrix to be solved to assign rides optimally (C:=numer of cars in the batch, R:=number of unassigned rides)
+     * \param [in] a list of indices of the candidate rides (columns)
      * \param [in] represents the current state of all cars
+     * \param [in] batch cars represented by the rows of the matrices
      * \return int maximum value in finishPoints (used for hungarian algorithm)
      */
-    void createSearchSpace(Tensor<int>& finishTimes,
-                           Tensor<int>& finishPoints,
-                           Tensor<int>& scores,
-                           std::vector<int>& unassigned,
-                           Types::CarData& cars);
+    virtual void createSearchSpace(Tensor<int>& finishTimes,
+                                   Tensor<int>& finishPoints,
+                                   Tensor<int>& scores,
+                                   std::vector<int>& unassigned,
+                                   Types::CarData& cars,
+                                   const std::vector<unsigned>& batch) = 0;
+
+    /** Used internally to get specific information about rides. */
+    InputData& inputData;
+
+    /** Points of each composite job (empty: the points of a ride are its distance). */
+    std::vector<int> jobPoints;
+
+    /** Number of bonuses of each composite job. */
+    std::vector<int> jobBonuses;
+
+private:
+
+    /** Target number of columns per car of the adaptive horizon. */
+    static constexpr unsigned HORIZON_COLUMNS = 4;
+
+    /** Minimal target number of columns of the adaptive horizon. */
+    static constexpr unsigned MIN_HORIZON_COLUMNS = 256;
+
+    /** Marks follow-up rides that haven't been computed yet. */
+    static constexpr int FOLLOW_UP_UNKNOWN = -2;
+
+    /** Tolerance of reduced costs, the duals are floating point numbers. */
+    static constexpr double REDUCED_COST_EPSILON = 1e-6;
+
+    /**
+     * Selects the unassigned rides starting within the time horizon (see Generator::setHorizon).
+     *
+     * \param [in] unassigned a list of indices of all unassigned rides
+     * \param [in] time point in time of the earliest car
+     * \param [in] nCars number of cars getting rides
+     * \return std::vector<int> rides within the horizon
+     */
+    std::vector<int> ridesWithinHorizon(const std::vector<int>& unassigned, const int time,
+                                        const unsigned nCars);
+
+    /**
+     * Removes all cars from a batch that can't finish any unassigned ride in time.
+     *
+     * \param [in] unassigned a list of indices of all unassigned rides
+     * \param [in] cars represents the current state of all cars
+     * \param [in,out] batch cars to check
+     */
+    void retireCars(const std::vector<int>& unassigned, Types::CarData& cars,
+                    std::vector<unsigned>& batch);
+
+    /**
+     * Finds the columns that can be part of an optimal assignment: with C rows each row is
+     * assigned to one of its C best columns (at most C - 1 of them are taken by other rows).
+     *
+     * \param [in] scores CxR RLA Matrix
+     * \return std::vector<unsigned> sorted indices of the candidate columns
+     */
+    std::vector<unsigned> candidateColumns(Tensor<int>& scores);
+
+    /**
+     * Finds the columns that are kept by reduced costs (see Generator::setDualPruning).
+     *
+     * \param [in] scores CxR RLA Matrix (C < R)
+     * \param [in] rides rides represented by the columns of the matrix
+     * \param [out] lowerBound lower bound of the minimized, negated scores
+     * \param [out] threshold maximal reduced cost of the kept columns
+     * \return std::vector<unsigned> sorted indices of the kept columns (empty: all columns)
+     */
+    std::vector<unsigned> reducedCostColumns(const Tensor<int>& scores,
+            const std::vector<int>& rides, double& lowerBound, double& threshold);
+
+    /**
+     * Computes the value of the best follow-up ride of each candidate ride: a car finishing
+     * the candidate ride as early as possible (started on time) takes an unassigned ride,
+     * its value are the points of that ride minus the steps driving empty and waiting
+     * (0 if no ride is worth it). Since rides only disappear on a search path, the values are
+     * kept and only recomputed when the best follow-up ride was assigned or retired. The
+     * recomputed candidates are split among Generator#lookaheadThreads threads.
+     *
+     * \param [in] unassigned a list of indices of all unassigned rides
+     * \param [in] rides candidate rides (columns)
+     */
+    void computeFollowUps(const std::vector<int>& unassigned, const std::vector<int>& rides);
 
     /**
      * Solves the rectangular linear assignment problem of choosing the maximal scores and
@@ -62,6 +397,8 @@ private:
      * \param [out] cars represents the current state of all cars
      * \param [in,out] unassigned a list of indices of all unassigned rides
      * \param [in] prevNode is referenced by the new SearchGraphNode of the returned Choice
+     * \param [in] batch cars represented by the rows of the matrices
+     * \param [in] rides rides represented by the columns of the matrices
      * \param [in] finishTimes finish times os all cars taking all rides
      * \param [in] finishPoints gained points for all cars taking all rides
      * \param [in] scores RLA Matrix to be solved to assign rides optimally
@@ -70,12 +407,129 @@ private:
     std::shared_ptr<SearchGraphNode> selectFromSearchSpace(Types::CarData& cars,
             std::vector<int>& unassigned,
             std::shared_ptr<SearchGraphNode>& prevNode,
+            const std::vector<unsigned>& batch,
+            const std::vector<int>& rides,
             Tensor<int>& finishTimes,
             Tensor<int>& finishPoints,
             Tensor<int>& scores);
 
-    /** Used internally to get specific information about rides. */
-    InputData& inputData;
+    /** Cars that can still finish an unassigned ride in time (see Generator::generate). */
+    std::vector<unsigned> activeCars;
+
+    /** Steps after the earliest car rides have to start in (-1: all rides, 0: adaptive). */
+    int horizon;
+
+    /** Time horizon of the current iteration. */
+    long currentHorizon;
+
+    /** Number of rides retired on the current search path. */
+    unsigned retired;
+
+    /** Number of score matrix columns saved on the current search path. */
+    unsigned long savedColumns;
+
+    /** Number of iterations on the current search path. */
+    unsigned iterations;
+
+    /** Number of score matrix columns summed over all iterations of the current search path. */
+    unsigned long totalColumns;
+
+    /** Finds rides that can't be finished in time anymore. */
+    ExpiryIndex expiry;
+
+    /** Weight of the follow-up values in the scores (0: no lookahead). */
+    double lookahead = 0;
+
+    /** Number of threads computing the follow-up values. */
+    unsigned lookaheadThreads = 1;
+
+    /** All rides ordered by earliest start, created by the first lookahead. */
+    std::vector<int> startOrder;
+
+    /** Marks the unassigned rides during Generator::computeFollowUps. */
+    std::vector<char> isUnassigned;
+
+    /** Best follow-up ride of each ride (-1: none, FOLLOW_UP_UNKNOWN: not computed yet). */
+    std::vector<int> followUpRides;
+
+    /** Value of the best follow-up ride of each ride. */
+    std::vector<int> followUpValues;
+
+    /** Number of follow-up values computed on the current search path. */
+    unsigned long recomputedFollowUps = 0;
+
+    /** Maximal reduced cost of a kept column (negative: no pruning by reduced costs). */
+    double pruningSlack = -1;
+
+    /** Premium of each ride in the last RLAP it was part of (0: not priced). */
+    std::vector<double> ridePrices;
+
+    /** Number of columns pruned by reduced costs on the current search path. */
+    unsigned long prunedColumns = 0;
+
+    /** Number of iterations on the current search path that aren't certified optimal. */
+    unsigned uncertified = 0;
+
+    /** Upper bound of the score lost by pruning on the current search path. */
+    double pruningLossBound = 0;
+
+    /** Minimal number of columns of an approximately solved RLAP (0: all are solved exactly). */
+    unsigned approximateColumns = 0;
+
+    /** Solver of the wide RLAPs (only if they are approximated). */
+    std::unique_ptr<RLAPSolverGreedyRegret> approximateSolver;
+
+    /** Number of RLAPs solved approximately on the current search path. */
+    unsigned approximated = 0;
+
+    /** Budget of each exactly solved RLAP in seconds (0: no deadline). */
+    double rlapDeadline = 0;
+
+    /** Number of RLAPs on the current search path whose deadline expired. */
+    unsigned deadlineHits = 0;
+
+    /** Upper bound of the score lost by expired deadlines on the current search path. */
+    double deadlineLossBound = 0;
+
+    /** Largest loss bound of one RLAP on the current search path. */
+    double maxDeadlineLoss = 0;
+
+    /** Matrices reused by the iterations. */
+    std::shared_ptr<Workspace> workspace;
 };
 
+/**
+ * Generator scoring a car taking a ride by a policy (see ScoringPolicies.hpp).
+ * The policy is resolved at compile time and inlined into the loop filling the score matrix.
+ *
+ * \tparam ScoringPolicy policy scoring a car taking a ride
+ */
+template<typename ScoringPolicy>
+class PolicyGenerator : public Generator {
+public:
+
+    /**
+     * Creates a generator of choices on given input data.
+     *
+     * \param [in] inputData used internally to get specific information about rides
+     */
+    PolicyGenerator(InputData& inputData): Generator(inputData), policy(inputData) {};
+
+protected:
+
+    void createSearchSpace(Tensor<int>& finishTimes,
+                           Tensor<int>& finishPoints,
+                           Tensor<int>& scores,
+                           std::vector<int>& unassigned,
+                           Types::CarData& cars,
+                           const std::vector<unsigned>& batch) override;
+
+private:
+
+    /** Policy scoring a car taking a ride. */
+    const ScoringPolicy policy;
+};
+
+#include "Generator.tpp"
+
 #endif // GENERATOR_H
@@ -0,0 +1,59 @@
+#ifndef GENERATOR_T
+#define GENERATOR_T
+
+#include <algorithm>
+#include <cmath>
+
+template<typename ScoringPolicy>
+void PolicyGenerator<ScoringPolicy>::createSearchSpace(Tensor<int>& finishTimes,
+        Tensor<int>& finishPoints,
+        Tensor<int>& scores,
+        std::vector<int>& unassigned,
+        Types::CarData& cars,
+        const std::vector<unsigned>& batch) {
+    // For each unassigned ride, calculate times and points for all cars of the batch
+    auto ride = unassigned.begin();
+
+    for(unsigned uIndex = 0; uIndex < unassigned.size(); ++uIndex, ++ride) {
+        // distance of current ride
+        int rideDistance = inputData.distances(*ride);
+        // earliest possible start of current ride
+        int earliestStart = inputData.startT(*ride);
+        // latest possible finish of current ride
+        int latestFinish = inputData.endT(*ride);
+        // points and bonus of current ride (of all rides of a composite job)
+        const int ridePoints = jobPoints.empty() ? rideDistance : jobPoints[*ride];
+        const int rideBonus = jobPoints.empty() ? inputData.bonus :
+                              jobBonuses[*ride] * inputData.bonus;
+
+        for(unsigned row = 0; row < batch.size(); ++row) {
+            const unsigned car = batch[row];
+
+            // current time of the car
+            int carTime = cars.t(car);
+            // distance to ride starting point
+            int ariveDistance = std::abs(cars.x(car) - inputData.startX(*ride)) +
+                                std::abs(cars.y(car) - inputData.startY(*ride));
+            // point in time when the ride can start (car arrived)
+            int startTime = std::max(carTime + ariveDistance, earliestStart);
+
+            finishTimes(row, uIndex) = startTime + rideDistance;
+            finishPoints(row, uIndex) = cars.p(car);
+
+            // ride ended in time (points gained)
+            if(latestFinish >= finishTimes(row, uIndex)) {
+                finishPoints(row, uIndex) += ridePoints;
+            }
+
+            // ride started in time (bonus gained)
+            if(earliestStart == startTime) {
+                finishPoints(row, uIndex) += rideBonus;
+            }
+
+            scores(row, uIndex) = policy(*ride, carTime, startTime, finishTimes(row, uIndex),
+                                         finishPoints(row, uIndex), earliestStart == startTime);
+        }
+    }
+}
+
+#endif // GENERATOR_T
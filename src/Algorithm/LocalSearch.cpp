@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <thread>
+#include <tuple>
+#include "LocalSearch.hpp"
+
+LocalSearch::LocalSearch(const InputData& inputData, const unsigned nThreads,
+                         const unsigned maxRounds):
+    inputData(inputData), nThreads(nThreads), maxRounds(maxRounds) {
+    if(this->nThreads == 0) {
+        this->nThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+void LocalSearch::findMoves(const RoutePlan& plan, const unsigned carA,
+                            std::vector<Move>& moves) const {
+    const std::vector<unsigned>& ridesA = plan.getRoute(carA).rides;
+    Move best;
+
+    // keeps the better one of the current best move and a given move
+    auto consider = [&best](Move::Type type, int delta, unsigned a, unsigned posA,
+    unsigned b, unsigned posB) {
+        if(delta > best.delta) {
+            best = {type, delta, a, posA, b, posB};
+        }
+    };
+
+    for(unsigned carB = carA + 1; carB < plan.getRouteCount(); ++carB) {
+        const std::vector<unsigned>& ridesB = plan.getRoute(carB).rides;
+        best.delta = 0;
+
+        // relocate rides of carA into carB and swap rides with similar start times
+        for(unsigned i = 0; i < ridesA.size(); ++i) {
+            const unsigned ride = ridesA[i];
+            const unsigned slot = plan.slotOf(carB, inputData.startT(ride));
+            const int removed = plan.removeDelta(carA, i);
+
+            consider(Move::RELOCATE, removed + plan.insertDelta(carB, slot, ride),
+                     carA, i, carB, slot);
+
+            for(unsigned j = slot > 0 ? slot - 1 : 0; j <= slot && j < ridesB.size(); ++j) {
+                consider(Move::SWAP, plan.replaceDelta(carA, i, ridesB[j]) +
+                         plan.replaceDelta(carB, j, ride), carA, i, carB, j);
+            }
+        }
+
+        // relocate rides of carB into carA
+        for(unsigned j = 0; j < ridesB.size(); ++j) {
+            const unsigned ride = ridesB[j];
+            const unsigned slot = plan.slotOf(carA, inputData.startT(ride));
+            consider(Move::RELOCATE, plan.removeDelta(carB, j) +
+                     plan.insertDelta(carA, slot, ride), carB, j, carA, slot);
+        }
+
+        // exchange route tails at similar points in time
+        for(unsigned n = 0; n <= ridesA.size(); ++n) {
+            const unsigned slot = plan.slotOf(carB, plan.stateAfter(carA, n).t);
+
+            for(unsigned m = slot > 0 ? slot - 1 : 0; m <= slot; ++m) {
+                consider(Move::EXCHANGE, plan.exchangeDelta(carA, n, carB, m), carA, n, carB, m);
+            }
+        }
+
+        if(best.delta > 0) {
+            moves.push_back(best);
+        }
+    }
+
+    // insert unassigned rides into carA
+    best.delta = 0;
+
+    for(unsigned ride : plan.getUnassigned()) {
+        const unsigned slot = plan.slotOf(carA, inputData.startT(ride));
+
+        for(unsigned pos = slot > 0 ? slot - 1 : 0; pos <= slot; ++pos) {
+            consider(Move::INSERT, plan.insertDelta(carA, pos, ride), carA, pos, carA, ride);
+        }
+    }
+
+    if(best.delta > 0) {
+        moves.push_back(best);
+    }
+}
+
+bool LocalSearch::apply(RoutePlan& plan, const Move& move) const {
+    const unsigned carA = move.carA, carB = move.carB;
+    const std::vector<unsigned> oldA = plan.getRoute(carA).rides;
+    const std::vector<unsigned> oldB = plan.getRoute(carB).rides;
+    const long oldScore = plan.getScore();
+
+    switch(move.type) {
+    case Move::RELOCATE:
+        plan.relocate(carA, move.posA, carB, move.posB);
+        break;
+
+    case Move::SWAP:
+        plan.swap(carA, move.posA, carB, move.posB);
+        break;
+
+    case Move::EXCHANGE:
+        plan.exchange(carA, move.posA, carB, move.posB);
+        break;
+
+    case Move::INSERT:
+        plan.insert(carA, move.posA, move.posB);
+        break;
+    }
+
+    // estimated deltas are lower bounds, this only protects against invalid estimates
+    if(plan.getScore() <= oldScore) {
+        if(move.type == Move::INSERT) {
+            plan.remove(carA, move.posA);
+        }
+
+        plan.setRides(carA, oldA);
+        plan.setRides(carB, oldB);
+        return false;
+    }
+
+    return true;
+}
+
+unsigned LocalSearch::run(RoutePlan& plan, const Deadline& deadline,
+                          const double reserve) const {
+    const unsigned nCars = plan.getRouteCount();
+    unsigned nApplied = 0;
+
+    for(unsigned round = 0; round < maxRounds && !deadline.expired(reserve); ++round) {
+        std::vector<std::vector<Move>> threadMoves(nThreads);
+        std::vector<std::thread> threads;
+
+        // evaluate car pairs in parallel (every thread owns a subset of first cars)
+        for(unsigned t = 0; t < nThreads; ++t) {
+            threads.emplace_back([this, &plan, &threadMoves, t, nCars]() {
+                for(unsigned carA = t; carA < nCars; carA += nThreads) {
+                    findMoves(plan, carA, threadMoves[t]);
+                }
+            });
+        }
+
+        for(auto& thread : threads) {
+            thread.join();
+        }
+
+        std::vector<Move> moves;
+
+        for(const auto& found : threadMoves) {
+            moves.insert(moves.end(), found.begin(), found.end());
+        }
+
+        // best moves first, order is independent of the number of threads
+        std::sort(moves.begin(), moves.end(), [](const Move& lhs, const Move& rhs) {
+            if(lhs.delta != rhs.delta) {
+                return lhs.delta > rhs.delta;
+            }
+
+            return std::tie(lhs.carA, lhs.carB, lhs.type, lhs.posA, lhs.posB) <
+                   std::tie(rhs.carA, rhs.carB, rhs.type, rhs.posA, rhs.posB);
+        });
+
+        // apply all moves that don't touch routes or rides changed in this round
+        std::vector<bool> touchedCars(nCars, false);
+        std::vector<bool> insertedRides(inputData.nRides, false);
+        unsigned nRoundApplied = 0;
+
+        for(const Move& move : moves) {
+            if(touchedCars[move.carA] || touchedCars[move.carB] ||
+               (move.type == Move::INSERT && insertedRides[move.posB])) {
+                continue;
+            }
+
+            if(apply(plan, move)) {
+                touchedCars[move.carA] = true;
+                touchedCars[move.carB] = true;
+
+                if(move.type == Move::INSERT) {
+                    insertedRides[move.posB] = true;
+                }
+
+                ++nRoundApplied;
+            }
+        }
+
+        nApplied += nRoundApplied;
+
+        if(nRoundApplied == 0) {
+            break;
+        }
+    }
+
+    return nApplied;
+}
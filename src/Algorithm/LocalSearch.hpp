@@ -0,0 +1,92 @@
+#ifndef LOCAL_SEARCH_H
+#define LOCAL_SEARCH_H
+
+#include <vector>
+#include "InputData.hpp"
+#include "RoutePlan.hpp"
+#include "Deadline.hpp"
+
+/**
+ * Post-optimization of the routes found by Algorithm.
+ * Repeatedly searches improving moves between all pairs of car routes and applies them:
+ * - relocate: move a ride from one route into another one
+ * - swap: exchange two rides of different routes
+ * - exchange: two routes swap their remaining rides after a point in time (2-opt like)
+ * - insert: add an unassigned ride to a route
+ *
+ * Moves are evaluated in constant time using the prefix arrays of RoutePlan.
+ * The evaluation of car pairs is distributed among multiple threads.
+ */
+class LocalSearch {
+public:
+
+    /**
+     * Creates a local search.
+     *
+     * \param [in] inputData InputData representing the simulation enviroment
+     * \param [in] nThreads number of threads used to evaluate moves (0: one per core)
+     * \param [in] maxRounds maximum number of search rounds
+     */
+    LocalSearch(const InputData& inputData, const unsigned nThreads = 0,
+                const unsigned maxRounds = 100);
+
+    /**
+     * Improves the routes until no improving move is left, LocalSearch#maxRounds is reached
+     * or the deadline expired.
+     *
+     * \param [in,out] plan routes to improve (stays valid, score never decreases)
+     * \param [in] deadline no new search round is started after this deadline expired
+     * \param [in] reserve seconds before the deadline at which the search stops
+     * \return unsigned number of applied moves
+     */
+    unsigned run(RoutePlan& plan, const Deadline& deadline = Deadline(),
+                 const double reserve = 0) const;
+
+private:
+
+    /** Change of one or two routes. */
+    struct Move {
+        /** Kind of change. */
+        enum Type { RELOCATE, SWAP, EXCHANGE, INSERT } type;
+        /** Estimated change of points (lower bound). */
+        int delta;
+        /** First route. */
+        unsigned carA;
+        /** Position in the first route. */
+        unsigned posA;
+        /** Second route (unused for Move::INSERT). */
+        unsigned carB;
+        /** Position in the second route or the inserted ride (Move::INSERT). */
+        unsigned posB;
+    };
+
+    /**
+     * Finds the best improving move of every route pair (carA, carB > carA)
+     * and the best insertion of an unassigned ride into carA.
+     *
+     * \param [in] plan current routes
+     * \param [in] carA first route of all pairs
+     * \param [out] moves list the found moves are added to
+     */
+    void findMoves(const RoutePlan& plan, const unsigned carA, std::vector<Move>& moves) const;
+
+    /**
+     * Applies a move if it improves the exact score.
+     *
+     * \param [in,out] plan routes to change
+     * \param [in] move change to apply
+     * \return bool true if the move has been applied
+     */
+    bool apply(RoutePlan& plan, const Move& move) const;
+
+    /** InputData representing the simulation enviroment. */
+    const InputData& inputData;
+
+    /** Number of threads used to evaluate moves. */
+    unsigned nThreads;
+
+    /** Maximum number of search rounds. */
+    const unsigned maxRounds;
+};
+
+#endif // LOCAL_SEARCH_H
@@ -0,0 +1,101 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Tensor.hpp"
+#include "RLAPSolverJV.hpp"
+#include "JVKernels.hpp"
+
+/**
+ * Solves random score matrices with RLAPSolverJV using every supported instruction set of
+ * JVKernels and prints the solve times.
+ *
+ * \code
+ * RLAPBenchmark [<columns>...]
+ * \endcode
+ *
+ * Matrices have one row per ten columns (cars and candidate rides of Generator), scores are
+ * uniformly distributed in [0, 10000).
+ */
+int main(int argc, char *argv[]) {
+    std::vector<unsigned> widths;
+
+    for(int i = 1; i < argc; ++i) {
+        unsigned width = 0;
+        std::istringstream(argv[i]) >> width;
+
+        if(width < 10) {
+            std::cerr << "Usage: RLAPBenchmark [<columns>...] (at least 10 columns)" << std::endl;
+            return 1;
+        }
+
+        widths.push_back(width);
+    }
+
+    if(widths.empty()) {widths = {1000, 2000, 5000, 10000};}
+
+    std::vector<JVKernels::Isa> isas;
+
+    for(const JVKernels::Isa isa : {JVKernels::Isa::scalar, JVKernels::Isa::avx2,
+                                    JVKernels::Isa::avx512
+                                   }) {
+        if(JVKernels::supported(isa)) {isas.push_back(isa);}
+    }
+
+    std::cout << std::left << std::setw(16) << "Matrix";
+
+    for(const JVKernels::Isa isa : isas) {
+        std::cout << std::setw(12) << JVKernels::name(isa) + " [s]";
+    }
+
+    std::cout << "Score" << std::endl;
+    std::mt19937 random(1);
+    RLAPSolverJV solver;
+
+    for(const unsigned width : widths) {
+        const unsigned rows = width / 10;
+        Tensor<int> scores({rows, width});
+        std::uniform_int_distribution<int> score(0, 9999);
+
+        for(unsigned row = 0; row < rows; ++row) {
+            for(unsigned col = 0; col < width; ++col) {
+                scores(row, col) = score(random);
+            }
+        }
+
+        std::cout << std::setw(16) << std::to_string(rows) + " x " + std::to_string(width);
+        long previous = -1;
+
+        for(const JVKernels::Isa isa : isas) {
+            JVKernels::use(isa);
+            Tensor<unsigned> assignments({rows, 2});
+            const auto start = std::chrono::steady_clock::now();
+            solver.solve(scores, RLAPSolver::Objective::maximize, assignments);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                   - start).count();
+            long sum = 0;
+
+            for(unsigned i = 0; i < rows; ++i) {
+                sum += scores(assignments(i, 0), assignments(i, 1));
+            }
+
+            std::cout << std::setw(12) << std::fixed << std::setprecision(3) << seconds;
+
+            // all instruction sets have to find the same optimum
+            if(previous >= 0 && sum != previous) {
+                std::cout << std::endl << "Different scores: " << previous << " and " << sum
+                          << std::endl;
+                return 1;
+            }
+
+            previous = sum;
+        }
+
+        std::cout << previous << std::endl;
+    }
+
+    return 0;
+}
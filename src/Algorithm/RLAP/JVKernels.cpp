@@ -0,0 +1,404 @@
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+#include "JVKernels.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define JV_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+/** Larger than any distance, marks columns excluded from the search. */
+static constexpr double INF = std::numeric_limits<double>::infinity();
+
+/**
+ * Checks if a candidate comes before another one (smaller value or same value, lower column).
+ *
+ * \param [in] value value of the candidate
+ * \param [in] index column of the candidate
+ * \param [in] otherValue value of the other candidate
+ * \param [in] otherIndex column of the other candidate
+ * \return bool true if the candidate comes first
+ */
+static inline bool before(const double value, const unsigned index, const double otherValue,
+                          const unsigned otherIndex) {
+    return value < otherValue || (value == otherValue && index < otherIndex);
+}
+
+/**
+ * Inserts a candidate into the two smallest candidates found so far.
+ *
+ * \param [in] value value of the candidate
+ * \param [in] index column of the candidate
+ * \param [in,out] result two smallest candidates
+ */
+static inline void insert(const double value, const unsigned index, JVKernels::MinTwo& result) {
+    if(before(value, index, result.min, result.index)) {
+        result.second = result.min;
+        result.secondIndex = result.index;
+        result.min = value;
+        result.index = index;
+    } else if(before(value, index, result.second, result.secondIndex)) {
+        result.second = value;
+        result.secondIndex = index;
+    }
+}
+
+/**
+ * Scalar part of JVKernels::minTwo, also processes the columns behind the vectorized ones.
+ *
+ * \param [in] cost cost row
+ * \param [in] v column reduction numbers
+ * \param [in] begin first column
+ * \param [in] n number of columns
+ * \param [in,out] result two smallest candidates
+ */
+static void minTwoScalar(const double* cost, const double* v, const unsigned begin,
+                         const unsigned n, JVKernels::MinTwo& result) {
+    // columns increase, strict comparisons keep the lowest column of equal values
+    for(unsigned j = begin; j < n; ++j) {
+        const double h = cost[j] - v[j];
+
+        if(h < result.second) {
+            if(h < result.min) {
+                result.second = result.min;
+                result.secondIndex = result.index;
+                result.min = h;
+                result.index = j;
+            } else {
+                result.second = h;
+                result.secondIndex = j;
+            }
+        }
+    }
+}
+
+/**
+ * Scalar part of JVKernels::relax, also processes the columns behind the vectorized ones.
+ *
+ * \param [in] cost cost row of the row
+ * \param [in] w column reduction numbers
+ * \param [in] h reduced cost of the path to the row
+ * \param [in] row index of the row
+ * \param [in,out] d distances of all columns
+ * \param [in,out] pred predecessor row of all columns
+ * \param [in] begin first column
+ * \param [in] n number of columns
+ * \param [in,out] min minimal distance
+ * \param [in,out] argmin lowest column with the minimal distance
+ */
+static void relaxScalar(const double* cost, const double* w, const double h, const int row,
+                        double* d, int* pred, const unsigned begin, const unsigned n,
+                        double& min, unsigned& argmin) {
+    for(unsigned j = begin; j < n; ++j) {
+        const double distance = cost[j] - w[j] - h;
+
+        if(distance < d[j]) {
+            d[j] = distance;
+            pred[j] = row;
+        }
+
+        if(d[j] < min) {
+            min = d[j];
+            argmin = j;
+        }
+    }
+}
+
+#ifdef JV_KERNELS_X86
+
+/**
+ * Merges the per-lane results of the vectorized JVKernels::minTwo.
+ *
+ * \param [in] mins minimum of each lane
+ * \param [in] indices column of the minimum of each lane
+ * \param [in] seconds second minimum of each lane
+ * \param [in] secondIndices column of the second minimum of each lane
+ * \param [in] lanes number of lanes
+ * \return JVKernels::MinTwo two smallest candidates of all lanes
+ */
+static JVKernels::MinTwo mergeLanes(const double* mins, const double* indices,
+                                    const double* seconds, const double* secondIndices,
+                                    const unsigned lanes) {
+    JVKernels::MinTwo result = {INF, 0, INF, 0};
+
+    for(unsigned lane = 0; lane < lanes; ++lane) {
+        insert(mins[lane], static_cast<unsigned>(indices[lane]), result);
+        insert(seconds[lane], static_cast<unsigned>(secondIndices[lane]), result);
+    }
+
+    return result;
+}
+
+__attribute__((target("avx2")))
+static JVKernels::MinTwo minTwoAvx2(const double* cost, const double* v, const unsigned n) {
+    __m256d min = _mm256_set1_pd(INF);
+    __m256d second = min;
+    __m256d index = _mm256_setzero_pd();
+    __m256d secondIndex = index;
+    __m256d column = _mm256_set_pd(3, 2, 1, 0);
+    const __m256d step = _mm256_set1_pd(4);
+    unsigned j = 0;
+
+    for(; j + 4 <= n; j += 4) {
+        const __m256d h = _mm256_sub_pd(_mm256_loadu_pd(cost + j), _mm256_loadu_pd(v + j));
+        const __m256d isMin = _mm256_cmp_pd(h, min, _CMP_LT_OQ);
+        const __m256d isSecond = _mm256_cmp_pd(h, second, _CMP_LT_OQ);
+        second = _mm256_blendv_pd(_mm256_blendv_pd(second, h, isSecond), min, isMin);
+        secondIndex = _mm256_blendv_pd(_mm256_blendv_pd(secondIndex, column, isSecond), index,
+                                       isMin);
+        min = _mm256_blendv_pd(min, h, isMin);
+        index = _mm256_blendv_pd(index, column, isMin);
+        column = _mm256_add_pd(column, step);
+    }
+
+    alignas(32) double lanes[4][4];
+    _mm256_store_pd(lanes[0], min);
+    _mm256_store_pd(lanes[1], index);
+    _mm256_store_pd(lanes[2], second);
+    _mm256_store_pd(lanes[3], secondIndex);
+    JVKernels::MinTwo result = mergeLanes(lanes[0], lanes[1], lanes[2], lanes[3], 4);
+    minTwoScalar(cost, v, j, n, result);
+    return result;
+}
+
+__attribute__((target("avx2")))
+static double relaxAvx2(const double* cost, const double* w, const double h, const int row,
+                        double* d, int* pred, const unsigned n, unsigned& argmin) {
+    const __m256d path = _mm256_set1_pd(h);
+    __m256d min = _mm256_set1_pd(INF);
+    __m256d index = _mm256_setzero_pd();
+    __m256d column = _mm256_set_pd(3, 2, 1, 0);
+    const __m256d step = _mm256_set1_pd(4);
+    unsigned j = 0;
+
+    for(; j + 4 <= n; j += 4) {
+        const __m256d distance = _mm256_sub_pd(_mm256_sub_pd(_mm256_loadu_pd(cost + j),
+                                               _mm256_loadu_pd(w + j)), path);
+        __m256d current = _mm256_loadu_pd(d + j);
+        const __m256d shorter = _mm256_cmp_pd(distance, current, _CMP_LT_OQ);
+        const int mask = _mm256_movemask_pd(shorter);
+
+        // after the first rows only few distances get shorter
+        if(mask) {
+            current = _mm256_blendv_pd(current, distance, shorter);
+            _mm256_storeu_pd(d + j, current);
+
+            for(unsigned lane = 0; lane < 4; ++lane) {
+                if(mask & (1 << lane)) {pred[j + lane] = row;}
+            }
+        }
+
+        const __m256d isMin = _mm256_cmp_pd(current, min, _CMP_LT_OQ);
+        min = _mm256_blendv_pd(min, current, isMin);
+        index = _mm256_blendv_pd(index, column, isMin);
+        column = _mm256_add_pd(column, step);
+    }
+
+    alignas(32) double mins[4];
+    alignas(32) double indices[4];
+    _mm256_store_pd(mins, min);
+    _mm256_store_pd(indices, index);
+    double result = INF;
+    argmin = 0;
+
+    for(unsigned lane = 0; lane < 4; ++lane) {
+        if(before(mins[lane], static_cast<unsigned>(indices[lane]), result, argmin)) {
+            result = mins[lane];
+            argmin = static_cast<unsigned>(indices[lane]);
+        }
+    }
+
+    relaxScalar(cost, w, h, row, d, pred, j, n, result, argmin);
+    return result;
+}
+
+__attribute__((target("avx512f")))
+static JVKernels::MinTwo minTwoAvx512(const double* cost, const double* v, const unsigned n) {
+    __m512d min = _mm512_set1_pd(INF);
+    __m512d second = min;
+    __m512d index = _mm512_setzero_pd();
+    __m512d secondIndex = index;
+    __m512d column = _mm512_set_pd(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m512d step = _mm512_set1_pd(8);
+    unsigned j = 0;
+
+    for(; j + 8 <= n; j += 8) {
+        const __m512d h = _mm512_sub_pd(_mm512_loadu_pd(cost + j), _mm512_loadu_pd(v + j));
+        const __mmask8 isMin = _mm512_cmp_pd_mask(h, min, _CMP_LT_OQ);
+        const __mmask8 isSecond = _mm512_cmp_pd_mask(h, second, _CMP_LT_OQ);
+        second = _mm512_mask_blend_pd(isMin, _mm512_mask_blend_pd(isSecond, second, h), min);
+        secondIndex = _mm512_mask_blend_pd(isMin, _mm512_mask_blend_pd(isSecond, secondIndex,
+                                           column), index);
+        min = _mm512_mask_blend_pd(isMin, min, h);
+        index = _mm512_mask_blend_pd(isMin, index, column);
+        column = _mm512_add_pd(column, step);
+    }
+
+    alignas(64) double lanes[4][8];
+    _mm512_store_pd(lanes[0], min);
+    _mm512_store_pd(lanes[1], index);
+    _mm512_store_pd(lanes[2], second);
+    _mm512_store_pd(lanes[3], secondIndex);
+    JVKernels::MinTwo result = mergeLanes(lanes[0], lanes[1], lanes[2], lanes[3], 8);
+    minTwoScalar(cost, v, j, n, result);
+    return result;
+}
+
+__attribute__((target("avx512f")))
+static double relaxAvx512(const double* cost, const double* w, const double h, const int row,
+                          double* d, int* pred, const unsigned n, unsigned& argmin) {
+    const __m512d path = _mm512_set1_pd(h);
+    __m512d min = _mm512_set1_pd(INF);
+    __m512d index = _mm512_setzero_pd();
+    __m512d column = _mm512_set_pd(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m512d step = _mm512_set1_pd(8);
+    unsigned j = 0;
+
+    for(; j + 8 <= n; j += 8) {
+        const __m512d distance = _mm512_sub_pd(_mm512_sub_pd(_mm512_loadu_pd(cost + j),
+                                               _mm512_loadu_pd(w + j)), path);
+        __m512d current = _mm512_loadu_pd(d + j);
+        const __mmask8 shorter = _mm512_cmp_pd_mask(distance, current, _CMP_LT_OQ);
+
+        // after the first rows only few distances get shorter
+        if(shorter) {
+            current = _mm512_mask_blend_pd(shorter, current, distance);
+            _mm512_storeu_pd(d + j, current);
+
+            for(unsigned lane = 0; lane < 8; ++lane) {
+                if(shorter & (1 << lane)) {pred[j + lane] = row;}
+            }
+        }
+
+        const __mmask8 isMin = _mm512_cmp_pd_mask(current, min, _CMP_LT_OQ);
+        min = _mm512_mask_blend_pd(isMin, min, current);
+        index = _mm512_mask_blend_pd(isMin, index, column);
+        column = _mm512_add_pd(column, step);
+    }
+
+    alignas(64) double mins[8];
+    alignas(64) double indices[8];
+    _mm512_store_pd(mins, min);
+    _mm512_store_pd(indices, index);
+    double result = INF;
+    argmin = 0;
+
+    for(unsigned lane = 0; lane < 8; ++lane) {
+        if(before(mins[lane], static_cast<unsigned>(indices[lane]), result, argmin)) {
+            result = mins[lane];
+            argmin = static_cast<unsigned>(indices[lane]);
+        }
+    }
+
+    relaxScalar(cost, w, h, row, d, pred, j, n, result, argmin);
+    return result;
+}
+
+#endif // JV_KERNELS_X86
+
+/**
+ * Best instruction set supported by the CPU.
+ *
+ * \return JVKernels::Isa instruction set
+ */
+static JVKernels::Isa detect() {
+    if(JVKernels::supported(JVKernels::Isa::avx512)) {return JVKernels::Isa::avx512;}
+
+    if(JVKernels::supported(JVKernels::Isa::avx2)) {return JVKernels::Isa::avx2;}
+
+    return JVKernels::Isa::scalar;
+}
+
+/** Selected instruction set. */
+static std::atomic<JVKernels::Isa> selected(detect());
+
+JVKernels::MinTwo JVKernels::minTwo(const double* cost, const double* v, const unsigned n,
+                                    const double big) {
+    MinTwo result = {INF, 0, INF, 0};
+
+    switch(selected.load(std::memory_order_relaxed)) {
+#ifdef JV_KERNELS_X86
+
+    case Isa::avx512:
+        result = minTwoAvx512(cost, v, n);
+        break;
+
+    case Isa::avx2:
+        result = minTwoAvx2(cost, v, n);
+        break;
+#endif
+
+    default:
+        minTwoScalar(cost, v, 0, n, result);
+    }
+
+    if(!(result.second < big)) {result.second = big;}
+
+    return result;
+}
+
+double JVKernels::relax(const double* cost, const double* w, const double h, const int row,
+                        double* d, int* pred, const unsigned n, unsigned& argmin) {
+    switch(selected.load(std::memory_order_relaxed)) {
+#ifdef JV_KERNELS_X86
+
+    case Isa::avx512:
+        return relaxAvx512(cost, w, h, row, d, pred, n, argmin);
+
+    case Isa::avx2:
+        return relaxAvx2(cost, w, h, row, d, pred, n, argmin);
+#endif
+
+    default:
+        double min = INF;
+        argmin = 0;
+        relaxScalar(cost, w, h, row, d, pred, 0, n, min, argmin);
+        return min;
+    }
+}
+
+bool JVKernels::supported(const Isa isa) {
+#ifdef JV_KERNELS_X86
+    __builtin_cpu_init();
+
+    switch(isa) {
+    case Isa::avx512:
+        return __builtin_cpu_supports("avx512f");
+
+    case Isa::avx2:
+        return __builtin_cpu_supports("avx2");
+
+    default:
+        return true;
+    }
+
+#else
+    return isa == Isa::scalar;
+#endif
+}
+
+void JVKernels::use(const Isa isa) {
+    if(!supported(isa)) {
+        throw std::invalid_argument("Instruction set not supported: " + name(isa));
+    }
+
+    selected.store(isa);
+}
+
+JVKernels::Isa JVKernels::current() {
+    return selected.load();
+}
+
+std::string JVKernels::name(const Isa isa) {
+    switch(isa) {
+    case Isa::avx512:
+        return "avx512";
+
+    case Isa::avx2:
+        return "avx2";
+
+    default:
+        return "scalar";
+    }
+}
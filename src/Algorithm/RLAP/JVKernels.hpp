@@ -0,0 +1,93 @@
+#ifndef JV_KERNELS_H
+#define JV_KERNELS_H
+
+#include <string>
+
+/**
+ * Vectorized inner loops of RLAPSolverJV over contiguous cost rows.
+ *
+ * Every kernel is compiled for AVX-512, AVX2 and plain scalar code; the best instruction set
+ * supported by the CPU is selected at runtime. All variants compute exactly the same results
+ * (same operations in the same order per element, ties are broken by the lowest column).
+ */
+class JVKernels {
+public:
+
+    /** Instruction sets of the kernels. */
+    enum class Isa {scalar, avx2, avx512};
+
+    /** Minimum and second minimum of the reduced costs of a row. */
+    struct MinTwo {
+        /** Minimal reduced cost. */
+        double min;
+        /** Lowest column with the minimal reduced cost. */
+        unsigned index;
+        /** Second smallest reduced cost (equal to min if it occurs twice, at most BIG). */
+        double second;
+        /** Column of the second smallest reduced cost. */
+        unsigned secondIndex;
+    };
+
+    /**
+     * Finds the minimum and second minimum of cost[j] - v[j].
+     *
+     * \param [in] cost cost row
+     * \param [in] v column reduction numbers
+     * \param [in] n number of columns
+     * \param [in] big value of MinTwo#second if there is no second column
+     * \return MinTwo minimum, second minimum and their columns
+     */
+    static MinTwo minTwo(const double* cost, const double* v, const unsigned n,
+                         const double big);
+
+    /**
+     * Relaxes the distances of all columns via a row and returns the new minimum distance.
+     * Sets d[j] = cost[j] - w[j] - h and pred[j] = row if this is smaller than d[j].
+     * Columns excluded from the search need w[j] = -infinity and d[j] = infinity.
+     *
+     * \param [in] cost cost row of the row
+     * \param [in] w column reduction numbers (-infinity for excluded columns)
+     * \param [in] h reduced cost of the path to the row
+     * \param [in] row index of the row
+     * \param [in,out] d distances of all columns
+     * \param [in,out] pred predecessor row of all columns
+     * \param [in] n number of columns
+     * \param [out] argmin lowest column with the minimal distance
+     * \return double minimal distance
+     */
+    static double relax(const double* cost, const double* w, const double h, const int row,
+                        double* d, int* pred, const unsigned n, unsigned& argmin);
+
+    /**
+     * Checks if the CPU and the compiler support an instruction set.
+     *
+     * \param [in] isa instruction set
+     * \return bool true if the kernels can use it
+     */
+    static bool supported(const Isa isa);
+
+    /**
+     * Selects the instruction set of all kernels (default: the best supported one).
+     *
+     * \param [in] isa instruction set
+     * \throw std::invalid_argument if the instruction set isn't supported
+     */
+    static void use(const Isa isa);
+
+    /**
+     * Instruction set of the kernels.
+     *
+     * \return Isa selected instruction set
+     */
+    static Isa current();
+
+    /**
+     * Name of an instruction set.
+     *
+     * \param [in] isa instruction set
+     * \return std::string name
+     */
+    static std::string name(const Isa isa);
+};
+
+#endif // JV_KERNELS_H
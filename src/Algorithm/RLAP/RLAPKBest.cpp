@@ -0,0 +1,311 @@
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include "RLAPKBest.hpp"
+#include "JVKernels.hpp"
+
+/** Cost of constrained entries and distance of unreachable columns. */
+static constexpr double INF = std::numeric_limits<double>::infinity();
+
+RLAPKBest::RLAPKBest(const unsigned nThreads):
+    nThreads(nThreads > 0 ? nThreads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+void RLAPKBest::constrainedRow(const Node& node, const unsigned row, double* target) const {
+    const double* source = &costMat[static_cast<std::size_t>(row) * size];
+
+    if(row < rows && node.forced[row] >= 0) {
+        std::fill(target, target + size, INF);
+        target[node.forced[row]] = source[node.forced[row]];
+        return;
+    }
+
+    std::copy(source, source + size, target);
+
+    for(const auto& entry : node.excluded) {
+        if(entry.first == row) {target[entry.second] = INF;}
+    }
+}
+
+bool RLAPKBest::solveNode(Node& node, Buffers& buffers) const {
+    std::shared_ptr<State> state = std::make_shared<State>(*node.state);
+    std::vector<int>& rowsol = state->rowsol;
+    std::vector<double>& v = state->v;
+    std::vector<int>& colsol = buffers.colsol;
+    double* row = buffers.row.data();
+
+    for(unsigned i = 0; i < size; ++i) {
+        colsol[rowsol[i]] = i;
+    }
+
+    // the excluded entry of the free row is the only free column
+    const int freeRow = node.freeRow;
+    colsol[rowsol[freeRow]] = -1;
+    rowsol[freeRow] = -1;
+
+    for(unsigned j = 0; j < size; ++j) {
+        buffers.d[j] = INF;
+        buffers.w[j] = v[j];
+    }
+
+    // Dijkstra from the free row like the augmentation of RLAPSolverJV
+    unsigned column;
+    constrainedRow(node, freeRow, row);
+    double min_ = JVKernels::relax(row, buffers.w.data(), 0, freeRow, buffers.d.data(),
+                                   buffers.pred.data(), size, column);
+    unsigned last = 0;
+
+    while(true) {
+        if(!(min_ < INF)) {return false;}
+
+        if(colsol[column] < 0) {break;}
+
+        const unsigned j1 = column;
+        buffers.scanned[last] = j1;
+        buffers.ready[last++] = min_;
+        buffers.d[j1] = INF;
+        buffers.w[j1] = -INF;
+
+        const int i = colsol[j1];
+        constrainedRow(node, i, row);
+        const double h = row[j1] - v[j1] - min_;
+        min_ = JVKernels::relax(row, buffers.w.data(), h, i, buffers.d.data(),
+                                buffers.pred.data(), size, column);
+    }
+
+    // update column prices
+    for(unsigned k = 0; k < last; ++k) {
+        v[buffers.scanned[k]] += buffers.ready[k] - min_;
+    }
+
+    // reset row and column assignments along the alternating path
+    int endofpath = column;
+    int i;
+
+    do {
+        i = buffers.pred[endofpath];
+        colsol[endofpath] = i;
+        const int j1 = endofpath;
+        endofpath = rowsol[i];
+        rowsol[i] = j1;
+    } while(i != freeRow);
+
+    node.bound = 0;
+
+    for(unsigned r = 0; r < rows; ++r) {
+        node.bound += costMat[static_cast<std::size_t>(r) * size + rowsol[r]];
+    }
+
+    node.state = state;
+    node.freeRow = -1;
+    return true;
+}
+
+void RLAPKBest::partition(const Node& node, std::vector<Node>& children) const {
+    const State& state = *node.state;
+    std::vector<double> row(size);
+
+    // lower bound of each subproblem: the smallest reduced cost of its free row
+    std::vector<std::pair<double, unsigned>> increments;
+
+    for(unsigned r = 0; r < rows; ++r) {
+        if(node.forced[r] >= 0) {continue;}
+
+        constrainedRow(node, r, row.data());
+        const int assigned = state.rowsol[r];
+        const double u = row[assigned] - state.v[assigned];
+        double increment = INF;
+
+        for(unsigned j = 0; j < size; ++j) {
+            if(static_cast<int>(j) != assigned) {
+                increment = std::min(increment, row[j] - u - state.v[j]);
+            }
+        }
+
+        increments.emplace_back(increment, r);
+    }
+
+    // the subproblems with the fewest constraints get the largest bounds
+    std::sort(increments.begin(), increments.end(),
+    [](const std::pair<double, unsigned>& a, const std::pair<double, unsigned>& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    });
+
+    std::vector<int> forced = node.forced;
+
+    for(const auto& increment : increments) {
+        const unsigned r = increment.second;
+
+        // a row without another column has no solution without its entry
+        if(increment.first < INF) {
+            Node child{node.state, forced, node.excluded, node.bound + std::max(increment.first, 0.0),
+                       static_cast<int>(r)};
+            child.excluded.emplace_back(r, state.rowsol[r]);
+            children.push_back(std::move(child));
+        }
+
+        forced[r] = state.rowsol[r];
+    }
+}
+
+RLAPKBest::RankedAssignment RLAPKBest::toAssignment(const Node& node,
+        const Tensor<int>& costs) const {
+    std::vector<std::pair<unsigned, unsigned>> entries;
+
+    for(unsigned r = 0; r < rows; ++r) {
+        const unsigned col = node.state->rowsol[r];
+        entries.emplace_back(transposed ? col : r, transposed ? r : col);
+    }
+
+    std::sort(entries.begin(), entries.end());
+    RankedAssignment result{Tensor<unsigned>({rows, 2}), 0};
+
+    for(unsigned i = 0; i < rows; ++i) {
+        result.assignments(i, 0) = entries[i].first;
+        result.assignments(i, 1) = entries[i].second;
+        result.objective += costs(entries[i].first, entries[i].second);
+    }
+
+    return result;
+}
+
+std::vector<RLAPKBest::RankedAssignment> RLAPKBest::solve(const Tensor<int>& costs,
+        const RLAPSolver::Objective objective, const unsigned k) {
+    solvedCount = 0;
+    skippedCount = 0;
+    std::vector<RankedAssignment> result;
+
+    if(costs.getDims().size() != 2 || k == 0) {return result;}
+
+    const unsigned costRows = costs.getDims()[0];
+    const unsigned costCols = costs.getDims()[1];
+    transposed = costRows > costCols;
+    rows = std::min(costRows, costCols);
+    size = std::max(costRows, costCols);
+
+    if(rows == 0) {return result;}
+
+    // minimized square matrix with dummy rows, rows are the smaller dimension
+    const double sign = objective == RLAPSolver::Objective::maximize ? -1 : 1;
+    Tensor<int> matrix({rows, size});
+    costMat.assign(static_cast<std::size_t>(size) * size, 0);
+
+    for(unsigned r = 0; r < rows; ++r) {
+        for(unsigned col = 0; col < size; ++col) {
+            matrix(r, col) = transposed ? costs(col, r) : costs(r, col);
+            costMat[static_cast<std::size_t>(r) * size + col] = sign * matrix(r, col);
+        }
+    }
+
+    // best solution, dummy rows take the unassigned columns (their duals are the largest)
+    Tensor<unsigned> assignments({rows, 2});
+    rootSolver.solve(matrix, objective, assignments);
+    std::shared_ptr<State> rootState = std::make_shared<State>();
+    rootState->rowsol.assign(size, -1);
+    rootState->v.assign(rootSolver.getColumnDuals().begin(),
+                        rootSolver.getColumnDuals().begin() + size);
+    std::vector<char> used(size, 0);
+    double rootCost = 0;
+
+    for(unsigned i = 0; i < rows; ++i) {
+        rootState->rowsol[assignments(i, 0)] = assignments(i, 1);
+        used[assignments(i, 1)] = 1;
+        rootCost += costMat[static_cast<std::size_t>(assignments(i, 0)) * size +
+                            assignments(i, 1)];
+    }
+
+    for(unsigned r = rows, col = 0; r < size; ++r, ++col) {
+        while(used[col]) {++col;}
+
+        rootState->rowsol[r] = col;
+    }
+
+    // min-heap of the nodes, solved nodes come first if the bounds are equal
+    auto later = [](const std::unique_ptr<Node>& a, const std::unique_ptr<Node>& b) {
+        return a->bound > b->bound || (a->bound == b->bound && a->freeRow > b->freeRow);
+    };
+    std::vector<std::unique_ptr<Node>> heap;
+    heap.emplace_back(new Node{rootState, std::vector<int>(rows, -1), {}, rootCost, -1});
+
+    std::vector<Buffers> buffers(nThreads);
+
+    for(Buffers& buffer : buffers) {
+        for(std::vector<double>* values : {&buffer.row, &buffer.d, &buffer.w, &buffer.ready}) {
+            values->resize(size);
+        }
+
+        for(std::vector<int>* values : {&buffer.pred, &buffer.scanned, &buffer.colsol}) {
+            values->resize(size);
+        }
+    }
+
+    std::vector<Node> children;
+    std::vector<std::unique_ptr<Node>> batch;
+    std::vector<char> feasible;
+
+    while(result.size() < k && !heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+
+        // no other solution is better than a solved node
+        if(heap.back()->freeRow < 0) {
+            std::unique_ptr<Node> node = std::move(heap.back());
+            heap.pop_back();
+            result.push_back(toAssignment(*node, costs));
+
+            if(result.size() == k) {break;}
+
+            children.clear();
+            partition(*node, children);
+
+            for(Node& child : children) {
+                heap.emplace_back(new Node(std::move(child)));
+                std::push_heap(heap.begin(), heap.end(), later);
+            }
+
+            continue;
+        }
+
+        // the most promising subproblems are solved in parallel
+        batch.clear();
+        batch.push_back(std::move(heap.back()));
+        heap.pop_back();
+
+        while(batch.size() < nThreads && !heap.empty() && heap.front()->freeRow >= 0) {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            batch.push_back(std::move(heap.back()));
+            heap.pop_back();
+        }
+
+        feasible.assign(batch.size(), 0);
+        auto work = [&](const unsigned thread) {
+            for(unsigned i = thread; i < batch.size(); i += nThreads) {
+                feasible[i] = solveNode(*batch[i], buffers[thread]);
+            }
+        };
+        std::vector<std::thread> threads;
+
+        for(unsigned thread = 1; thread < std::min<std::size_t>(nThreads, batch.size()); ++thread) {
+            threads.emplace_back(work, thread);
+        }
+
+        work(0);
+
+        for(std::thread& thread : threads) {
+            thread.join();
+        }
+
+        solvedCount += batch.size();
+
+        for(unsigned i = 0; i < batch.size(); ++i) {
+            if(!feasible[i]) {continue;}
+
+            heap.push_back(std::move(batch[i]));
+            std::push_heap(heap.begin(), heap.end(), later);
+        }
+    }
+
+    for(const std::unique_ptr<Node>& node : heap) {
+        if(node->freeRow >= 0) {++skippedCount;}
+    }
+
+    return result;
+}
@@ -0,0 +1,181 @@
+#ifndef RLAP_K_BEST_H
+#define RLAP_K_BEST_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Tensor.hpp"
+#include "RLAPSolver.hpp"
+#include "RLAPSolverJV.hpp"
+
+/**
+ * Enumerates the k best solutions of a rectangular linear assignment problem with
+ * [Murty's algorithm](https://doi.org/10.1287/opre.16.3.682), e.g. to branch over several
+ * good choices of Generator in a search over SearchGraphNode.
+ *
+ * The best solution is found by RLAPSolverJV. The solution space without it is partitioned
+ * into subproblems: the n-th one keeps the first n - 1 assigned entries and excludes the n-th.
+ * A subproblem is solved when it's the most promising one, its best solution is the next one.
+ *
+ * The optimizations of [Miller et al.](https://doi.org/10.1109/7.599256) are used:
+ * - a subproblem inherits the solution and the duals of its parent: only the row of the
+ *   excluded entry is free, one shortest augmenting path (O(n^2)) solves it
+ * - subproblems are ranked by a lower bound (the smallest reduced cost of the free row) and
+ *   only solved when no solution is better than the bound
+ * - the entries are partitioned in the order of decreasing lower bounds, so the subproblems
+ *   with the fewest constraints get the largest bounds
+ *
+ * Subproblems that have to be solved next are solved in parallel.
+ *
+ * \note Matrices with more rows than columns are solved transposed, missing rows are dummy
+ *       rows of cost 0 like in RLAPSolverJV. Solutions only differ in the assigned entries.
+ */
+class RLAPKBest {
+public:
+
+    /** Solution of the RLAP and its objective value. */
+    struct RankedAssignment {
+        /** Assigned entries (row, column) sorted by row, like RLAPSolver::solve writes them. */
+        Tensor<unsigned> assignments;
+        /** Sum of the assigned entries. */
+        long objective;
+    };
+
+    /**
+     * Creates an enumerator.
+     *
+     * \param [in] nThreads number of threads solving subproblems (0: one per core)
+     */
+    RLAPKBest(const unsigned nThreads = 1);
+
+    /**
+     * Finds the k best solutions of a given linear assignment problem.
+     *
+     * \param [in] costs matrix of the problem (only read during the call)
+     * \param [in] objective whether the sum of the assigned entries is minimized or maximized
+     * \param [in] k maximal number of solutions
+     * \return std::vector<RankedAssignment> best solutions, best first (fewer than k if the
+     *         problem has fewer solutions)
+     */
+    std::vector<RankedAssignment> solve(const Tensor<int>& costs,
+                                        const RLAPSolver::Objective objective, const unsigned k);
+
+    /**
+     * Number of subproblems solved by the last call of RLAPKBest::solve.
+     *
+     * \return unsigned long number of solved subproblems
+     */
+    unsigned long getSolvedCount() const {return solvedCount;}
+
+    /**
+     * Number of subproblems created but never solved by the last call of RLAPKBest::solve
+     * because their lower bounds were too large.
+     *
+     * \return unsigned long number of skipped subproblems
+     */
+    unsigned long getSkippedCount() const {return skippedCount;}
+
+private:
+
+    /** Assignment and column duals of a solved (sub)problem, shared by its subproblems. */
+    struct State {
+        /** Column assigned to each row of the square problem. */
+        std::vector<int> rowsol;
+        /** Column duals. */
+        std::vector<double> v;
+    };
+
+    /** Subproblem of Murty's partitioning. */
+    struct Node {
+        /** Solution of the node if solved, of the parent otherwise. */
+        std::shared_ptr<const State> state;
+        /** Column each row is fixed to (-1: free). */
+        std::vector<int> forced;
+        /** Excluded entries (row, column). */
+        std::vector<std::pair<unsigned, unsigned>> excluded;
+        /** Minimized cost if solved, lower bound of it otherwise. */
+        double bound;
+        /** Row that has to be reassigned (-1: solved). */
+        int freeRow;
+    };
+
+    /** Work arrays of one thread solving subproblems. */
+    struct Buffers {
+        /** Cost row with excluded entries set to infinity. */
+        std::vector<double> row;
+        /** 'Cost-distance' of the columns. */
+        std::vector<double> d;
+        /** Column prices, -infinity for scanned columns. */
+        std::vector<double> w;
+        /** Row-predecessor of each column. */
+        std::vector<int> pred;
+        /** Scanned columns. */
+        std::vector<int> scanned;
+        /** 'Cost-distance' of the scanned columns. */
+        std::vector<double> ready;
+        /** Row assigned to each column. */
+        std::vector<int> colsol;
+    };
+
+    /**
+     * Copies the cost row of a row of a subproblem, constrained entries cost infinity.
+     *
+     * \param [in] node subproblem
+     * \param [in] row row of the square problem
+     * \param [out] target cost row
+     */
+    void constrainedRow(const Node& node, const unsigned row, double* target) const;
+
+    /**
+     * Solves a subproblem: reassigns its free row by one shortest augmenting path using the
+     * duals of the parent.
+     *
+     * \param [in,out] node subproblem, solved afterwards
+     * \param [in,out] buffers work arrays of the thread
+     * \return bool false if the subproblem has no solution
+     */
+    bool solveNode(Node& node, Buffers& buffers) const;
+
+    /**
+     * Creates the subproblems of a solved node (not solved yet, ranked by lower bounds).
+     *
+     * \param [in] node solved node
+     * \param [out] children subproblems
+     */
+    void partition(const Node& node, std::vector<Node>& children) const;
+
+    /**
+     * Converts the solution of a node.
+     *
+     * \param [in] node solved node
+     * \param [in] costs matrix of the problem
+     * \return RankedAssignment assigned entries and their sum
+     */
+    RankedAssignment toAssignment(const Node& node, const Tensor<int>& costs) const;
+
+    /** Number of threads solving subproblems. */
+    unsigned nThreads;
+
+    /** Rows of the (transposed) problem. */
+    unsigned rows = 0;
+
+    /** Dimension of the square problem. */
+    unsigned size = 0;
+
+    /** Whether the problem is solved transposed. */
+    bool transposed = false;
+
+    /** Square minimized cost matrix (row-major) with dummy rows. */
+    std::vector<double> costMat;
+
+    /** Solver of the best solution. */
+    RLAPSolverJV rootSolver;
+
+    /** Number of subproblems solved by the last call. */
+    unsigned long solvedCount = 0;
+
+    /** Number of subproblems skipped by the last call. */
+    unsigned long skippedCount = 0;
+};
+
+#endif // RLAP_K_BEST_H
@@ -5,19 +5,28 @@
 
 /**
  * This is an abstract representation of a rectangular linear assignment problem solver.
+ * A solver is a workspace: it keeps its buffers between calls of RLAPSolver::solve and
+ * should be reused for all problems instead of creating one per problem.
  *
  * \note Additional input needed by specific implementations should be in the constructor.
  */
 class RLAPSolver {
 public:
+
+    /** Whether the sum of the assigned entries is minimized or maximized. */
+    enum class Objective {minimize, maximize};
+
+    virtual ~RLAPSolver() {};
+
     /**
      * Writes the solution of a given linear assignment problem to a given Tensor (n rows, 2 columns)
      *
-     * \note Since the required inputs for RLAP solvers differ, they are not specified here
-     *
-     * \param assignments Tensor for the RLAP solution (must have the correct size)
+     * \param [in] costs matrix of the problem (not copied, only read during the call)
+     * \param [in] objective whether the sum of the assigned entries is minimized or maximized
+     * \param [out] assignments Tensor for the RLAP solution (must have the correct size)
      */
-    virtual void solve(Tensor<unsigned>& assignments) = 0;
+    virtual void solve(const Tensor<int>& costs, const Objective objective,
+                       Tensor<unsigned>& assignments) = 0;
 };
 
 #endif // RLAP_SOLVER_H
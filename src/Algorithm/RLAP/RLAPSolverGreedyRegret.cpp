@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <queue>
+#include "RLAPSolverGreedyRegret.hpp"
+
+/** Regret of an agent in the queue of RLAPSolverGreedyRegret::assignByRegret. */
+struct Regret {
+    /** Best minus second best value (maximal if there is no second target). */
+    long regret;
+    /** Best value. */
+    int best;
+    /** Index of the agent. */
+    unsigned agent;
+    /** Version of the regret, outdated entries are skipped. */
+    unsigned version;
+};
+
+/** Order of the regrets: the largest regret, then the largest best value, then the first agent. */
+static bool lessUrgent(const Regret& a, const Regret& b) {
+    if(a.regret != b.regret) {return a.regret < b.regret;}
+
+    if(a.best != b.best) {return a.best < b.best;}
+
+    return a.agent > b.agent;
+}
+
+/** Order of the heap entries: the largest value, then the first target. */
+static bool worse(const std::pair<int, unsigned>& a, const std::pair<int, unsigned>& b) {
+    return a.first < b.first || (a.first == b.first && a.second > b.second);
+}
+
+void RLAPSolverGreedyRegret::solve(const Tensor<int>& costs, const Objective objective,
+                                   Tensor<unsigned>& assignments) {
+    const unsigned rows = costs.getDims().size() == 2 ? costs.getDims()[0] : 0;
+    const unsigned cols = costs.getDims().size() == 2 ? costs.getDims()[1] : 0;
+    transposed = rows > cols;
+    agents = std::min(rows, cols);
+    targets = std::max(rows, cols);
+
+    if(agents == 0) {return;}
+
+    // vectors keep their capacity when resized, buffers only grow with the problem.
+    const std::size_t entries = static_cast<std::size_t>(agents) * targets;
+    values.resize(entries);
+    heaps.resize(entries);
+    heapSizes.resize(agents);
+    best.resize(agents);
+    assigned.resize(agents);
+    owners.resize(targets);
+    watchers.resize(targets);
+    versions.resize(agents);
+    prices.resize(targets);
+
+    // values are maximized, minima are found with inverted values.
+    const int sign = objective == Objective::maximize ? 1 : -1;
+
+    for(unsigned agent = 0; agent < agents; ++agent) {
+        int* valueRow = &values[static_cast<std::size_t>(agent) * targets];
+
+        for(unsigned target = 0; target < targets; ++target) {
+            valueRow[target] = sign * (transposed ? costs(target, agent) : costs(agent, target));
+        }
+    }
+
+    assignByRegret();
+
+    if(auctionBids > 0) {
+        std::vector<unsigned> polished(assigned.begin(), assigned.begin() + agents);
+        auction(polished);
+
+        if(total(polished) > total(assigned)) {
+            std::copy(polished.begin(), polished.end(), assigned.begin());
+        }
+    }
+
+    for(unsigned agent = 0; agent < agents; ++agent) {
+        assignments(agent, 0) = transposed ? assigned[agent] : agent;
+        assignments(agent, 1) = transposed ? agent : assigned[agent];
+    }
+}
+
+void RLAPSolverGreedyRegret::dropTaken(const unsigned agent) {
+    std::pair<int, unsigned>* heap = &heaps[static_cast<std::size_t>(agent) * targets];
+
+    while(heapSizes[agent] > 0 && owners[heap[0].second] >= 0) {
+        std::pop_heap(heap, heap + heapSizes[agent]--, worse);
+    }
+}
+
+void RLAPSolverGreedyRegret::assignByRegret() {
+    std::fill(owners.begin(), owners.begin() + targets, -1);
+    std::fill(versions.begin(), versions.begin() + agents, 0);
+
+    for(unsigned target = 0; target < targets; ++target) {
+        watchers[target].clear();
+    }
+
+    std::priority_queue<Regret, std::vector<Regret>, decltype(&lessUrgent)> queue(lessUrgent);
+
+    // the regret of an agent with a free best target, it watches its best two targets
+    auto pushRegret = [&](const unsigned agent) {
+        const std::pair<int, unsigned>* heap = &heaps[static_cast<std::size_t>(agent) * targets];
+        const int bestValue = value(agent, best[agent]);
+        long regret = std::numeric_limits<long>::max();
+        watchers[best[agent]].push_back(agent);
+
+        if(heapSizes[agent] > 0) {
+            regret = static_cast<long>(bestValue) - heap[0].first;
+            watchers[heap[0].second].push_back(agent);
+        }
+
+        queue.push(Regret{regret, bestValue, agent, ++versions[agent]});
+    };
+
+    for(unsigned agent = 0; agent < agents; ++agent) {
+        std::pair<int, unsigned>* heap = &heaps[static_cast<std::size_t>(agent) * targets];
+
+        for(unsigned target = 0; target < targets; ++target) {
+            heap[target] = std::make_pair(value(agent, target), target);
+        }
+
+        std::make_heap(heap, heap + targets, worse);
+        std::pop_heap(heap, heap + targets, worse);
+        best[agent] = heap[targets - 1].second;
+        heapSizes[agent] = targets - 1;
+        assigned[agent] = targets;
+        pushRegret(agent);
+    }
+
+    // there are at least as many targets as agents, every agent keeps a free best target
+    while(!queue.empty()) {
+        const Regret top = queue.top();
+        queue.pop();
+
+        if(top.version != versions[top.agent] || assigned[top.agent] < targets) {continue;}
+
+        const unsigned target = best[top.agent];
+        assigned[top.agent] = target;
+        owners[target] = top.agent;
+
+        for(const unsigned agent : watchers[target]) {
+            if(assigned[agent] < targets) {continue;}
+
+            std::pair<int, unsigned>* heap = &heaps[static_cast<std::size_t>(agent) * targets];
+            const bool bestTaken = best[agent] == target;
+            const bool secondTaken = heapSizes[agent] > 0 && heap[0].second == target;
+
+            // outdated watchers of the target
+            if(!bestTaken && !secondTaken) {continue;}
+
+            dropTaken(agent);
+
+            if(bestTaken) {
+                best[agent] = heap[0].second;
+                std::pop_heap(heap, heap + heapSizes[agent]--, worse);
+                dropTaken(agent);
+            }
+
+            pushRegret(agent);
+        }
+
+        watchers[target].clear();
+    }
+}
+
+void RLAPSolverGreedyRegret::auction(std::vector<unsigned>& result) {
+    std::fill(prices.begin(), prices.begin() + targets, 0);
+    std::fill(owners.begin(), owners.begin() + targets, -1);
+    std::deque<unsigned> bidders;
+
+    for(unsigned agent = 0; agent < agents; ++agent) {
+        owners[result[agent]] = agent;
+        bidders.push_back(agent);
+    }
+
+    unsigned bids = 0;
+
+    while(bids < auctionBids && !bidders.empty()) {
+        const unsigned agent = bidders.front();
+        bidders.pop_front();
+
+        // best two net values of the agent
+        unsigned target = 0;
+        long first = std::numeric_limits<long>::min();
+        long second = std::numeric_limits<long>::min();
+
+        for(unsigned j = 0; j < targets; ++j) {
+            const long net = value(agent, j) - prices[j];
+
+            if(net > first) {
+                second = first;
+                first = net;
+                target = j;
+            } else if(net > second) {
+                second = net;
+            }
+        }
+
+        // agents within one of their best net value keep their target
+        if(result[agent] < targets && value(agent, result[agent]) - prices[result[agent]] >= first - 1) {
+            continue;
+        }
+
+        prices[target] += (targets > 1 ? first - second : 0) + 1;
+
+        if(owners[target] >= 0) {
+            result[owners[target]] = targets;
+            bidders.push_back(owners[target]);
+        }
+
+        if(result[agent] < targets) {owners[result[agent]] = -1;}
+
+        result[agent] = target;
+        owners[target] = agent;
+        ++bids;
+    }
+
+    // agents outbid at the end take their best free target
+    for(unsigned agent = 0; agent < agents; ++agent) {
+        if(result[agent] < targets) {continue;}
+
+        unsigned target = targets;
+
+        for(unsigned j = 0; j < targets; ++j) {
+            if(owners[j] < 0 && (target == targets || value(agent, j) > value(agent, target))) {
+                target = j;
+            }
+        }
+
+        result[agent] = target;
+        owners[target] = agent;
+    }
+}
+
+long RLAPSolverGreedyRegret::total(const std::vector<unsigned>& result) const {
+    long sum = 0;
+
+    for(unsigned agent = 0; agent < agents; ++agent) {
+        sum += value(agent, result[agent]);
+    }
+
+    return sum;
+}
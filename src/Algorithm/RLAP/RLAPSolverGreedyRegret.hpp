@@ -0,0 +1,120 @@
+#ifndef RLAP_SOLVER_GREEDY_REGRET_H
+#define RLAP_SOLVER_GREEDY_REGRET_H
+
+#include <utility>
+#include <vector>
+#include "Tensor.hpp"
+#include "RLAPSolver.hpp"
+
+/**
+ * Approximate solver of the rectangular linear assignment problem for very wide matrices.
+ *
+ * Every agent (row, or column of a matrix with more rows than columns) keeps a heap of its
+ * entries. The regret of an agent is the difference between its best and second best entry
+ * in a free target, the agent with the largest regret takes its best target first. Agents
+ * watch their best two targets, only their regrets are updated when a target is taken, so a
+ * solve takes O(nnz log n) time.
+ *
+ * The greedy assignment can be polished by a short auction: agents that don't hold their
+ * best target (by value minus price) bid for it, raising its price by the difference of their
+ * best two net values plus one. After the given number of bids, agents without target take
+ * their best free one. The better of both assignments is returned.
+ *
+ * The heaps are kept between calls of RLAPSolverGreedyRegret::solve and only reallocated for a
+ * larger problem, so one solver should be used for many problems.
+ */
+class RLAPSolverGreedyRegret : public RLAPSolver {
+public:
+
+    /**
+     * Creates a solver.
+     *
+     * \param [in] auctionBids maximal number of bids of the auction polish (0: no polish)
+     */
+    RLAPSolverGreedyRegret(const unsigned auctionBids = 0): auctionBids(auctionBids) {};
+
+    void solve(const Tensor<int>& costs, const Objective objective,
+               Tensor<unsigned>& assignments) override;
+
+private:
+
+    /** Maximal number of bids of the auction polish. */
+    unsigned auctionBids;
+
+    /** Number of agents (the smaller dimension). */
+    unsigned agents = 0;
+
+    /** Number of targets (the larger dimension). */
+    unsigned targets = 0;
+
+    /** Whether the agents are the columns of the matrix. */
+    bool transposed = false;
+
+    /** Maximized values (negated costs if minimized) of all agents, row-major. */
+    std::vector<int> values;
+
+    /** Heaps (value, target) of the entries of all agents, one segment of targets each. */
+    std::vector<std::pair<int, unsigned>> heaps;
+
+    /** Number of entries in the heap of each agent. */
+    std::vector<unsigned> heapSizes;
+
+    /** Best free target of each agent (taken out of its heap). */
+    std::vector<unsigned> best;
+
+    /** Target of each agent (RLAPSolverGreedyRegret#targets: none). */
+    std::vector<unsigned> assigned;
+
+    /** Agent of each target (-1: free). */
+    std::vector<int> owners;
+
+    /** Agents watching each target (its best or second best target). */
+    std::vector<std::vector<unsigned>> watchers;
+
+    /** Version of the regret of each agent in the queue. */
+    std::vector<unsigned> versions;
+
+    /** Price of each target in the auction. */
+    std::vector<long> prices;
+
+    /**
+     * Value of an agent taking a target.
+     *
+     * \param [in] agent index of the agent
+     * \param [in] target index of the target
+     * \return int value (maximized)
+     */
+    int value(const unsigned agent, const unsigned target) const {
+        return values[static_cast<std::size_t>(agent) * targets + target];
+    }
+
+    /**
+     * Removes taken targets from the top of the heap of an agent.
+     *
+     * \param [in] agent index of the agent
+     */
+    void dropTaken(const unsigned agent);
+
+    /**
+     * Assigns the agents greedily by regret.
+     */
+    void assignByRegret();
+
+    /**
+     * Improves the assignment by an auction with at most RLAPSolverGreedyRegret#auctionBids
+     * bids, agents left without target take their best free one.
+     *
+     * \param [in,out] result assignment of the agents
+     */
+    void auction(std::vector<unsigned>& result);
+
+    /**
+     * Sum of the values of an assignment.
+     *
+     * \param [in] result target of each agent
+     * \return long sum
+     */
+    long total(const std::vector<unsigned>& result) const;
+};
+
+#endif // RLAP_SOLVER_GREEDY_REGRET_H
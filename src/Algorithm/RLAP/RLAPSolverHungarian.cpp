@@ -1,6 +1,7 @@
 #include <unordered_set>
 #include <numeric>
-#include <stdexcept>
+#include <algorithm>
+#include <limits>
 #include "RLAPSolverHungarian.hpp"
 
 #ifndef NDEBUG
@@ -16,26 +17,47 @@
 #define DBG_PRINT_ZEROS(_)
 #endif
 
-/** Used to determine the solver size needed internally */
-#define MAX_DIM(m) std::max(m.getDims()[0], m.getDims()[1])
-
-RLAPSolverHungarian::RLAPSolverHungarian(const Tensor<int>& mat, const int maxCost):
-    rows(mat.getDims()[0]),
-    cols(mat.getDims()[1]),
-    size(MAX_DIM(mat)),
-    costMat({MAX_DIM(mat), MAX_DIM(mat)}),
-        rowMin({MAX_DIM(mat)}, maxCost),
-        colMin({MAX_DIM(mat)}, maxCost),
-solved(false) {
+void RLAPSolverHungarian::prepare(const Tensor<int>& costs, const Objective objective) {
+    rows = costs.getDims()[0];
+    cols = costs.getDims()[1];
+    size = std::max(rows, cols);
+    costMat.reshape({size, size});
+    rowMin.reshape({size});
+    colMin.reshape({size});
+    zeroCountRows.reshape({size});
+    zeroCountCols.reshape({size});
+    rowLines.reshape({size});
+    colLines.reshape({size});
+    zeroCountRowsFlag.reshape({size});
+    zeroCountColsFlag.reshape({size});
+    zeros.clear();
+
+    // the algorithm needs non-negative entries: maxima are found in the profit matrix
+    // (max - entry), minima in the matrix shifted by its minimum
+    int maxEntry = costs(0, 0);
+    int minEntry = costs(0, 0);
+
+    for(unsigned row = 0; row < rows; ++row) {
+        for(unsigned col = 0; col < cols; ++col) {
+            maxEntry = std::max(maxEntry, costs(row, col));
+            minEntry = std::min(minEntry, costs(row, col));
+        }
+    }
+
+    for(unsigned i = 0; i < size; ++i) {
+        rowMin(i) = std::numeric_limits<int>::max();
+        colMin(i) = std::numeric_limits<int>::max();
+    }
+
     // max cost changes when turning the minimize problem into a maximizing one
     int newMaxCost = 0;
 
-    // turn cost matrix into profit matrix to find maxima
     // also find row and column minima for later use
     for(unsigned row = 0; row < rows; ++row) {
         for(unsigned col = 0; col < cols; ++col) {
             int& entry = costMat(row, col);
-            entry = maxCost - mat(row, col);
+            entry = objective == Objective::maximize ? maxEntry - costs(row, col) :
+                    costs(row, col) - minEntry;
 
             if(rowMin(row) > entry) {
                 rowMin(row) = entry;
@@ -75,8 +97,7 @@ solved(false) {
     }
 }
 
-void RLAPSolverHungarian::reduceRowsAndCols(Tensor<unsigned>& zeroCountRows,
-        Tensor<unsigned>& zeroCountCols) {
+void RLAPSolverHungarian::reduceRowsAndCols() {
     // used for row reduction
     std::unordered_set<unsigned> nonZeroCols;
 
@@ -121,10 +142,7 @@ void RLAPSolverHungarian::reduceRowsAndCols(Tensor<unsigned>& zeroCountRows,
     }
 }
 
-unsigned RLAPSolverHungarian::coverZeros(Tensor<unsigned>& zeroCountRows,
-        Tensor<unsigned>& zeroCountCols, Tensor<bool>& rowLines, Tensor<bool>& colLines) {
-    // stores tracking markers for entries
-    Tensor<bool> zeroCountRowsFlag({size}), zeroCountColsFlag({size});
+unsigned RLAPSolverHungarian::coverZeros() {
     // value that marks entries to be tracked
     bool changedMarker = true;
     // tracked entries have changed
@@ -228,9 +246,7 @@ unsigned RLAPSolverHungarian::coverZeros(Tensor<unsigned>& zeroCountRows,
     return lineCount;
 }
 
-int RLAPSolverHungarian::recalculateCosts(const int minVal,
-        Tensor<unsigned>& zeroCountRows, Tensor<unsigned>& zeroCountCols, Tensor<bool>& rowLines,
-        Tensor<bool>& colLines) {
+int RLAPSolverHungarian::recalculateCosts(const int minVal) {
     int resultMinVal, newMinVal = minVal;
 
     // determine minimum entry (not covered by lines)
@@ -275,8 +291,7 @@ int RLAPSolverHungarian::recalculateCosts(const int minVal,
     return resultMinVal;
 }
 
-void RLAPSolverHungarian::assignMatching(Tensor<unsigned>& assignments,
-        Tensor<unsigned>& zeroCountRows, Tensor<unsigned>& zeroCountCols) {
+void RLAPSolverHungarian::assignMatching(Tensor<unsigned>& assignments) {
     for(const Zero& elm : zeros) {
         ++zeroCountRows(elm.row);
         ++zeroCountCols(elm.col);
@@ -326,23 +341,21 @@ void RLAPSolverHungarian::assignMatching(Tensor<unsigned>& assignments,
     }
 }
 
-void RLAPSolverHungarian::solve(Tensor<unsigned>& assignments) {
-    if(solved) {throw std::runtime_error("RLAP solved already");}
-
-    Tensor<unsigned> zeroCountRows({size}), zeroCountCols({size});
-    Tensor<bool> rowLines({size}), colLines({size});
+void RLAPSolverHungarian::solve(const Tensor<int>& costs, const Objective objective,
+                                Tensor<unsigned>& assignments) {
+    if(costs.getDims().size() != 2) {return;}
 
-    reduceRowsAndCols(zeroCountRows, zeroCountCols);
-    unsigned lineCount = coverZeros(zeroCountRows, zeroCountCols, rowLines, colLines);
+    prepare(costs, objective);
+    reduceRowsAndCols();
+    unsigned lineCount = coverZeros();
 
     int minVal = 0;
 
     while(lineCount < size) {
         zeros.clear();
-        minVal = recalculateCosts(minVal, zeroCountRows, zeroCountCols, rowLines, colLines);
-        lineCount = coverZeros(zeroCountRows, zeroCountCols, rowLines, colLines);
+        minVal = recalculateCosts(minVal);
+        lineCount = coverZeros();
     }
 
-    assignMatching(assignments, zeroCountRows, zeroCountCols);
-    solved = true;
+    assignMatching(assignments);
 }
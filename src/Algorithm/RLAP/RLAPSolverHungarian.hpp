@@ -12,8 +12,8 @@
  */
 class RLAPSolverHungarian : public RLAPSolver {
 public:
-    RLAPSolverHungarian(const Tensor<int>& mat, const int maxCost);
-    void solve(Tensor<unsigned>& assignments) override;
+    void solve(const Tensor<int>& costs, const Objective objective,
+               Tensor<unsigned>& assignments) override;
 private:
     struct Zero {
         unsigned row;
@@ -21,18 +21,17 @@ private:
         bool deleted;
     };
 
-    const unsigned rows, cols, size;
+    unsigned rows = 0, cols = 0, size = 0;
     Tensor<int> costMat, rowMin, colMin;
+    Tensor<unsigned> zeroCountRows, zeroCountCols;
+    Tensor<bool> rowLines, colLines, zeroCountRowsFlag, zeroCountColsFlag;
     std::vector<Zero> zeros;
-    bool solved;
 
-    void reduceRowsAndCols(Tensor<unsigned>& zeroCountRows, Tensor<unsigned>& zeroCountCols);
-    unsigned coverZeros(Tensor<unsigned>& zeroCountRows, Tensor<unsigned>& zeroCountCols,
-                        Tensor<bool>& rowLines, Tensor<bool>& colLines);
-    int recalculateCosts(const int minVal, Tensor<unsigned>& zeroCountRows,
-                         Tensor<unsigned>& zeroCountCols, Tensor<bool>& rowLines, Tensor<bool>& colLines);
-    void assignMatching(Tensor<unsigned>& assignments, Tensor<unsigned>& zeroCountRows,
-                        Tensor<unsigned>& zeroCountCols);
+    void prepare(const Tensor<int>& costs, const Objective objective);
+    void reduceRowsAndCols();
+    unsigned coverZeros();
+    int recalculateCosts(const int minVal);
+    void assignMatching(Tensor<unsigned>& assignments);
 };
 
 #endif // RLAP_SOLVER_HUNGARIAN_H
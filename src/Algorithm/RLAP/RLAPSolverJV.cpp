@@ -1,6 +1,8 @@
 #include <algorithm>
 #include <functional>
+#include <limits>
 #include "RLAPSolverJV.hpp"
+#include "JVKernels.hpp"
 
 #ifndef NDEBUG
 #include <iostream>
@@ -13,9 +15,9 @@
 
 /** Prints contents of a costmat of RLAPSolverJV */
 #define DBG_PRINT_JV_COSTMAT(v) std::cout << "Costmat" << std::endl; \
-	for (unsigned i = 0; i < costMat.size(); i++) { \
-		for (unsigned j = 0; j < costMat[i].size(); j++) { \
-			std::cout << costMat[i][j] << '\t'; \
+	for (unsigned i = 0; i < size; i++) { \
+		for (unsigned j = 0; j < size; j++) { \
+			std::cout << costMat[i * size + j] << '\t'; \
 		} \
 		std::cout << std::endl; \
 	} \
@@ -25,30 +27,43 @@
 #define DBG_PRINT_JV_COSTMAT(_)
 #endif
 
-/** Used to determine the solver size needed internally */
-#define MAX_DIM(m) std::max(m.getDims()[0], m.getDims()[1])
-
-RLAPSolverJV::RLAPSolverJV(const Tensor<int>& mat):
-    rows(mat.getDims()[0]),
-    cols(mat.getDims()[1]),
-    size(MAX_DIM(mat)),
-    costMat(MAX_DIM(mat), std::vector<double>(MAX_DIM(mat), 0)),
-    rowsol(std::vector<int>(size)),
-    colsol(std::vector<int>(size)) {
-    // Fill costMat with inverted mat, since the maximum instead of the minimum value is needed.
-    for(unsigned row = 0; row < rows; ++row) {
-        for(unsigned col = 0; col < cols; ++col) {
-            costMat[row][col] = -mat(row, col);
+bool RLAPSolverJV::solve(const Tensor<int>& costs, const Objective objective,
+                         Tensor<unsigned>& assignments, const Deadline& deadline) {
+    rows = costs.getDims().size() == 2 ? costs.getDims()[0] : 0;
+    cols = costs.getDims().size() == 2 ? costs.getDims()[1] : 0;
+    size = std::max(rows, cols);
+    lossBound = 0;
+
+    if(size == 0) {return true;}
+
+    // vectors keep their capacity when resized, buffers only grow with the problem.
+    costMat.resize(static_cast<std::size_t>(size) * size);
+    rowsol.resize(size);
+    colsol.resize(size);
+    u.resize(size);
+    v.resize(size);
+    freeRows.resize(size);
+    scanned.resize(size);
+    matches.resize(size);
+    pred.resize(size);
+    d.resize(size);
+    w.resize(size);
+    ready.resize(size);
+
+    // costs are minimized, maxima are found with inverted values. dummy entries are 0.
+    const double sign = objective == Objective::maximize ? -1 : 1;
+
+    for(unsigned row = 0; row < size; ++row) {
+        double* costRow = &costMat[static_cast<std::size_t>(row) * size];
+
+        for(unsigned col = 0; col < size; ++col) {
+            costRow[col] = row < rows && col < cols ? sign * costs(row, col) : 0;
         }
     }
-}
-
-void RLAPSolverJV::solve(Tensor<unsigned>& assignments) {
-    std::shared_ptr<std::vector<double>> u(new std::vector<double>(size));
-    std::shared_ptr<std::vector<double>> v(new std::vector<double>(size));
 
-    jvlap(size, costMat, rowsol, colsol, (*u), (*v));
+    const bool optimal = jvlap(size, deadline);
     assignMatching(assignments);
+    return optimal;
 }
 
 void RLAPSolverJV::assignMatching(Tensor<unsigned>& assignments) {
@@ -65,22 +80,62 @@ void RLAPSolverJV::assignMatching(Tensor<unsigned>& assignments) {
     }
 }
 
-void RLAPSolverJV::jvlap(int dim,
-                         const std::vector<std::vector<double>>& assigncost,
-                         std::vector<int>& rowsol,
-                         std::vector<int>& colsol,
-                         std::vector<double>& u,
-                         std::vector<double>& v) {
-    bool unassignedfound;
-    int  i, imin, numfree = 0, prvnumfree, f, i0, k, freerow, *pred, *free_;
-    int  j, j1, j2, endofpath, last, low, up, *collist, *matches;
-    double min_, h, umin, usubmin, v2, *d;
-
-    free_ = new int[dim];       // list of unassigned rows.
-    collist = new int[dim];    // list of columns to be scanned in various ways.
-    matches = new int[dim];    // counts how many times a row could be assigned.
-    d = new double[dim];         // 'cost-distance' in augmenting path calculation.
-    pred = new int[dim];       // row-predecessor of column in augmenting/alternating path.
+void RLAPSolverJV::completeGreedily(const int dim, const int first, const int last) {
+    int* free_ = freeRows.data();
+    int* collist = scanned.data();
+    int numcols = 0;
+
+    for(int j = 0; j < dim; j++)
+        if(colsol[j] < 0)
+        { collist[numcols++] = j; }
+
+    // dummy rows cost the same everywhere, they take the columns left over.
+    const int* dummy = std::stable_partition(free_ + first, free_ + last, [&](const int row) {
+        return row < static_cast<int>(rows);
+    });
+    const unsigned numreal = dummy - (free_ + first);
+
+    if(numreal > 0) {
+        // the free rows of the matrix by regret over the free columns.
+        freeCosts.reshape({numreal, static_cast<unsigned>(numcols)});
+
+        for(unsigned r = 0; r < numreal; r++) {
+            const double* costRow = &costMat[static_cast<std::size_t>(free_[first + r]) * dim];
+
+            for(int k = 0; k < numcols; k++)
+            { freeCosts(r, k) = static_cast<int>(costRow[collist[k]]); }
+        }
+
+        Tensor<unsigned> matching({numreal, 2});
+        completion.solve(freeCosts, Objective::minimize, matching);
+
+        for(unsigned r = 0; r < numreal; r++) {
+            const int i = free_[first + matching(r, 0)];
+            const int j = collist[matching(r, 1)];
+            rowsol[i] = j;
+            colsol[j] = i;
+        }
+    }
+
+    for(int f = first + numreal, k = 0; f < last; f++, k++) {
+        while(colsol[collist[k]] >= 0) {k++;}
+
+        rowsol[free_[f]] = collist[k];
+        colsol[collist[k]] = free_[f];
+    }
+}
+
+bool RLAPSolverJV::jvlap(const int dim, const Deadline& deadline) {
+    int  i, imin, numfree = 0, prvnumfree, f, i0, k, freerow;
+    int  j, j1, j2, endofpath, last;
+    double min_, h, umin, usubmin;
+
+    // work arrays of the workspace (see RLAPSolverJV.hpp).
+    int* free_ = freeRows.data();
+    int* collist = scanned.data();
+    const auto assigncost = [&](const int row) {
+        return costMat.data() + static_cast<std::size_t>(row) * dim;
+    };
 
     // init how many times a row will be assigned in the column reduction.
     for(i = 0; i < dim; i++)
@@ -89,12 +144,12 @@ void RLAPSolverJV::jvlap(int dim,
     // COLUMN REDUCTION
     for(j = dim; j--;) { // reverse order gives better results.
         // find minimum cost over rows.
-        min_ = assigncost[0][j];
+        min_ = assigncost(0)[j];
         imin = 0;
 
         for(i = 1; i < dim; i++)
-            if(assigncost[i][j] < min_) {
-                min_ = assigncost[i][j];
+            if(assigncost(i)[j] < min_) {
+                min_ = assigncost(i)[j];
                 imin = i;
             }
 
@@ -119,12 +174,10 @@ void RLAPSolverJV::jvlap(int dim,
         { free_[numfree++] = i; }
         else if(matches[i] == 1) { // transfer reduction from rows that are assigned once.
             j1 = rowsol[i];
-            min_ = BIG;
-
-            for(j = 0; j < dim; j++)
-                if(j != j1)
-                    if(assigncost[i][j] - v[j] < min_)
-                    { min_ = assigncost[i][j] - v[j]; }
+            const JVKernels::MinTwo reduced = JVKernels::minTwo(assigncost(i), v.data(),
+                                              dim, BIG);
+            // minimum over all columns except j1
+            min_ = static_cast<int>(reduced.index) == j1 ? reduced.second : reduced.min;
 
             v[j1] = v[j1] - min_;
         }
@@ -146,24 +199,12 @@ void RLAPSolverJV::jvlap(int dim,
             k++;
 
             //       find minimum and second minimum reduced cost over columns.
-            umin = assigncost[i][0] - v[0];
-            j1 = 0;
-            usubmin = BIG;
-
-            for(j = 1; j < dim; j++) {
-                h = assigncost[i][j] - v[j];
-
-                if(h < usubmin)
-                    if(h >= umin) {
-                        usubmin = h;
-                        j2 = j;
-                    } else {
-                        usubmin = umin;
-                        umin = h;
-                        j2 = j1;
-                        j1 = j;
-                    }
-            }
+            const JVKernels::MinTwo reduced = JVKernels::minTwo(assigncost(i), v.data(),
+                                              dim, BIG);
+            umin = reduced.min;
+            j1 = reduced.index;
+            usubmin = reduced.second;
+            j2 = reduced.secondIndex;
 
             i0 = colsol[j1];
 
@@ -195,94 +236,59 @@ void RLAPSolverJV::jvlap(int dim,
     } while(loopcnt < 2);        // repeat once.
 
     // AUGMENT SOLUTION for each free row.
-    for(f = 0; f < numfree; f++) {
-        freerow = free_[f];       // start row of augmenting path.
+    // Dijkstra over all columns with vectorized kernels instead of a list of columns:
+    // columns already scanned get d = infinity and w = -infinity, so relaxations skip them.
+    bool optimal = true;
+
+    // rows of the matrix are augmented before dummy rows, which cost the same everywhere.
+    if(deadline.isSet()) {
+        std::stable_partition(free_, free_ + numfree, [&](const int row) {
+            return row < static_cast<int>(rows);
+        });
+    }
 
-        // Dijkstra shortest path algorithm.
-        // runs until unassigned column added to shortest path tree.
-        for(j = dim; j--;) {
-            d[j] = assigncost[freerow][j] - v[j];
-            pred[j] = freerow;
-            collist[j] = j;        // init column list.
+    for(f = 0; f < numfree; f++) {
+        // the remaining free rows are assigned greedily.
+        if(deadline.isSet() && deadline.expired()) {
+            completeGreedily(dim, f, numfree);
+            optimal = false;
+            break;
         }
 
-        low = 0; // columns in 0..low-1 are ready, now none.
-        up = 0;  // columns in low..up-1 are to be scanned for current minimum, now none.
-        // columns in up..dim-1 are to be considered later to find new minimum,
-        // at this stage the list simply contains all columns
-        unassignedfound = false;
+        freerow = free_[f];       // start row of augmenting path.
 
-        do {
-            if(up == low) {        // no more columns to be scanned for current minimum.
-                last = low - 1;
-
-                // scan columns for up..dim-1 to find all indices for which new minimum occurs.
-                // store these indices between low..up-1 (increasing up).
-                min_ = d[collist[up++]];
-
-                for(k = up; k < dim; k++) {
-                    j = collist[k];
-                    h = d[j];
-
-                    if(h <= min_) {
-                        if(h < min_) {    // new minimum.
-                            up = low;      // restart list at index low.
-                            min_ = h;
-                        }
-
-                        // new index with same minimum, put on undex up, and extend list.
-                        collist[k] = collist[up];
-                        collist[up++] = j;
-                    }
-                }
+        for(j = 0; j < dim; j++) {
+            d[j] = std::numeric_limits<double>::infinity();
+            w[j] = v[j];
+        }
 
-                // check if any of the minimum columns happens to be unassigned.
-                // if so, we have an augmenting path right away.
-                for(k = low; k < up; k++)
-                    if(colsol[collist[k]] < 0) {
-                        endofpath = collist[k];
-                        unassignedfound = true;
-                        break;
-                    }
-            }
+        unsigned column;
+        min_ = JVKernels::relax(assigncost(freerow), w.data(), 0, freerow, d.data(), pred.data(),
+                                dim, column);
+        last = 0;
+
+        // runs until an unassigned column is the nearest one.
+        while(colsol[column] >= 0) {
+            // column is ready, remember its distance for the price update.
+            j1 = column;
+            collist[last] = j1;
+            ready[last++] = min_;
+            d[j1] = std::numeric_limits<double>::infinity();
+            w[j1] = -std::numeric_limits<double>::infinity();
+
+            // update 'distances' between freerow and all unscanned columns, via next scanned column.
+            i = colsol[j1];
+            h = assigncost(i)[j1] - v[j1] - min_;
+            min_ = JVKernels::relax(assigncost(i), w.data(), h, i, d.data(), pred.data(),
+                                    dim, column);
+        }
 
-            if(!unassignedfound) {
-                // update 'distances' between freerow and all unscanned columns, via next scanned column.
-                j1 = collist[low];
-                low++;
-                i = colsol[j1];
-                h = assigncost[i][j1] - v[j1] - min_;
-
-                for(k = up; k < dim; k++) {
-                    j = collist[k];
-                    v2 = assigncost[i][j] - v[j] - h;
-
-                    if(v2 < d[j]) {
-                        pred[j] = i;
-
-                        if(v2 == min_)    // new column found at same minimum value
-                            if(colsol[j] < 0) {
-                                // if unassigned, shortest augmenting path is complete.
-                                endofpath = j;
-                                unassignedfound = true;
-                                break;
-                            }
-                        // else add to list to be scanned right away.
-                            else {
-                                collist[k] = collist[up];
-                                collist[up++] = j;
-                            }
-
-                        d[j] = v2;
-                    }
-                }
-            }
-        } while(!unassignedfound);
+        endofpath = column;
 
         // update column prices.
-        for(k = last + 1; k--;) {
+        for(k = 0; k < last; k++) {
             j1 = collist[k];
-            v[j1] = v[j1] + d[j1] - min_;
+            v[j1] = v[j1] + ready[k] - min_;
         }
 
         // reset row and column assignments along the alternating path.
@@ -295,12 +301,44 @@ void RLAPSolverJV::jvlap(int dim,
         } while(i != freerow);
     }
 
-    // free reserved memory.
-    delete[] pred;
-    delete[] free_;
-    delete[] collist;
-    delete[] matches;
-    delete[] d;
-    return;
+    // row duals, the reduced costs of the assigned entries are 0.
+    if(optimal) {
+        for(i = 0; i < dim; i++) {
+            j = rowsol[i];
+            u[i] = assigncost(i)[j] - v[j];
+        }
+
+        return true;
+    }
+
+    // feasible duals of a greedy completion: the row minima of the reduced costs, then
+    // the column minima given them. their bound gives the maximal loss.
+    double dual = 0, primal = 0;
+
+    for(i = 0; i < dim; i++) {
+        u[i] = JVKernels::minTwo(assigncost(i), v.data(), dim, BIG).min;
+    }
+
+    for(j = 0; j < dim; j++) {
+        d[j] = std::numeric_limits<double>::infinity();
+    }
+
+    for(i = 0; i < dim; i++) {
+        const double* costRow = assigncost(i);
+
+        for(j = 0; j < dim; j++) {
+            d[j] = std::min(d[j], costRow[j] - u[i]);
+        }
+
+        primal += costRow[rowsol[i]];
+    }
+
+    for(i = 0; i < dim; i++) {
+        v[i] = d[i];
+        dual += u[i] + v[i];
+    }
+
+    lossBound = std::max(0.0, primal - dual);
+    return false;
 }
 
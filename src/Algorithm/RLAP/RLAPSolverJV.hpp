@@ -1,14 +1,15 @@
 #ifndef RLAP_SOLVER_JV_H
 #define RLAP_SOLVER_JV_H
 
-#include <list>
-#include <unordered_set>
 #include <vector>
 #include <algorithm>
 #include "Tensor.hpp"
 #include "RLAPSolver.hpp"
+#include "RLAPSolverGreedyRegret.hpp"
+#include "Deadline.hpp"
 
-#define BIG 100000
+/** Larger than any reduced cost (scores reach maxTime + points, maxTime can exceed 1e5). */
+#define BIG 1e15
 
 /**
  * Implementation for solving the rectangular linear assignment problem
@@ -17,31 +18,81 @@
  *
  * This implementation is based on [hrldcpr/pyLAPJV](https://github.com/hrldcpr/pyLAPJV),
  * which itself is based on a [C implementation by Roy Jonker](https://web.archive.org/web/20051030203159/http://www.magiclogic.com/assignment/lap_cpp.zip).
+ *
+ * The cost matrix and all work arrays are kept between calls of RLAPSolverJV::solve and
+ * only reallocated for a larger problem, so one solver should be used for many problems.
  */
 class RLAPSolverJV : public RLAPSolver {
 public:
 
+    void solve(const Tensor<int>& costs, const Objective objective,
+               Tensor<unsigned>& assignments) override {
+        solve(costs, objective, assignments, Deadline());
+    }
+
     /**
-    * Constructor for RLAPSolverJV.
-    * \param [in] mat 2D-Matrix of cars and rides with earned points
-    */
-    RLAPSolverJV(const Tensor<int>& mat);
+     * Solves a given linear assignment problem within a deadline. When it expires, no more
+     * rows are augmented: the remaining free rows of the matrix are assigned to the free
+     * columns by RLAPSolverGreedyRegret. The duals are then the row minima and afterwards the
+     * column minima of the reduced costs, so they are feasible and bound the loss (see
+     * RLAPSolverJV::getLossBound).
+     *
+     * \param [in] costs matrix of the problem (not copied, only read during the call)
+     * \param [in] objective whether the sum of the assigned entries is minimized or maximized
+     * \param [out] assignments Tensor for the RLAP solution (must have the correct size)
+     * \param [in] deadline budget of the solve (not set: the solve always finishes)
+     * \return bool true if the solution is optimal, false if the deadline expired
+     */
+    bool solve(const Tensor<int>& costs, const Objective objective,
+               Tensor<unsigned>& assignments, const Deadline& deadline);
+
+    /**
+     * Upper bound of the objective lost by the last RLAP solved, the gap between its
+     * solution and the dual bound (0 if it was solved optimally).
+     *
+     * \return double maximal distance of the objective to the optimal one
+     */
+    double getLossBound() const {return lossBound;}
+
+    /**
+     * Dimension of the largest RLAP solved so far, the buffers are allocated for it.
+     *
+     * \return unsigned number of rows and columns the buffers can hold
+     */
+    unsigned getCapacity() const {return rowsol.capacity();}
+
+    /**
+     * Row duals of the last RLAP solved, including dummy rows (one per missing row of a
+     * matrix with more columns than rows). The duals belong to the minimization problem,
+     * costs of Objective::maximize are negated, and the reduced cost
+     * cost(row, col) - u[row] - v[col] is 0 for every assigned entry and at least 0 for
+     * all others (dummy entries cost 0). After an expired deadline only the latter holds.
+     *
+     * \return const std::vector<double>& u of all rows (size of the square RLAP)
+     */
+    const std::vector<double>& getRowDuals() const {return u;}
 
-    void solve(Tensor<unsigned>& assignments) override;
+    /**
+     * Column duals of the last RLAP solved, including dummy columns (see
+     * RLAPSolverJV::getRowDuals).
+     *
+     * \return const std::vector<double>& v of all columns (size of the square RLAP)
+     */
+    const std::vector<double>& getColumnDuals() const {return v;}
 
 private:
 
     /** Amount of matrix rows. */
-    const unsigned rows;
+    unsigned rows = 0;
 
     /** Amount of matrix columns. */
-    const unsigned cols;
+    unsigned cols = 0;
 
     /** Dimension of the RLAP. */
-    const unsigned size;
+    unsigned size = 0;
 
-    /** Cost matrix with inverted values and dummy rows and columns. */
-    std::vector<std::vector<double>> costMat;
+    /** Square cost matrix (row-major) with dummy rows and columns. */
+    std::vector<double> costMat;
 
     /** Column assigned to row in solution. */
     std::vector<int> rowsol;
@@ -49,18 +100,59 @@ private:
     /** Row assigned to column in solution. */
     std::vector<int> colsol;
 
+    /** Dual variables, row reduction numbers. */
+    std::vector<double> u;
+
+    /** Dual variables, column reduction numbers. */
+    std::vector<double> v;
+
+    /** List of unassigned rows. */
+    std::vector<int> freeRows;
+
+    /** List of columns scanned in augmenting path calculation. */
+    std::vector<int> scanned;
+
+    /** Counts how many times a row could be assigned. */
+    std::vector<int> matches;
+
+    /** Row-predecessor of column in augmenting/alternating path. */
+    std::vector<int> pred;
+
+    /** 'Cost-distance' in augmenting path calculation. */
+    std::vector<double> d;
+
+    /** Column prices, -infinity for scanned columns. */
+    std::vector<double> w;
+
+    /** 'Cost-distance' of the scanned columns. */
+    std::vector<double> ready;
+
+    /** Gap between the last solution and the dual bound. */
+    double lossBound = 0;
+
+    /** Costs of the free rows of the matrix and the free columns after a deadline. */
+    Tensor<int> freeCosts;
+
+    /** Solver completing the free rows after a deadline. */
+    RLAPSolverGreedyRegret completion;
+
+    /**
+     * JV shortest augmenting path algorithm to solve the assignment problem given by
+     * costMat. The solution is stored in rowsol and colsol, the duals in u and v.
+     * \param [in] dim			problem size
+     * \param [in] deadline	no more rows are augmented once it has expired
+     * \return bool true if all rows were augmented
+     */
+    bool jvlap(const int dim, const Deadline& deadline);
+
     /**
-     * JV shortest augmenting path algorithm to solve the assignment problem.
+     * Assigns the free rows of the matrix to the free columns by RLAPSolverGreedyRegret,
+     * dummy rows take the columns left over.
      * \param [in] dim			problem size
-     * \param [in] assigncost	cost matrix
-     * \param [in] rowsol		column assigned to row in solution
-     * \param [in] colsol		row assigned to column in solution
-     * \param [in] u			dual variables, row reduction numbers
-     * \param [in] v			dual variables, column reduction numbers
+     * \param [in] first		first free row in freeRows
+     * \param [in] last		end of the free rows in freeRows
      */
-    void jvlap(int dim, const std::vector<std::vector<double>>& assigncost,
-               std::vector<int>& rowsol,
-               std::vector<int>& colsol, std::vector<double>& u, std::vector<double>& v);
+    void completeGreedily(const int dim, const int first, const int last);
 
     /**
     * Fill assignments with the found RLAP solution using rowsol and colsol.
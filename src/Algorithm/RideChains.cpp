@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <tuple>
+#include "RideChains.hpp"
+
+/** Duration and slack of a chain started on time (see RideChains::RideChains). */
+struct ChainTiming {
+    /** Steps from the earliest start of the first ride to the finish of the last one. */
+    int duration;
+    /** Steps the chain may start later and still finish every ride in time (-1: infeasible). */
+    int slack;
+    /** Number of rides started on time. */
+    int bonuses;
+};
+
+/**
+ * Simulates a car taking the rides of a chain, starting the first one on time.
+ *
+ * \param [in] inputData InputData representing the simulation enviroment
+ * \param [in] rides rides of the chain
+ * \return ChainTiming duration and slack of the chain
+ */
+static ChainTiming simulate(const InputData& inputData, const std::vector<unsigned>& rides) {
+    int t = inputData.startT(rides.front());
+    int x = inputData.startX(rides.front());
+    int y = inputData.startY(rides.front());
+    int slack = std::numeric_limits<int>::max();
+    int bonuses = 0;
+
+    for(const unsigned ride : rides) {
+        const int arrival = t + std::abs(x - inputData.startX(ride)) +
+                            std::abs(y - inputData.startY(ride));
+
+        if(arrival <= inputData.startT(ride)) {++bonuses;}
+
+        t = std::max(arrival, inputData.startT(ride)) + inputData.distances(ride);
+        slack = std::min(slack, inputData.endT(ride) - t);
+        x = inputData.endX(ride);
+        y = inputData.endY(ride);
+    }
+
+    return {t - inputData.startT(rides.front()), std::max(slack, -1), bonuses};
+}
+
+RideChains::RideChains(const InputData& inputData, const SuccessorGraph& successors,
+                       const unsigned maxLength, const int maxGap) {
+    const unsigned nRides = inputData.nRides;
+
+    // candidate links (idle time, ride, successor)
+    std::vector<std::tuple<int, unsigned, unsigned>> links;
+
+    for(unsigned ride = 0; ride < nRides; ++ride) {
+        const int finish = inputData.startT(ride) + inputData.distances(ride);
+        const SuccessorGraph::Successors following = successors.successors(ride);
+
+        // successors are ordered by idle time
+        for(unsigned k = 0; k < following.size; ++k) {
+            const int idle = std::max(static_cast<int>(following.distances[k]),
+                                      inputData.startT(following.rides[k]) - finish);
+
+            if(idle > maxGap) {break;}
+
+            links.emplace_back(idle, ride, following.rides[k]);
+        }
+    }
+
+    std::sort(links.begin(), links.end());
+
+    // chains are linked lists, the head knows the tail and the length and vice versa
+    std::vector<int> next(nRides, -1), prev(nRides, -1);
+    std::vector<unsigned> headOf(nRides), tailOf(nRides), length(nRides, 1);
+    std::vector<unsigned> chain;
+
+    for(unsigned ride = 0; ride < nRides; ++ride) {
+        headOf[ride] = ride;
+        tailOf[ride] = ride;
+    }
+
+    for(const auto& link : links) {
+        const unsigned ride = std::get<1>(link);
+        const unsigned successor = std::get<2>(link);
+
+        // only the tail of a chain can be linked to the head of another one
+        if(next[ride] >= 0 || prev[successor] >= 0 || headOf[ride] == successor) {continue;}
+
+        const unsigned head = headOf[ride];
+        const unsigned tail = tailOf[successor];
+
+        if(length[head] + length[successor] > maxLength) {continue;}
+
+        chain.clear();
+
+        for(int current = head; current >= 0; current = next[current]) {
+            chain.push_back(current);
+        }
+
+        for(int current = successor; current >= 0; current = next[current]) {
+            chain.push_back(current);
+        }
+
+        if(simulate(inputData, chain).slack < 0) {continue;}
+
+        next[ride] = successor;
+        prev[successor] = ride;
+        tailOf[head] = tail;
+        headOf[tail] = head;
+        length[head] += length[successor];
+    }
+
+    std::vector<int> values;
+    std::vector<int> durations;
+
+    for(unsigned ride = 0; ride < nRides; ++ride) {
+        if(prev[ride] >= 0) {continue;}
+
+        chain.clear();
+
+        for(int current = ride; current >= 0; current = next[current]) {
+            chain.push_back(current);
+        }
+
+        // a single ride that can't be finished in time stays a job with its own window
+        const ChainTiming timing = simulate(inputData, chain);
+        const unsigned last = chain.back();
+        values.insert(values.end(), {inputData.startX(ride), inputData.startY(ride),
+                                     inputData.endX(last), inputData.endY(last),
+                                     inputData.startT(ride),
+                                     chain.size() > 1 ?
+                                     inputData.startT(ride) + timing.duration + timing.slack :
+                                     inputData.endT(ride)});
+        durations.push_back(timing.duration);
+        bonuses.push_back(timing.bonuses);
+        points.push_back(0);
+
+        for(const unsigned member : chain) {
+            points.back() += inputData.distances(member);
+        }
+
+        if(chain.size() > 1) {chained += chain.size();}
+
+        members.push_back(chain);
+    }
+
+    jobs = InputData::genFromValues(inputData.rows, inputData.cols, inputData.fleetSize,
+                                    inputData.bonus, inputData.maxTime, values);
+
+    for(unsigned job = 0; job < jobs->nRides; ++job) {
+        jobs->distances(job) = durations[job];
+    }
+}
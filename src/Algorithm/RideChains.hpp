@@ -0,0 +1,93 @@
+#ifndef RIDE_CHAINS_H
+#define RIDE_CHAINS_H
+
+#include <memory>
+#include <vector>
+#include "InputData.hpp"
+#include "SuccessorGraph.hpp"
+
+/**
+ * Merges rides that fit together back-to-back into composite jobs before the assignment.
+ *
+ * Ride s is appended to ride r if s is one of the successors of r (see SuccessorGraph) and a
+ * car finishing r as early as possible is idle for at most maxGap steps before starting s.
+ * The links are made greedily, least idle time first, as long as the chain doesn't exceed
+ * maxLength rides and every ride of the chain is finished in time when the first one starts
+ * on time.
+ *
+ * Every chain becomes one ride of the InputData of the jobs (see RideChains::getJobs): it
+ * starts where its first ride starts, at the same earliest start, and ends where its last
+ * ride ends. Its distance is the duration of the chain when started on time, its latest finish
+ * leaves as much delay as the tightest ride of the chain allows. Its points are the distances of
+ * all its rides and it earns the bonus of every ride that starts on time when the job does
+ * (see Generator::setJobPoints). A job started late is assumed to be shifted as a whole, so
+ * waiting times inside the chain that would absorb the delay are ignored.
+ */
+class RideChains {
+public:
+
+    /**
+     * Builds the chains.
+     *
+     * \param [in] inputData InputData representing the simulation enviroment
+     * \param [in] successors successors of the rides of inputData
+     * \param [in] maxLength maximal number of rides of a job
+     * \param [in] maxGap maximal idle time between two rides of a job
+     */
+    RideChains(const InputData& inputData, const SuccessorGraph& successors,
+               const unsigned maxLength, const int maxGap);
+
+    /**
+     * InputData with one ride per job, e.g. to create a Generator of the jobs.
+     *
+     * \return std::shared_ptr<InputData> jobs
+     */
+    std::shared_ptr<InputData> getJobs() const {return jobs;}
+
+    /**
+     * Rides of each job in the order they are taken.
+     *
+     * \return const std::vector<std::vector<unsigned>>& rides of all jobs
+     */
+    const std::vector<std::vector<unsigned>>& getMembers() const {return members;}
+
+    /**
+     * Points of each job if it's finished in time: the distances of all its rides.
+     *
+     * \return const std::vector<int>& points of all jobs
+     */
+    const std::vector<int>& getPoints() const {return points;}
+
+    /**
+     * Number of bonuses of each job if it's started in time.
+     *
+     * \return const std::vector<int>& bonuses of all jobs
+     */
+    const std::vector<int>& getBonuses() const {return bonuses;}
+
+    /**
+     * Number of rides that are part of a job with more than one ride.
+     *
+     * \return unsigned number of chained rides
+     */
+    unsigned getChainedCount() const {return chained;}
+
+private:
+
+    /** InputData with one ride per job. */
+    std::shared_ptr<InputData> jobs;
+
+    /** Rides of each job. */
+    std::vector<std::vector<unsigned>> members;
+
+    /** Points of each job. */
+    std::vector<int> points;
+
+    /** Number of bonuses of each job. */
+    std::vector<int> bonuses;
+
+    /** Number of rides that are part of a job with more than one ride. */
+    unsigned chained = 0;
+};
+
+#endif // RIDE_CHAINS_H
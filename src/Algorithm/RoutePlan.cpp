@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <cstdlib>
+#include "RoutePlan.hpp"
+
+RoutePlan::RoutePlan(const InputData& inputData, const Solution& solution):
+    inputData(inputData), routes(solution.routes.size()), score(0) {
+    std::vector<bool> assigned(inputData.nRides, false);
+
+    for(unsigned car = 0; car < routes.size(); ++car) {
+        routes[car].rides = solution.routes[car];
+        evaluate(routes[car]);
+
+        if(!routes[car].points.empty()) {
+            score += routes[car].points.back();
+        }
+
+        for(unsigned ride : routes[car].rides) {
+            assigned[ride] = true;
+        }
+    }
+
+    for(unsigned ride = 0; ride < inputData.nRides; ++ride) {
+        if(!assigned[ride]) {
+            unassigned.push_back(ride);
+        }
+    }
+}
+
+Solution RoutePlan::toSolution() const {
+    Solution solution(routes.size());
+
+    for(unsigned car = 0; car < routes.size(); ++car) {
+        solution.routes[car] = routes[car].rides;
+    }
+
+    return solution;
+}
+
+RoutePlan::State RoutePlan::step(const State& state, const unsigned ride,
+                                 int& points) const {
+    // point in time when the ride can start (car arrived)
+    const int startTime = std::max(state.t + std::abs(state.x - inputData.startX(ride)) +
+                                   std::abs(state.y - inputData.startY(ride)), inputData.startT(ride));
+    const int finishTime = startTime + inputData.distances(ride);
+    points = 0;
+
+    // ride ended in time (points gained)
+    if(inputData.endT(ride) >= finishTime) {
+        points += inputData.distances(ride);
+    }
+
+    // ride started in time (bonus gained)
+    if(inputData.startT(ride) == startTime) {
+        points += inputData.bonus;
+    }
+
+    return {inputData.endX(ride), inputData.endY(ride), finishTime};
+}
+
+void RoutePlan::evaluate(Route& route) const {
+    const unsigned n = route.rides.size();
+    std::vector<int> startTimes(n);
+    State state = {0, 0, 0};
+    int sum = 0;
+
+    route.finish.resize(n);
+    route.points.resize(n);
+    route.latest.resize(n);
+
+    for(unsigned k = 0; k < n; ++k) {
+        int points;
+        const State next = step(state, route.rides[k], points);
+        startTimes[k] = next.t - inputData.distances(route.rides[k]);
+        sum += points;
+        route.finish[k] = next.t;
+        route.points[k] = sum;
+        state = next;
+    }
+
+    // latest arrival at each ride that keeps the points of this ride and all following ones
+    for(unsigned k = n; k-- > 0;) {
+        const unsigned ride = route.rides[k];
+        int limit = NO_LIMIT;
+
+        if(k + 1 < n && route.latest[k + 1] != NO_LIMIT) {
+            const unsigned next = route.rides[k + 1];
+            limit = route.latest[k + 1] - inputData.distances(ride) -
+                    std::abs(inputData.endX(ride) - inputData.startX(next)) -
+                    std::abs(inputData.endY(ride) - inputData.startY(next));
+        }
+
+        if(inputData.endT(ride) >= route.finish[k]) {
+            limit = std::min(limit, inputData.endT(ride) - inputData.distances(ride));
+        }
+
+        if(inputData.startT(ride) == startTimes[k]) {
+            limit = std::min(limit, inputData.startT(ride));
+        }
+
+        route.latest[k] = limit;
+    }
+}
+
+RoutePlan::State RoutePlan::stateAfter(const unsigned car, const unsigned n) const {
+    if(n == 0) {
+        return {0, 0, 0};
+    }
+
+    const unsigned ride = routes[car].rides[n - 1];
+    return {inputData.endX(ride), inputData.endY(ride), routes[car].finish[n - 1]};
+}
+
+int RoutePlan::suffixPoints(const unsigned car, const unsigned from) const {
+    const Route& route = routes[car];
+
+    if(from >= route.rides.size()) {
+        return 0;
+    }
+
+    return route.points.back() - (from > 0 ? route.points[from - 1] : 0);
+}
+
+int RoutePlan::suffixValue(const unsigned car, const unsigned from,
+                           const State& state) const {
+    const Route& route = routes[car];
+
+    if(from >= route.rides.size()) {
+        return 0;
+    }
+
+    const unsigned ride = route.rides[from];
+    const int arrival = state.t + std::abs(state.x - inputData.startX(ride)) +
+                        std::abs(state.y - inputData.startY(ride));
+
+    // no points of the suffix are lost
+    if(arrival <= route.latest[from]) {
+        return suffixPoints(car, from);
+    }
+
+    // simulate the rest of the route
+    State current = state;
+    int sum = 0;
+
+    for(unsigned k = from; k < route.rides.size(); ++k) {
+        int points;
+        current = step(current, route.rides[k], points);
+        sum += points;
+    }
+
+    return sum;
+}
+
+int RoutePlan::removeDelta(const unsigned car, const unsigned pos) const {
+    return suffixValue(car, pos + 1, stateAfter(car, pos)) - suffixPoints(car, pos);
+}
+
+int RoutePlan::insertDelta(const unsigned car, const unsigned pos,
+                           const unsigned ride) const {
+    int points;
+    const State state = step(stateAfter(car, pos), ride, points);
+    return points + suffixValue(car, pos, state) - suffixPoints(car, pos);
+}
+
+int RoutePlan::replaceDelta(const unsigned car, const unsigned pos,
+                            const unsigned ride) const {
+    int points;
+    const State state = step(stateAfter(car, pos), ride, points);
+    return points + suffixValue(car, pos + 1, state) - suffixPoints(car, pos);
+}
+
+int RoutePlan::exchangeDelta(const unsigned carA, const unsigned n,
+                             const unsigned carB, const unsigned m) const {
+    return suffixValue(carB, m, stateAfter(carA, n)) +
+           suffixValue(carA, n, stateAfter(carB, m)) -
+           suffixPoints(carA, n) - suffixPoints(carB, m);
+}
+
+unsigned RoutePlan::slotOf(const unsigned car, const int time) const {
+    const std::vector<int>& finish = routes[car].finish;
+    return std::upper_bound(finish.begin(), finish.end(), time) - finish.begin();
+}
+
+void RoutePlan::setRides(const unsigned car, std::vector<unsigned> rides) {
+    Route& route = routes[car];
+    score -= suffixPoints(car, 0);
+    route.rides = std::move(rides);
+    evaluate(route);
+    score += suffixPoints(car, 0);
+}
+
+void RoutePlan::relocate(const unsigned carA, const unsigned posA, const unsigned carB,
+                         const unsigned posB) {
+    std::vector<unsigned> ridesA = routes[carA].rides, ridesB = routes[carB].rides;
+    ridesB.insert(ridesB.begin() + posB, ridesA[posA]);
+    ridesA.erase(ridesA.begin() + posA);
+    setRides(carA, std::move(ridesA));
+    setRides(carB, std::move(ridesB));
+}
+
+void RoutePlan::swap(const unsigned carA, const unsigned posA, const unsigned carB,
+                     const unsigned posB) {
+    std::vector<unsigned> ridesA = routes[carA].rides, ridesB = routes[carB].rides;
+    std::swap(ridesA[posA], ridesB[posB]);
+    setRides(carA, std::move(ridesA));
+    setRides(carB, std::move(ridesB));
+}
+
+void RoutePlan::exchange(const unsigned carA, const unsigned n, const unsigned carB,
+                         const unsigned m) {
+    const std::vector<unsigned>& oldA = routes[carA].rides, &oldB = routes[carB].rides;
+    std::vector<unsigned> ridesA(oldA.begin(), oldA.begin() + n);
+    std::vector<unsigned> ridesB(oldB.begin(), oldB.begin() + m);
+    ridesA.insert(ridesA.end(), oldB.begin() + m, oldB.end());
+    ridesB.insert(ridesB.end(), oldA.begin() + n, oldA.end());
+    setRides(carA, std::move(ridesA));
+    setRides(carB, std::move(ridesB));
+}
+
+void RoutePlan::insert(const unsigned car, const unsigned pos, const unsigned ride) {
+    std::vector<unsigned> rides = routes[car].rides;
+    rides.insert(rides.begin() + pos, ride);
+    setRides(car, std::move(rides));
+    unassigned.erase(std::lower_bound(unassigned.begin(), unassigned.end(), ride));
+}
+
+void RoutePlan::remove(const unsigned car, const unsigned pos) {
+    std::vector<unsigned> rides = routes[car].rides;
+    const unsigned ride = rides[pos];
+    rides.erase(rides.begin() + pos);
+    setRides(car, std::move(rides));
+    unassigned.insert(std::lower_bound(unassigned.begin(), unassigned.end(), ride), ride);
+}
@@ -0,0 +1,258 @@
+#ifndef ROUTE_PLAN_H
+#define ROUTE_PLAN_H
+
+#include <vector>
+#include <limits>
+#include "InputData.hpp"
+#include "Solution.hpp"
+
+/**
+ * Mutable representation of a Solution that allows to evaluate changes of car routes
+ * in constant time.
+ *
+ * For each route prefix arrays of finish times and points are kept. Additionally, each
+ * position stores the latest point in time a car may arrive at the start of that ride
+ * without losing any points of the remaining route. Changes that let a car arrive
+ * earlier than that time can be evaluated without simulating the rest of the route.
+ *
+ * \note Evaluations return a lower bound of the real change in points, since arriving earlier
+ *       can only gain points. Applied changes are always simulated exactly.
+ */
+class RoutePlan {
+public:
+
+    /** Used for routes positions that have no arrival restriction. */
+    static constexpr int NO_LIMIT = std::numeric_limits<int>::max();
+
+    /** Position and point in time of a car. */
+    struct State {
+        /** Row coordinate. */
+        int x;
+        /** Column coordinate. */
+        int y;
+        /** Point in time. */
+        int t;
+    };
+
+    /** Ride list of a car with its precomputed prefix arrays. */
+    struct Route {
+        /** Indices of the rides in the order they are taken. */
+        std::vector<unsigned> rides;
+        /** Finish time of each ride. */
+        std::vector<int> finish;
+        /** Points gained up to and including each ride. */
+        std::vector<int> points;
+        /** Latest arrival at each ride's start that keeps all points of the remaining route. */
+        std::vector<int> latest;
+    };
+
+    /**
+     * Creates the route plan of an existing solution.
+     *
+     * \param [in] inputData InputData representing the simulation enviroment
+     * \param [in] solution routes of all cars
+     */
+    RoutePlan(const InputData& inputData, const Solution& solution);
+
+    /**
+     * Creates a Solution containing the current routes.
+     *
+     * \return Solution routes of all cars
+     */
+    Solution toSolution() const;
+
+    /**
+     * Total points of all routes.
+     *
+     * \return long sum of all points
+     */
+    long getScore() const {return score;};
+
+    /** Number of routes (cars). */
+    unsigned getRouteCount() const {return routes.size();};
+
+    /** Route of a given car. */
+    const Route& getRoute(const unsigned car) const {return routes[car];};
+
+    /** Indices of all rides that are not part of any route. */
+    const std::vector<unsigned>& getUnassigned() const {return unassigned;};
+
+    /**
+     * State of a car after taking the first n rides of its route.
+     *
+     * \param [in] car index of the route
+     * \param [in] n number of rides taken
+     * \return State position and time of the car
+     */
+    State stateAfter(const unsigned car, const unsigned n) const;
+
+    /**
+     * Points of the rides [from, end) of a route if the car is in a given state before.
+     *
+     * \param [in] car index of the route
+     * \param [in] from first ride of the route suffix
+     * \param [in] state position and time of the car before taking the suffix
+     * \return int (lower bound of) the points of the route suffix
+     */
+    int suffixValue(const unsigned car, const unsigned from, const State& state) const;
+
+    /**
+     * Points of the rides [from, end) of a route as currently planned.
+     *
+     * \param [in] car index of the route
+     * \param [in] from first ride of the route suffix
+     * \return int points of the route suffix
+     */
+    int suffixPoints(const unsigned car, const unsigned from) const;
+
+    /**
+     * Change of points when removing a ride from a route.
+     *
+     * \param [in] car index of the route
+     * \param [in] pos position of the ride in the route
+     * \return int change of points
+     */
+    int removeDelta(const unsigned car, const unsigned pos) const;
+
+    /**
+     * Change of points when inserting a ride into a route.
+     *
+     * \param [in] car index of the route
+     * \param [in] pos position of the ride after inserting it
+     * \param [in] ride index of the inserted ride
+     * \return int change of points
+     */
+    int insertDelta(const unsigned car, const unsigned pos, const unsigned ride) const;
+
+    /**
+     * Change of points when replacing a ride of a route by another one.
+     *
+     * \param [in] car index of the route
+     * \param [in] pos position of the replaced ride
+     * \param [in] ride index of the new ride
+     * \return int change of points
+     */
+    int replaceDelta(const unsigned car, const unsigned pos, const unsigned ride) const;
+
+    /**
+     * Change of points when the routes of two cars exchange their tails
+     * (carA keeps n rides and continues with carB's rides [m, end) and vice versa).
+     *
+     * \param [in] carA index of the first route
+     * \param [in] n number of rides carA keeps
+     * \param [in] carB index of the second route
+     * \param [in] m number of rides carB keeps
+     * \return int change of points
+     */
+    int exchangeDelta(const unsigned carA, const unsigned n, const unsigned carB,
+                      const unsigned m) const;
+
+    /**
+     * Position at which a ride fits best into the time line of a route.
+     *
+     * \param [in] car index of the route
+     * \param [in] time point in time the ride should start at
+     * \return unsigned number of rides that finish before the given time
+     */
+    unsigned slotOf(const unsigned car, const int time) const;
+
+    /**
+     * Moves a ride from one route into another one.
+     *
+     * \param [in] carA route the ride is taken from
+     * \param [in] posA position of the ride in carA
+     * \param [in] carB route the ride is inserted into (must differ from carA)
+     * \param [in] posB position of the ride in carB after inserting it
+     */
+    void relocate(const unsigned carA, const unsigned posA, const unsigned carB,
+                  const unsigned posB);
+
+    /**
+     * Exchanges two rides of different routes.
+     *
+     * \param [in] carA first route
+     * \param [in] posA position in the first route
+     * \param [in] carB second route (must differ from carA)
+     * \param [in] posB position in the second route
+     */
+    void swap(const unsigned carA, const unsigned posA, const unsigned carB,
+              const unsigned posB);
+
+    /**
+     * Exchanges the route tails of two cars, see RoutePlan::exchangeDelta.
+     *
+     * \param [in] carA index of the first route
+     * \param [in] n number of rides carA keeps
+     * \param [in] carB index of the second route (must differ from carA)
+     * \param [in] m number of rides carB keeps
+     */
+    void exchange(const unsigned carA, const unsigned n, const unsigned carB,
+                  const unsigned m);
+
+    /**
+     * Inserts an unassigned ride into a route.
+     *
+     * \param [in] car index of the route
+     * \param [in] pos position of the ride after inserting it
+     * \param [in] ride index of an unassigned ride
+     */
+    void insert(const unsigned car, const unsigned pos, const unsigned ride);
+
+    /**
+     * Removes a ride from a route and marks it as unassigned.
+     *
+     * \param [in] car index of the route
+     * \param [in] pos position of the ride
+     */
+    void remove(const unsigned car, const unsigned pos);
+
+    /**
+     * Replaces the ride list of a route and updates its prefix arrays and the score.
+     *
+     * \note Unassigned rides are not updated, see RoutePlan::setUnassigned.
+     *
+     * \param [in] car index of the route
+     * \param [in] rides new ride list
+     */
+    void setRides(const unsigned car, std::vector<unsigned> rides);
+
+    /**
+     * Replaces the list of unassigned rides.
+     *
+     * \param [in] rides indices of all rides not part of any route
+     */
+    void setUnassigned(std::vector<unsigned> rides) {unassigned = std::move(rides);};
+
+    /**
+     * Position and points of a car taking a ride in a given state.
+     *
+     * \param [in] state position and time of the car
+     * \param [in] ride index of the ride
+     * \param [out] points points gained by taking the ride
+     * \return State state of the car after finishing the ride
+     */
+    State step(const State& state, const unsigned ride, int& points) const;
+
+private:
+
+    /**
+     * Recomputes the prefix arrays of a route.
+     *
+     * \param [in,out] route route to update
+     */
+    void evaluate(Route& route) const;
+
+    /** InputData representing the simulation enviroment. */
+    const InputData& inputData;
+
+    /** Routes of all cars. */
+    std::vector<Route> routes;
+
+    /** Indices of all rides that are not part of any route. */
+    std::vector<unsigned> unassigned;
+
+    /** Total points of all routes. */
+    long score;
+};
+
+#endif // ROUTE_PLAN_H
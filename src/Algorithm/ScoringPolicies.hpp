@@ -0,0 +1,149 @@
+#ifndef SCORING_POLICIES_H
+#define SCORING_POLICIES_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "InputData.hpp"
+
+/**
+ * Scoring policies of PolicyGenerator.
+ *
+ * A policy is constructed once from the InputData and scores a car taking a ride:
+ * \code
+ * int operator()(const int ride, const int carTime, const int startTime,
+ *                const int finishTime, const int finishPoints, const bool bonus) const;
+ * \endcode
+ * - ride: index of the ride
+ * - carTime: point in time when the car is free
+ * - startTime: point in time when the ride starts
+ * - finishTime: point in time when the ride is finished
+ * - finishPoints: points of the car after the ride (including distance and bonus)
+ * - bonus: true if the ride starts in time
+ *
+ * The policy is a template parameter, calls are resolved at compile time and inlined into
+ * the loop filling the score matrix.
+ */
+namespace Scoring {
+
+/** Time left after finishing the ride plus points. */
+struct TimeLeftAndPoints {
+    /** Name used to select the policy. */
+    static constexpr const char* name = "time-left";
+
+    TimeLeftAndPoints(const InputData& inputData): maxTime(inputData.maxTime) {};
+
+    inline int operator()(const int, const int, const int, const int finishTime,
+                          const int finishPoints, const bool) const {
+        return std::max(maxTime - finishTime, 0) + finishPoints;
+    }
+
+    /** Number of steps in the simulation. */
+    const int maxTime;
+};
+
+/** Points after finishing the ride. */
+struct Points {
+    /** Name used to select the policy. */
+    static constexpr const char* name = "points";
+
+    Points(const InputData&) {};
+
+    inline int operator()(const int, const int, const int, const int,
+                          const int finishPoints, const bool) const {
+        return finishPoints;
+    }
+};
+
+/** Points after finishing the ride minus the time spent driving empty and waiting. */
+struct IdlePenalty {
+    /** Name used to select the policy. */
+    static constexpr const char* name = "idle-penalty";
+
+    IdlePenalty(const InputData&) {};
+
+    inline int operator()(const int, const int carTime, const int startTime, const int,
+                          const int finishPoints, const bool) const {
+        return finishPoints - (startTime - carTime);
+    }
+};
+
+/** Like TimeLeftAndPoints, but a bonus counts WeightedBonus::WEIGHT times. */
+struct WeightedBonus {
+    /** Name used to select the policy. */
+    static constexpr const char* name = "weighted-bonus";
+    /** Factor applied to the bonus. */
+    static constexpr int WEIGHT = 2;
+
+    WeightedBonus(const InputData& inputData):
+        maxTime(inputData.maxTime), extraBonus((WEIGHT - 1) * inputData.bonus) {};
+
+    inline int operator()(const int, const int, const int, const int finishTime,
+                          const int finishPoints, const bool bonus) const {
+        return std::max(maxTime - finishTime, 0) + finishPoints + (bonus ? extraBonus : 0);
+    }
+
+    /** Number of steps in the simulation. */
+    const int maxTime;
+    /** Points added to a gained bonus. */
+    const int extraBonus;
+};
+
+/**
+ * Like TimeLeftAndPoints, minus the distance from the end of the ride to the nearest
+ * cluster of ride starts. Cars prefer rides ending where the next rides begin.
+ */
+struct NextCluster {
+    /** Name used to select the policy. */
+    static constexpr const char* name = "next-cluster";
+    /** Number of cells per grid dimension used to find clusters. */
+    static constexpr unsigned GRID = 16;
+    /** Number of densest cells used as clusters. */
+    static constexpr unsigned CLUSTERS = 8;
+
+    NextCluster(const InputData& inputData):
+        maxTime(inputData.maxTime), clusterDistances(inputData.nRides) {
+        const int cellRows = std::max(1u, (inputData.rows + GRID - 1) / GRID);
+        const int cellCols = std::max(1u, (inputData.cols + GRID - 1) / GRID);
+        std::vector<unsigned> counts(GRID * GRID, 0);
+
+        for(unsigned ride = 0; ride < inputData.nRides; ++ride) {
+            ++counts[(inputData.startX(ride) / cellRows) * GRID + inputData.startY(ride) / cellCols];
+        }
+
+        std::vector<unsigned> cells(counts.size());
+
+        for(unsigned i = 0; i < cells.size(); ++i) {cells[i] = i;}
+
+        const unsigned nClusters = std::min<unsigned>(CLUSTERS, cells.size());
+        std::partial_sort(cells.begin(), cells.begin() + nClusters, cells.end(),
+        [&counts](const unsigned a, const unsigned b) {return counts[a] > counts[b];});
+
+        for(unsigned ride = 0; ride < inputData.nRides; ++ride) {
+            int distance = inputData.rows + inputData.cols;
+
+            for(unsigned i = 0; i < nClusters; ++i) {
+                const int centerX = (cells[i] / GRID) * cellRows + cellRows / 2;
+                const int centerY = (cells[i] % GRID) * cellCols + cellCols / 2;
+                distance = std::min(distance, std::abs(inputData.endX(ride) - centerX) +
+                                    std::abs(inputData.endY(ride) - centerY));
+            }
+
+            clusterDistances[ride] = distance;
+        }
+    };
+
+    inline int operator()(const int ride, const int, const int, const int finishTime,
+                          const int finishPoints, const bool) const {
+        return std::max(maxTime - finishTime, 0) + finishPoints - clusterDistances[ride];
+    }
+
+    /** Number of steps in the simulation. */
+    const int maxTime;
+    /** Distance from the end of each ride to the nearest cluster. */
+    std::vector<int> clusterDistances;
+};
+
+}
+
+#endif // SCORING_POLICIES_H
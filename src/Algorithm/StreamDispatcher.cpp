@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include "StreamDispatcher.hpp"
+
+double StreamDispatcher::Report::latency(const double p) const {
+    if(latencies.empty()) {return 0;}
+
+    std::vector<double> sorted(latencies);
+    const unsigned index = std::min<unsigned>(sorted.size() - 1, p * sorted.size());
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+StreamDispatcher::StreamDispatcher(InputData& inputData, Generator& generator,
+                                   const int leadTime, const int window,
+                                   const unsigned maxBatchSize):
+    inputData(inputData), generator(generator), leadTime(leadTime), window(window),
+    maxBatchSize(maxBatchSize) {}
+
+StreamDispatcher::Report StreamDispatcher::run() {
+    typedef std::chrono::steady_clock Clock;
+    typedef std::pair<int, unsigned> Event;
+
+    const auto runStart = Clock::now();
+    Report report;
+
+    // event stream: rides ordered by the point in time they are revealed
+    auto revealTime = [this](const int ride) {
+        return std::max(0, inputData.startT(ride) - leadTime);
+    };
+    std::vector<int> stream(inputData.nRides);
+    std::iota(stream.begin(), stream.end(), 0);
+    std::stable_sort(stream.begin(), stream.end(), [&](const int a, const int b) {
+        return revealTime(a) < revealTime(b);
+    });
+    unsigned next = 0;
+
+    // cars ordered by the point in time of their next decision
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    Types::CarData cars(inputData.fleetSize);
+
+    for(unsigned car = 0; car < inputData.fleetSize; ++car) {
+        events.push({0, car});
+    }
+
+    std::vector<int> revealed;
+    std::shared_ptr<SearchGraphNode> currentNode;
+
+    while(!events.empty()) {
+        const int now = events.top().first;
+
+        // rides that can't be started in time anymore aren't revealed at all
+        for(; next < stream.size() && revealTime(stream[next]) <= now; ++next) {
+            const int ride = stream[next];
+
+            if(inputData.endT(ride) - inputData.distances(ride) >= now) {
+                revealed.push_back(ride);
+            }
+        }
+
+        if(revealed.empty()) {
+            if(next == stream.size()) {break;}
+
+            // nothing to do until the next ride is revealed
+            const Event event = events.top();
+            events.pop();
+            events.push({revealTime(stream[next]), event.second});
+            continue;
+        }
+
+        std::vector<unsigned> batch;
+
+        while(!events.empty() && events.top().first <= now + window &&
+              batch.size() < maxBatchSize) {
+            const unsigned car = events.top().second;
+            events.pop();
+            // a waiting car can't leave before the decision has been made
+            cars.t(car) = std::max(cars.t(car), now);
+            batch.push_back(car);
+        }
+
+        const std::vector<unsigned> candidates = batch;
+
+        const auto decisionStart = Clock::now();
+        std::shared_ptr<SearchGraphNode> node = generator.generate(revealed, cars, currentNode,
+                                                batch);
+        report.latencies.push_back(std::chrono::duration<double>(Clock::now() -
+                                   decisionStart).count());
+
+        if(node) {currentNode = node;}
+
+        for(const unsigned car : candidates) {
+            if(std::find(batch.begin(), batch.end(), car) != batch.end()) {
+                events.push({cars.t(car), car});
+            } else if(next < stream.size()) {
+                // no reachable ride yet, wait for the next revealed ride
+                events.push({std::max(now + 1, revealTime(stream[next])), car});
+            }
+        }
+    }
+
+    report.solution = currentNode ? currentNode->toSolution(inputData.fleetSize) :
+                      Solution(inputData.fleetSize);
+
+    for(const std::vector<unsigned>& route : report.solution.routes) {
+        report.assigned += route.size();
+    }
+
+    report.wallTime = std::chrono::duration<double>(Clock::now() - runStart).count();
+    return report;
+}
@@ -0,0 +1,88 @@
+#ifndef STREAM_DISPATCHER_H
+#define STREAM_DISPATCHER_H
+
+#include <vector>
+#include "Types.hpp"
+#include "InputData.hpp"
+#include "Generator.hpp"
+#include "Solution.hpp"
+
+/**
+ * Online dispatch of rides that are revealed over time.
+ *
+ * The rides of an input file are replayed as an event stream: each ride becomes known
+ * StreamDispatcher#leadTime steps before its earliest start. Simulated time advances to
+ * the point in time at which the next car is free; this car and all cars free within
+ * StreamDispatcher#window steps after it get rides out of the revealed ones by a small RLAP
+ * (see Generator::generate). Assignments are never changed afterwards. A car without a
+ * reachable ride waits at its position until more rides are revealed.
+ */
+class StreamDispatcher {
+public:
+
+    /** Result and decision statistics of a run. */
+    struct Report {
+        /** Committed routes. */
+        Solution solution;
+        /** Number of assigned rides. */
+        unsigned assigned = 0;
+        /** Wall-clock time of each decision (RLAP of a batch) in seconds. */
+        std::vector<double> latencies;
+        /** Wall-clock time of the whole run in seconds. */
+        double wallTime = 0;
+
+        /**
+         * Percentile of the decision latencies.
+         *
+         * \param [in] p percentile in [0, 1]
+         * \return double latency in seconds
+         */
+        double latency(const double p) const;
+
+        /**
+         * Number of processed rides (assigned or not) per wall-clock second.
+         *
+         * \param [in] nRides number of rides of the stream
+         * \return double throughput
+         */
+        double throughput(const unsigned nRides) const {return wallTime > 0 ? nRides / wallTime : 0;}
+    };
+
+    /**
+     * Creates an online dispatcher.
+     *
+     * \param [in] inputData InputData replayed as event stream
+     * \param [in] generator Generator solving the RLAP of each batch
+     * \param [in] leadTime rides are revealed this many steps before their earliest start
+     * \param [in] window cars free at most this many steps after the earliest car join its batch
+     * \param [in] maxBatchSize maximum number of cars of a batch
+     */
+    StreamDispatcher(InputData& inputData, Generator& generator, const int leadTime,
+                     const int window, const unsigned maxBatchSize = 32);
+
+    /**
+     * Replays the stream and commits assignments as simulated time advances.
+     *
+     * \return Report committed routes and decision statistics
+     */
+    Report run();
+
+private:
+
+    /** InputData replayed as event stream. */
+    InputData& inputData;
+
+    /** Solves the RLAP of each batch. */
+    Generator& generator;
+
+    /** Rides are revealed this many steps before their earliest start. */
+    const int leadTime;
+
+    /** Cars free at most this many steps after the earliest car join its batch. */
+    const int window;
+
+    /** Maximum number of cars of a batch. */
+    const unsigned maxBatchSize;
+};
+
+#endif // STREAM_DISPATCHER_H
@@ -1,16 +1,167 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <sstream>
+#include <stdexcept>
 #include "InputData.hpp"
 
+/** Number of 32 bit values stored per ride in a snapshot. */
+static constexpr unsigned SNAPSHOT_RIDE_VALUES = 6;
+
 std::shared_ptr<InputData> InputData::genFromFile(const std::string path) {
     std::fstream inFile;
     inFile.exceptions(std::fstream::failbit | std::fstream::badbit);
 
-    inFile.open(path, std::fstream::in);
+    inFile.open(path, std::fstream::in | std::fstream::binary);
+    char magic[sizeof(SNAPSHOT_MAGIC)] = {};
+    // a text file may be shorter than the magic
+    inFile.exceptions(std::fstream::badbit);
+    inFile.read(magic, sizeof(magic));
+    inFile.clear();
+    inFile.seekg(0);
+    inFile.exceptions(std::fstream::failbit | std::fstream::badbit);
+
+    if(std::equal(magic, magic + sizeof(magic), SNAPSHOT_MAGIC)) {
+        return genFromSnapshot(inFile);
+    }
+
+    return genFromStream(inFile);
+};
+
+std::shared_ptr<InputData> InputData::genFromStream(std::istream& stream) {
+    const std::ios_base::iostate exceptions = stream.exceptions();
+    stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
     unsigned rows, cols, fleetSize, nRides, bonus, maxTime;
-    inFile >> rows >> cols >> fleetSize >> nRides >> bonus >> maxTime;
+    stream >> rows >> cols >> fleetSize >> nRides >> bonus >> maxTime;
+    std::shared_ptr<InputData> result(new InputData(rows, cols, fleetSize, nRides, bonus,
+                                      maxTime, stream));
+
+    stream.exceptions(exceptions);
+    return result;
+};
+
+std::shared_ptr<InputData> InputData::genFromSnapshot(std::istream& stream) {
+    const std::ios_base::iostate exceptions = stream.exceptions();
+    stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    stream.read(magic, sizeof(magic));
+
+    if(!std::equal(magic, magic + sizeof(magic), SNAPSHOT_MAGIC)) {
+        throw std::ios_base::failure("Not a snapshot");
+    }
+
+    std::uint32_t header[6];
+    stream.read(reinterpret_cast<char*>(header), sizeof(header));
+
+    // the rides fill the rest of the snapshot, a forged number of rides allocates nothing
+    const std::streampos ridesStart = stream.tellg();
+    stream.seekg(0, std::ios_base::end);
+    const std::streamoff ridesSize = stream.tellg() - ridesStart;
+    stream.seekg(ridesStart);
+
+    if(static_cast<std::uint64_t>(ridesSize) != static_cast<std::uint64_t>(header[3]) *
+       SNAPSHOT_RIDE_VALUES * sizeof(std::int32_t)) {
+        throw std::ios_base::failure("Snapshot size doesn't match its number of rides");
+    }
+
+    std::shared_ptr<InputData> result(new InputData(header[0], header[1], header[2],
+                                      header[3], header[4], header[5]));
+
+    std::vector<std::int32_t> rides(static_cast<std::size_t>(result->nRides) *
+                                    SNAPSHOT_RIDE_VALUES);
+    stream.read(reinterpret_cast<char*>(rides.data()), rides.size() * sizeof(std::int32_t));
+
+    for(unsigned i = 0; i < result->nRides; ++i) {
+        const std::int32_t* ride = &rides[static_cast<std::size_t>(i) * SNAPSHOT_RIDE_VALUES];
+        result->startX(i) = ride[0];
+        result->startY(i) = ride[1];
+        result->endX(i) = ride[2];
+        result->endY(i) = ride[3];
+        result->startT(i) = ride[4];
+        result->endT(i) = ride[5];
+        result->distances(i) = std::abs(ride[0] - ride[2]) + std::abs(ride[1] - ride[3]);
+    }
+
+    stream.exceptions(exceptions);
+    return result;
+};
+
+void InputData::writeSnapshot(std::ostream& stream) const {
+    const std::ios_base::iostate exceptions = stream.exceptions();
+    stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
+    const std::uint32_t header[6] = {rows, cols, fleetSize, nRides, bonus, maxTime};
+    stream.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    std::vector<std::int32_t> rides(static_cast<std::size_t>(nRides) * SNAPSHOT_RIDE_VALUES);
 
-    return std::shared_ptr<InputData>(new InputData(rows, cols, fleetSize, nRides, bonus,
-                                      maxTime, inFile));
+    for(unsigned i = 0; i < nRides; ++i) {
+        std::int32_t* ride = &rides[static_cast<std::size_t>(i) * SNAPSHOT_RIDE_VALUES];
+        ride[0] = startX(i);
+        ride[1] = startY(i);
+        ride[2] = endX(i);
+        ride[3] = endY(i);
+        ride[4] = startT(i);
+        ride[5] = endT(i);
+    }
+
+    stream.write(reinterpret_cast<const char*>(rides.data()), rides.size() * sizeof(std::int32_t));
+    stream.exceptions(exceptions);
+};
+
+std::shared_ptr<InputData> InputData::genFromRides(const InputData& inputData,
+        const std::vector<unsigned>& rides, const unsigned fleetSize) {
+    std::shared_ptr<InputData> result(new InputData(inputData.rows, inputData.cols, fleetSize,
+                                      rides.size(), inputData.bonus, inputData.maxTime));
+
+    for(unsigned i = 0; i < rides.size(); ++i) {
+        result->startX(i) = inputData.startX(rides[i]);
+        result->startY(i) = inputData.startY(rides[i]);
+        result->endX(i) = inputData.endX(rides[i]);
+        result->endY(i) = inputData.endY(rides[i]);
+        result->startT(i) = inputData.startT(rides[i]);
+        result->endT(i) = inputData.endT(rides[i]);
+        result->distances(i) = inputData.distances(rides[i]);
+    }
+
+    return result;
+};
+
+std::shared_ptr<InputData> InputData::genFromValues(const unsigned rows, const unsigned cols,
+        const unsigned fleetSize, const unsigned bonus, const unsigned maxTime,
+        const std::vector<int>& rides) {
+    if(rides.size() % SNAPSHOT_RIDE_VALUES != 0) {
+        throw std::invalid_argument("Incomplete ride values");
+    }
+
+    std::shared_ptr<InputData> result(new InputData(rows, cols, fleetSize,
+                                      rides.size() / SNAPSHOT_RIDE_VALUES, bonus, maxTime));
+
+    for(unsigned i = 0; i < result->nRides; ++i) {
+        const int* ride = &rides[static_cast<std::size_t>(i) * SNAPSHOT_RIDE_VALUES];
+        result->startX(i) = ride[0];
+        result->startY(i) = ride[1];
+        result->endX(i) = ride[2];
+        result->endY(i) = ride[3];
+        result->startT(i) = ride[4];
+        result->endT(i) = ride[5];
+        result->distances(i) = std::abs(ride[0] - ride[2]) + std::abs(ride[1] - ride[3]);
+    }
+
+    return result;
+};
+
+void InputData::write(std::ostream& stream) const {
+    stream << rows << ' ' << cols << ' ' << fleetSize << ' ' << nRides << ' ' << bonus << ' '
+           << maxTime << '\n';
+
+    for(unsigned i = 0; i < nRides; ++i) {
+        stream << startX(i) << ' ' << startY(i) << ' ' << endX(i) << ' ' << endY(i) << ' '
+               << startT(i) << ' ' << endT(i) << '\n';
+    }
 };
 
 InputData::InputData(
@@ -19,13 +170,22 @@ InputData::InputData(
     const unsigned fleetSize,
     const unsigned nRides,
     const unsigned bonus,
-    const unsigned maxTime,
-    std::fstream& inFile
+    const unsigned maxTime
 ):
     rows(rows), cols(cols), fleetSize(fleetSize), nRides(nRides), bonus(bonus),
     maxTime(maxTime), startX({nRides}), startY({nRides}), endX({nRides}),
-endY({nRides}), startT({nRides}), endT({nRides}), distances({nRides}) {
-    for(unsigned short i = 0; i < nRides; i++) {
+endY({nRides}), startT({nRides}), endT({nRides}), distances({nRides}) {};
+
+InputData::InputData(
+    const unsigned rows,
+    const unsigned cols,
+    const unsigned fleetSize,
+    const unsigned nRides,
+    const unsigned bonus,
+    const unsigned maxTime,
+    std::istream& inFile
+): InputData(rows, cols, fleetSize, nRides, bonus, maxTime) {
+    for(unsigned i = 0; i < nRides; i++) {
         inFile >> startX(i) >> startY(i);
         inFile >> endX(i) >> endY(i);
         inFile >> startT(i) >> endT(i);
@@ -2,8 +2,11 @@
 #define INPUTDATA_H
 
 #include <fstream>
+#include <istream>
+#include <ostream>
 #include <string>
 #include <memory>
+#include <vector>
 #include "Tensor.hpp"
 
 /**
@@ -14,8 +17,12 @@
  */
 struct InputData {
 
+    /** First bytes of a binary snapshot (see InputData::writeSnapshot). */
+    static constexpr char SNAPSHOT_MAGIC[8] = {'R', 'D', 'S', 'N', 'A', 'P', '0', '1'};
+
     /**
      * Given a valid path to an input file, this method creates a InputData representation of it.
+     * Binary snapshots are detected by InputData::SNAPSHOT_MAGIC.
      * \note no format checks on the file are performed.
      *
      * \param [in] path Path to input file
@@ -24,6 +31,72 @@ struct InputData {
      */
     static std::shared_ptr<InputData> genFromFile(const std::string path);
 
+    /**
+     * Creates an InputData from the text representation of an input file.
+     * \note no format checks are performed.
+     *
+     * \param [in,out] stream stream positioned at the start of the input
+     * \throw std::ios_base::failure if the stream ends early or contains no numbers
+     * \return std::shared_ptr<InputData> generated object
+     */
+    static std::shared_ptr<InputData> genFromStream(std::istream& stream);
+
+    /**
+     * Creates an InputData from a binary snapshot (see InputData::writeSnapshot).
+     *
+     * \param [in,out] stream seekable stream positioned at the start of the snapshot
+     * \throw std::ios_base::failure if the stream isn't a snapshot or the size of the rest of
+     *        the stream doesn't match the number of rides
+     * \return std::shared_ptr<InputData> generated object
+     */
+    static std::shared_ptr<InputData> genFromSnapshot(std::istream& stream);
+
+    /**
+     * Writes a binary snapshot, which is read without parsing numbers:
+     * InputData::SNAPSHOT_MAGIC, rows, cols, fleetSize, nRides, bonus and maxTime as 32 bit
+     * unsigned integers, then startX, startY, endX, endY, startT and endT of each ride as
+     * 32 bit signed integers (native byte order).
+     *
+     * \param [out] stream stream the snapshot is written to
+     * \throw std::ios_base::failure if the stream can't be written
+     */
+    void writeSnapshot(std::ostream& stream) const;
+
+    /**
+     * Creates an InputData from the values of all rides, e.g. of a synthetic instance.
+     *
+     * \param [in] rows Rows of the road network
+     * \param [in] cols Columns of road network
+     * \param [in] fleetSize number of cars available
+     * \param [in] bonus Bonus for in time arivals
+     * \param [in] maxTime Steps of the simulation
+     * \param [in] rides startX, startY, endX, endY, startT and endT of each ride
+     * \throw std::invalid_argument if the number of values isn't a multiple of 6
+     * \return std::shared_ptr<InputData> generated object
+     */
+    static std::shared_ptr<InputData> genFromValues(const unsigned rows, const unsigned cols,
+            const unsigned fleetSize, const unsigned bonus, const unsigned maxTime,
+            const std::vector<int>& rides);
+
+    /**
+     * Writes the InputData in the format of the input file.
+     *
+     * \param [out] stream stream the input is written to
+     */
+    void write(std::ostream& stream) const;
+
+    /**
+     * Creates the InputData of a subproblem with a subset of the rides and its own fleet.
+     * The grid, bonus and number of steps are the same as in the given InputData.
+     *
+     * \param [in] inputData InputData of the whole problem
+     * \param [in] rides indices of the rides taken over (ride i of the result is rides[i])
+     * \param [in] fleetSize number of cars of the subproblem
+     * \return std::shared_ptr<InputData> generated object
+     */
+    static std::shared_ptr<InputData> genFromRides(const InputData& inputData,
+            const std::vector<unsigned>& rides, const unsigned fleetSize);
+
     /**
      * Returns a string represenation of the input data.
      *
@@ -60,6 +133,25 @@ struct InputData {
 
 private:
 
+    /**
+     * Creates an instance with uninitialized rides.
+     *
+     * \param [in] rows Rows of the road network
+     * \param [in] cols Columns of road network
+     * \param [in] fleetSize number of cars available
+     * \param [in] nRides number of rides to be assigned
+     * \param [in] bonus Bonus for in time arivals
+     * \param [in] maxTime Steps of the simulation
+     */
+    InputData(
+        const unsigned rows,
+        const unsigned cols,
+        const unsigned fleetSize,
+        const unsigned nRides,
+        const unsigned bonus,
+        const unsigned maxTime
+    );
+
     /**
      * Used by InputData::genFromFile to create an instance.
      *
@@ -79,7 +171,7 @@ private:
         const unsigned nRides,
         const unsigned bonus,
         const unsigned maxTime,
-        std::fstream& file
+        std::istream& file
     );
 
 };
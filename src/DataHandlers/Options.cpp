@@ -0,0 +1,191 @@
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "Options.hpp"
+
+/**
+ * Splits a comma separated list.
+ *
+ * \param [in] name name of the option (used for error messages)
+ * \param [in] value comma separated list
+ * \throw std::invalid_argument if an element of the list is empty
+ * \return std::vector<std::string> elements of the list
+ */
+static std::vector<std::string> parseList(const std::string& name, const std::string& value) {
+    std::vector<std::string> result;
+    std::istringstream stream(value);
+    std::string element;
+
+    while(std::getline(stream, element, ',')) {
+        if(element.empty()) {
+            throw std::invalid_argument("Invalid value for " + name + ": " + value);
+        }
+
+        result.push_back(element);
+    }
+
+    return result;
+}
+
+Options Options::genFromArgs(const int argc, const char* const argv[]) {
+    Options options;
+    std::vector<std::string> positional;
+
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+
+        if(arg.compare(0, 2, "--") != 0) {
+            positional.push_back(arg);
+            continue;
+        }
+
+        if(i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for " + arg);
+        }
+
+        const std::string value = argv[++i];
+
+        if(arg == "--time-limit") {
+            options.timeLimit = parseValue<double>(arg, value);
+        } else if(arg == "--threads") {
+            options.threads = parseValue<unsigned>(arg, value);
+        } else if(arg == "--deadline") {
+            options.deadline = parseValue<double>(arg, value);
+        } else if(arg == "--checkpoint-interval") {
+            options.checkpointInterval = parseValue<double>(arg, value);
+        } else if(arg == "--scoring") {
+            options.scoring = value;
+        } else if(arg == "--dispatch-window") {
+            options.dispatchWindow = parseValue<int>(arg, value);
+        } else if(arg == "--horizon") {
+            options.horizon = parseValue<int>(arg, value);
+        } else if(arg == "--stream-lead") {
+            options.streamLead = parseValue<int>(arg, value);
+        } else if(arg == "--regions") {
+            options.regions = parseValue<unsigned>(arg, value);
+        } else if(arg == "--time-slices") {
+            options.timeSlices = parseValue<unsigned>(arg, value);
+        } else if(arg == "--flow-chain") {
+            options.flowChain = parseValue<unsigned>(arg, value);
+        } else if(arg == "--successors") {
+            options.successors = parseValue<unsigned>(arg, value);
+        } else if(arg == "--successor-cache") {
+            options.successorCache = value;
+        } else if(arg == "--lookahead") {
+            options.lookahead = parseValue<double>(arg, value);
+        } else if(arg == "--dual-pruning") {
+            options.dualPruning = value == "exact" ? std::numeric_limits<double>::infinity() :
+                                  parseValue<double>(arg, value);
+        } else if(arg == "--greedy-columns") {
+            options.greedyColumns = parseValue<unsigned>(arg, value);
+        } else if(arg == "--auction-bids") {
+            options.auctionBids = parseValue<unsigned>(arg, value);
+        } else if(arg == "--rlap-deadline") {
+            options.rlapDeadline = parseValue<double>(arg, value);
+        } else if(arg == "--chain-length") {
+            options.chainLength = parseValue<unsigned>(arg, value);
+        } else if(arg == "--chain-gap") {
+            options.chainGap = parseValue<int>(arg, value);
+        } else if(arg == "--batch") {
+            options.batchDirectory = value;
+        } else if(arg == "--serve") {
+            options.servePath = value;
+        } else if(arg == "--queue-size") {
+            options.queueSize = parseValue<unsigned>(arg, value);
+        } else if(arg == "--idle-timeout") {
+            options.idleTimeout = parseValue<double>(arg, value);
+        } else if(arg == "--max-payload") {
+            options.maxPayload = parseValue<unsigned long>(arg, value);
+        } else if(arg == "--portfolio") {
+            options.portfolio = parseList(arg, value);
+        } else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+
+    if(!options.servePath.empty()) {
+        if(!positional.empty()) {
+            throw std::invalid_argument("Serve mode takes no input or output path.");
+        }
+
+        return options;
+    }
+
+    if(!options.batchDirectory.empty()) {
+        if(positional.empty()) {
+            throw std::invalid_argument("No input paths set.");
+        }
+
+        options.inputPaths = positional;
+        return options;
+    }
+
+    if(positional.size() != 2) {
+        throw std::invalid_argument("No input path and output path set.");
+    }
+
+    options.inputPath = positional[0];
+    options.outputPath = positional[1];
+    return options;
+}
+
+std::string Options::usage() {
+    return
+        "Usage: RideDistributor [options] <input path> <output path>\n"
+        "       RideDistributor [options] --batch <output directory> <input>...\n"
+        "       RideDistributor [options] --serve <socket path>\n"
+        "Options:\n"
+        "  --time-limit <seconds>  improve the solution by simulated annealing\n"
+        "  --threads <n>           number of threads (default: one per core)\n"
+        "  --deadline <seconds>    anytime mode: always exit before the deadline,\n"
+        "                          the best solution so far is written periodically\n"
+        "                          and on SIGTERM\n"
+        "  --checkpoint-interval <seconds>\n"
+        "                          seconds between two writes in anytime mode (10)\n"
+        "  --scoring <name>        scoring heuristic of the generator: time-left,\n"
+        "                          points, idle-penalty, weighted-bonus or\n"
+        "                          next-cluster (time-left)\n"
+        "  --dispatch-window <steps>\n"
+        "                          event-driven dispatch: assign rides to batches of\n"
+        "                          cars free within the given steps\n"
+        "  --horizon <steps>       only rides starting within the given steps after\n"
+        "                          the earliest car are considered (0: adaptive)\n"
+        "  --stream-lead <steps>   online mode: replay the input as a stream of rides\n"
+        "                          revealed the given steps before their start\n"
+        "  --regions <n>           decomposition: solve n x n regions of the grid\n"
+        "                          independently in parallel\n"
+        "  --time-slices <n>       decomposition: number of time slices solved one\n"
+        "                          after another (1)\n"
+        "  --flow-chain <k>        assign chains of up to k rides to each car per\n"
+        "                          step by a min-cost flow\n"
+        "  --successors <m>        build the graph of the m best successors of each\n"
+        "                          ride at load time\n"
+        "  --successor-cache <path>\n"
+        "                          read the successor graph from the file, or build\n"
+        "                          it and write it to the file\n"
+        "  --lookahead <weight>    add the weighted value of the best follow-up ride\n"
+        "                          to the scores of the generator\n"
+        "  --dual-pruning <slack>  remove RLAP columns whose reduced costs exceed the\n"
+        "                          slack or the proven gap (exact: only the gap)\n"
+        "  --greedy-columns <n>    solve RLAPs with at least n columns by greedy\n"
+        "                          regret instead of exactly\n"
+        "  --auction-bids <n>      polish greedy regret solutions by up to n bids\n"
+        "  --rlap-deadline <seconds>\n"
+        "                          budget of each RLAP, rows left when it expires\n"
+        "                          are assigned greedily\n"
+        "  --chain-length <n>      merge up to n rides that fit together back-to-back\n"
+        "                          into composite jobs before the assignment\n"
+        "  --chain-gap <steps>     maximal idle time between two rides of a job (20)\n"
+        "  --batch <directory>     solve all inputs (paths or patterns like *.in) on a\n"
+        "                          thread pool, largest first, and write <name>.out\n"
+        "                          files to the directory\n"
+        "  --serve <socket path>   daemon mode: solve instances sent over a Unix\n"
+        "                          domain socket, one connection per thread\n"
+        "  --queue-size <n>        serve mode: connections waiting for a thread (64)\n"
+        "  --idle-timeout <seconds>\n"
+        "                          serve mode: close connections idle this long (60)\n"
+        "  --max-payload <bytes>   serve mode: maximal size of an instance (64 MiB)\n"
+        "  --portfolio <names>     run a comma separated list of scoring heuristics\n"
+        "                          (or all) concurrently and keep the best result\n";
+}
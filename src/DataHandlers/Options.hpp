@@ -0,0 +1,123 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Command line options of RideDistributor.
+ *
+ * \code
+ * RideDistributor [options] <input path> <output path>
+ * RideDistributor [options] --batch <output directory> <input path or pattern>...
+ * RideDistributor [options] --serve <socket path>
+ * \endcode
+ */
+struct Options {
+
+    /**
+     * Parses the command line arguments.
+     *
+     * \param [in] argc number of arguments
+     * \param [in] argv arguments (first one is the program name)
+     * \throw std::invalid_argument if an option is unknown, misses its value or
+     *        the input or output path is missing (batch mode: no input path,
+     *        serve mode: any path)
+     * \return Options parsed options
+     */
+    static Options genFromArgs(const int argc, const char* const argv[]);
+
+    /**
+     * Returns a description of all options.
+     *
+     * \return std::string usage text
+     */
+    static std::string usage();
+
+    /**
+     * Converts the value of an option (also used by the other command line tools).
+     *
+     * \param [in] name name of the option (used for error messages)
+     * \param [in] value string representation of the value
+     * \throw std::invalid_argument if the value can't be converted (or is negative for an
+     *        unsigned type, which the stream would wrap around)
+     * \return T converted value
+     */
+    template<typename T>
+    static T parseValue(const std::string& name, const std::string& value) {
+        std::istringstream stream(value);
+        T result;
+        const std::size_t first = value.find_first_not_of(" \t");
+        const bool negative = first != std::string::npos && value[first] == '-';
+
+        if(!(stream >> result) || !stream.eof() || (std::is_unsigned<T>::value && negative)) {
+            throw std::invalid_argument("Invalid value for " + name + ": " + value);
+        }
+
+        return result;
+    }
+
+    /** Path of the input file. */
+    std::string inputPath;
+    /** Path of the output file. */
+    std::string outputPath;
+    /** Batch mode: directory the solutions are written to (empty: disabled). */
+    std::string batchDirectory;
+    /** Batch mode: paths or wildcard patterns of all input files. */
+    std::vector<std::string> inputPaths;
+    /** Serve mode: path of the Unix domain socket (empty: disabled). */
+    std::string servePath;
+    /** Serve mode: maximum number of connections waiting for a worker. */
+    unsigned queueSize = 64;
+    /** Serve mode: seconds a connection may be idle before it's closed (0: never). */
+    double idleTimeout = 60;
+    /** Serve mode: maximal number of bytes of an instance sent in a request. */
+    unsigned long maxPayload = 1ul << 26;
+    /** Seconds spent improving the solution by simulated annealing (0: disabled). */
+    double timeLimit = 0;
+    /** Number of threads used by parallel stages (0: one per core). */
+    unsigned threads = 0;
+    /** Wall-clock budget of the whole run in seconds (anytime mode, 0: disabled). */
+    double deadline = 0;
+    /** Minimal seconds between two writes of the best solution in anytime mode. */
+    double checkpointInterval = 10;
+    /** Name of the scoring heuristic of the generator. */
+    std::string scoring = "time-left";
+    /** Event-driven dispatch: cars free within this many steps form a batch (-1: rounds). */
+    int dispatchWindow = -1;
+    /** Columns are rides starting within this many steps (-1: all rides, 0: adaptive). */
+    int horizon = -1;
+    /** Online mode: rides are revealed this many steps before their start (-1: offline). */
+    int streamLead = -1;
+    /** Decomposition: the grid is split into regions x regions subproblems (1: disabled). */
+    unsigned regions = 1;
+    /** Decomposition: number of time slices solved one after another. */
+    unsigned timeSlices = 1;
+    /** Min-cost flow: rides assigned to each car per step (0: disabled). */
+    unsigned flowChain = 0;
+    /** Successors per ride of the successor graph built at load time (0: not built). */
+    unsigned successors = 0;
+    /** Cache file of the successor graph (empty: not cached). */
+    std::string successorCache;
+    /** Weight of the two-step lookahead in the scores of the generator (0: disabled). */
+    double lookahead = 0;
+    /** Maximal reduced cost of the RLAP columns (negative: disabled, infinity: exact). */
+    double dualPruning = -1;
+    /** RLAPs with at least this many columns are solved approximately (0: all exactly). */
+    unsigned greedyColumns = 0;
+    /** Maximal number of bids polishing an approximately solved RLAP (0: no polish). */
+    unsigned auctionBids = 0;
+    /** Budget of each exactly solved RLAP in seconds (0: no deadline). */
+    double rlapDeadline = 0;
+    /** Maximal number of rides merged into a composite job (1: rides aren't chained). */
+    unsigned chainLength = 1;
+    /** Maximal idle time between two rides of a composite job. */
+    int chainGap = 20;
+    /** Scoring heuristics run concurrently ("all": every heuristic, empty: disabled). */
+    std::vector<std::string> portfolio;
+};
+
+#endif // OPTIONS_H
@@ -1,56 +1,44 @@
-#include <fstream>
 #include "SearchGraphNode.hpp"
 
 void SearchGraphNode::writeToFile(const std::string path,
                                   const unsigned fleetSize) const {
-    std::fstream outFile;
-    outFile.exceptions(std::fstream::failbit | std::fstream::badbit);
-    std::vector<std::list<unsigned>> data = createDataStructure(fleetSize);
-
-    outFile.open(path, std::fstream::out);
-
-    for(auto car : data) {
-        outFile << car.size();
-
-        if(car.size() > 0) {
-            outFile << ' ';
-        }
+    toSolution(fleetSize).writeToFile(path);
+}
 
-        unsigned rideCount = 0;
+Solution SearchGraphNode::toSolution(const unsigned fleetSize) const {
+    Solution solution(fleetSize);
+    // nodes ordered from this node to the root
+    std::vector<const SearchGraphNode*> path;
 
-        for(auto ride : car) {
-            outFile << ride;
+    for(const SearchGraphNode* current = this; current; current = current->parent.get()) {
+        path.push_back(current);
+    }
 
-            if(rideCount < car.size() - 1) {
-                outFile << ' ';
-            }
+    // append values starting at the root so that rides keep their order
+    for(auto node = path.rbegin(); node != path.rend(); ++node) {
+        const Tensor<unsigned>& value = *(*node)->value;
 
-            ++rideCount;
+        for(unsigned row = 0; value.getSize() > 0 && row < value.getDims()[0]; ++row) {
+            solution.routes[value(row, 0)].push_back(value(row, 1));
         }
-
-        outFile << std::endl;
     }
-}
-
-std::vector<std::list<unsigned>> SearchGraphNode::createDataStructure(
-const unsigned fleetSize) const {
 
-    std::vector<std::list<unsigned>> data(fleetSize, std::list<unsigned>());
+    return solution;
+}
 
-    for(unsigned row = 0; value->getSize() > 0 && row < value->getDims()[0]; ++row) {
-        data[(*value)(row, 0)].push_front((*value)(row, 1));
-    }
+Solution SearchGraphNode::toSolution(const unsigned fleetSize,
+                                     const std::vector<std::vector<unsigned>>& jobs) const {
+    Solution solution = toSolution(fleetSize);
 
-    std::shared_ptr<const SearchGraphNode> current_node = parent;
+    for(std::vector<unsigned>& route : solution.routes) {
+        std::vector<unsigned> rides;
 
-    while(current_node) {
-        for(unsigned row = 0; current_node->value->getSize() > 0 &&
-            row < current_node->value->getDims()[0]; ++row) {
-            data[(*current_node->value)(row, 0)].push_front((*current_node->value)(row, 1));
+        for(const unsigned job : route) {
+            rides.insert(rides.end(), jobs[job].begin(), jobs[job].end());
         }
 
-        current_node = current_node->parent;
+        route.swap(rides);
     }
 
-    return data;
+    return solution;
 }
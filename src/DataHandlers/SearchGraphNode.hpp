@@ -4,8 +4,8 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <list>
 #include "Tensor.hpp"
+#include "Solution.hpp"
 
 /**
  * Node of the search tree that is created when exploring various car-ride distributions.
@@ -40,6 +40,25 @@ public:
      */
     void writeToFile(const std::string path, const unsigned fleetSize) const;
 
+    /**
+     * Creates the routes of all cars while traversing parent nodes.
+     *
+     * \param [in] fleetSize number of routes in the solution
+     * \return Solution each route represents a car and its rides
+     */
+    Solution toSolution(const unsigned fleetSize) const;
+
+    /**
+     * Creates the routes of all cars if the values of the nodes are composite jobs
+     * (see RideChains), each job is replaced by its rides.
+     *
+     * \param [in] fleetSize number of routes in the solution
+     * \param [in] jobs rides of each job in the order they are taken
+     * \return Solution each route represents a car and its rides
+     */
+    Solution toSolution(const unsigned fleetSize,
+                        const std::vector<std::vector<unsigned>>& jobs) const;
+
 private:
 
     /** Parent node. */
@@ -48,14 +67,6 @@ private:
     /** Value of this node. */
     std::unique_ptr<Tensor<unsigned>> value;
 
-    /**
-     * Creates a 2D vector of values while traversing parent nodes.
-     *
-     * \param [in] fleetSize number of vectors in 2D-vector
-     * \return std::vector<std::list<int>> each list represents a car and its rides
-     */
-    std::vector<std::list<unsigned>> createDataStructure(const unsigned fleetSize) const;
-
 };
 
 #endif // SEARCH_GRAPH_NODE_H
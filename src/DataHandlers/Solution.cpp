@@ -0,0 +1,34 @@
+#include <fstream>
+#include "Solution.hpp"
+
+void Solution::writeToFile(const std::string path) const {
+    std::fstream outFile;
+    outFile.exceptions(std::fstream::failbit | std::fstream::badbit);
+
+    outFile.open(path, std::fstream::out);
+    write(outFile);
+}
+
+void Solution::write(std::ostream& stream) const {
+    for(const auto& car : routes) {
+        stream << car.size();
+
+        if(car.size() > 0) {
+            stream << ' ';
+        }
+
+        unsigned rideCount = 0;
+
+        for(auto ride : car) {
+            stream << ride;
+
+            if(rideCount < car.size() - 1) {
+                stream << ' ';
+            }
+
+            ++rideCount;
+        }
+
+        stream << '\n';
+    }
+}
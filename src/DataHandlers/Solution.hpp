@@ -0,0 +1,43 @@
+#ifndef SOLUTION_H
+#define SOLUTION_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Representation of the output file defined by Google-HashCode's problem statement.
+ * Each car has an ordered list of the rides it takes.
+ */
+struct Solution {
+
+    /** Creates an empty solution (no rides assigned). */
+    Solution() {};
+
+    /**
+     * Creates a solution for a given amount of cars without any rides assigned.
+     *
+     * \param [in] fleetSize Number of cars
+     */
+    Solution(const unsigned fleetSize): routes(fleetSize) {};
+
+    /**
+     * Writes the routes of all cars to a specified file.
+     *
+     * \param [in] path specified file
+     * \throw std::fstream::failure if file couldn't be opened/created
+     */
+    void writeToFile(const std::string path) const;
+
+    /**
+     * Writes the routes of all cars in the format of the output file.
+     *
+     * \param [out] stream stream the routes are written to
+     */
+    void write(std::ostream& stream) const;
+
+    /** Ordered list of ride indices for each car. */
+    std::vector<std::vector<unsigned>> routes;
+};
+
+#endif // SOLUTION_H
@@ -0,0 +1,299 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <utility>
+#include <unistd.h>
+#include "SuccessorGraph.hpp"
+
+/** Rides a thread takes from the shared counter at once. */
+static constexpr unsigned CHUNK_SIZE = 256;
+
+/** Number of 32 bit values in the header of a cached graph. */
+static constexpr unsigned CACHE_HEADER_VALUES = 3;
+
+SuccessorGraph::SuccessorGraph(const unsigned maxSuccessors, const std::uint64_t fingerprint):
+    maxSuccessors(maxSuccessors), inputFingerprint(fingerprint) {}
+
+std::uint64_t SuccessorGraph::fingerprint(const InputData& inputData) {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](const std::uint32_t value) {
+        for(unsigned byte = 0; byte < 4; ++byte) {
+            hash = (hash ^ ((value >> (8 * byte)) & 0xff)) * 1099511628211ull;
+        }
+    };
+
+    for(const unsigned value : {inputData.rows, inputData.cols, inputData.fleetSize,
+                                inputData.nRides, inputData.bonus, inputData.maxTime}) {
+        add(value);
+    }
+
+    for(unsigned i = 0; i < inputData.nRides; ++i) {
+        for(const int value : {inputData.startX(i), inputData.startY(i), inputData.endX(i),
+                               inputData.endY(i), inputData.startT(i), inputData.endT(i)}) {
+            add(static_cast<std::uint32_t>(value));
+        }
+    }
+
+    return hash;
+}
+
+std::shared_ptr<SuccessorGraph> SuccessorGraph::genFromInput(const InputData& inputData,
+        const unsigned maxSuccessors, const unsigned nThreads) {
+    std::shared_ptr<SuccessorGraph> result(new SuccessorGraph(maxSuccessors,
+                                           fingerprint(inputData)));
+    const unsigned nRides = inputData.nRides;
+
+    // rides ordered by earliest start
+    std::vector<unsigned> order(nRides);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](const unsigned a, const unsigned b) {
+        return inputData.startT(a) < inputData.startT(b) ||
+               (inputData.startT(a) == inputData.startT(b) && a < b);
+    });
+    std::vector<int> starts(nRides);
+
+    for(unsigned i = 0; i < nRides; ++i) {
+        starts[i] = inputData.startT(order[i]);
+    }
+
+    // each ride fills M slots first, the slots are compacted afterwards
+    const std::size_t slots = static_cast<std::size_t>(nRides) * maxSuccessors;
+    std::vector<std::uint32_t> slotRides(slots), slotDistances(slots), slotSlacks(slots);
+    std::vector<std::uint32_t> counts(nRides, 0);
+    std::atomic<unsigned> next(0);
+
+    auto work = [&]() {
+        // bounded max-heap of (idle time, successor)
+        std::vector<std::pair<long, unsigned>> heap;
+
+        for(unsigned first = next.fetch_add(CHUNK_SIZE); first < nRides;
+            first = next.fetch_add(CHUNK_SIZE)) {
+            const unsigned last = std::min(nRides, first + CHUNK_SIZE);
+
+            for(unsigned ride = first; ride < last; ++ride) {
+                const int finish = inputData.startT(ride) + inputData.distances(ride);
+                heap.clear();
+
+                auto offer = [&](const unsigned successor) {
+                    if(successor == ride) {return;}
+
+                    const int distance = std::abs(inputData.endX(ride) -
+                                                  inputData.startX(successor)) +
+                                         std::abs(inputData.endY(ride) -
+                                                  inputData.startY(successor));
+                    const int arrival = finish + distance;
+                    const int slack = inputData.endT(successor) -
+                                      inputData.distances(successor) - arrival;
+
+                    if(slack < 0) {return;}
+
+                    const std::pair<long, unsigned> entry(
+                        std::max(distance, inputData.startT(successor) - finish), successor);
+
+                    if(heap.size() < maxSuccessors) {
+                        heap.push_back(entry);
+                        std::push_heap(heap.begin(), heap.end());
+                    } else if(entry < heap.front()) {
+                        std::pop_heap(heap.begin(), heap.end());
+                        heap.back() = entry;
+                        std::push_heap(heap.begin(), heap.end());
+                    }
+                };
+
+                if(maxSuccessors == 0) {continue;}
+
+                // rides starting after the finish are idle for at least the difference
+                const unsigned split = std::lower_bound(starts.begin(), starts.end(), finish) -
+                                       starts.begin();
+
+                for(unsigned i = split; i < nRides; ++i) {
+                    if(heap.size() == maxSuccessors && starts[i] - finish > heap.front().first) {
+                        break;
+                    }
+
+                    offer(order[i]);
+                }
+
+                const unsigned lateEnd = split > LATE_SCAN ? split - LATE_SCAN : 0;
+
+                for(unsigned i = split; i-- > lateEnd;) {
+                    offer(order[i]);
+                }
+
+                std::sort_heap(heap.begin(), heap.end());
+                const std::size_t base = static_cast<std::size_t>(ride) * maxSuccessors;
+
+                for(unsigned k = 0; k < heap.size(); ++k) {
+                    const unsigned successor = heap[k].second;
+                    const int distance = std::abs(inputData.endX(ride) -
+                                                  inputData.startX(successor)) +
+                                         std::abs(inputData.endY(ride) -
+                                                  inputData.startY(successor));
+                    slotRides[base + k] = successor;
+                    slotDistances[base + k] = distance;
+                    slotSlacks[base + k] = inputData.endT(successor) -
+                                           inputData.distances(successor) - finish - distance;
+                }
+
+                counts[ride] = heap.size();
+            }
+        }
+    };
+
+    unsigned nWorkers = nThreads > 0 ? nThreads :
+                        std::max(1u, std::thread::hardware_concurrency());
+    nWorkers = std::max(1u, std::min(nWorkers, (nRides + CHUNK_SIZE - 1) / CHUNK_SIZE));
+    std::vector<std::thread> threads;
+
+    for(unsigned i = 1; i < nWorkers; ++i) {
+        threads.emplace_back(work);
+    }
+
+    work();
+
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+
+    result->offsets.resize(nRides + 1);
+    result->offsets[0] = 0;
+
+    for(unsigned ride = 0; ride < nRides; ++ride) {
+        result->offsets[ride + 1] = result->offsets[ride] + counts[ride];
+    }
+
+    const std::size_t nEdges = result->offsets[nRides];
+    result->rides.resize(nEdges);
+    result->distances.resize(nEdges);
+    result->slacks.resize(nEdges);
+
+    for(unsigned ride = 0; ride < nRides; ++ride) {
+        const std::size_t base = static_cast<std::size_t>(ride) * maxSuccessors;
+        const std::size_t begin = result->offsets[ride];
+        std::copy_n(slotRides.data() + base, counts[ride], result->rides.data() + begin);
+        std::copy_n(slotDistances.data() + base, counts[ride], result->distances.data() + begin);
+        std::copy_n(slotSlacks.data() + base, counts[ride], result->slacks.data() + begin);
+    }
+
+    return result;
+}
+
+std::shared_ptr<SuccessorGraph> SuccessorGraph::genFromStream(std::istream& stream,
+        const InputData& inputData) {
+    const std::ios_base::iostate exceptions = stream.exceptions();
+    stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
+    char magic[sizeof(CACHE_MAGIC)];
+    stream.read(magic, sizeof(magic));
+
+    if(!std::equal(magic, magic + sizeof(magic), CACHE_MAGIC)) {
+        throw std::ios_base::failure("Not a successor graph");
+    }
+
+    std::uint32_t header[CACHE_HEADER_VALUES];
+    std::uint64_t storedFingerprint;
+    stream.read(reinterpret_cast<char*>(header), sizeof(header));
+    stream.read(reinterpret_cast<char*>(&storedFingerprint), sizeof(storedFingerprint));
+
+    if(header[0] != inputData.nRides || storedFingerprint != fingerprint(inputData)) {
+        throw std::ios_base::failure("Successor graph of another input");
+    }
+
+    // a corrupt header must not allocate more edges than a graph of the input can have
+    if(header[2] > static_cast<std::uint64_t>(header[0]) * header[1]) {
+        throw std::ios_base::failure("Corrupt successor graph");
+    }
+
+    std::shared_ptr<SuccessorGraph> result(new SuccessorGraph(header[1], storedFingerprint));
+    auto readValues = [&stream](std::vector<std::uint32_t>& values, const std::size_t size) {
+        values.resize(size);
+        stream.read(reinterpret_cast<char*>(values.data()), size * sizeof(std::uint32_t));
+    };
+
+    readValues(result->offsets, static_cast<std::size_t>(header[0]) + 1);
+
+    // the rows are accessed without checks, each has to lie within the edges
+    bool valid = result->offsets.front() == 0 && result->offsets.back() == header[2];
+
+    for(unsigned ride = 0; valid && ride < header[0]; ++ride) {
+        valid = result->offsets[ride] <= result->offsets[ride + 1] &&
+                result->offsets[ride + 1] - result->offsets[ride] <= header[1];
+    }
+
+    if(!valid) {
+        throw std::ios_base::failure("Corrupt successor graph");
+    }
+
+    readValues(result->rides, header[2]);
+    readValues(result->distances, header[2]);
+    readValues(result->slacks, header[2]);
+
+    for(const auto successor : result->rides) {
+        if(successor >= header[0]) {
+            throw std::ios_base::failure("Corrupt successor graph");
+        }
+    }
+
+    stream.exceptions(exceptions);
+    return result;
+}
+
+std::shared_ptr<SuccessorGraph> SuccessorGraph::genCached(const InputData& inputData,
+        const unsigned maxSuccessors, const std::string& path, const unsigned nThreads) {
+    std::ifstream inFile(path, std::ifstream::binary);
+
+    if(inFile) {
+        try {
+            std::shared_ptr<SuccessorGraph> cached = genFromStream(inFile, inputData);
+
+            if(cached->maxSuccessors == maxSuccessors) {return cached;}
+        } catch(const std::ios_base::failure&) {
+            // stale or broken cache, rebuilt below
+        }
+
+        inFile.close();
+    }
+
+    std::shared_ptr<SuccessorGraph> result = genFromInput(inputData, maxSuccessors, nThreads);
+    // every writer has its own temporary file in the directory of the cache, so that the
+    // rename always moves a complete graph
+    static std::atomic<unsigned> writers{0};
+    const std::string tmpPath = path + "." + std::to_string(getpid()) + "." +
+                                std::to_string(writers++) + ".tmp";
+    std::ofstream outFile;
+    outFile.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    outFile.open(tmpPath, std::ofstream::binary | std::ofstream::trunc);
+    result->write(outFile);
+    outFile.close();
+
+    // replacing the file by renaming is atomic, concurrent runs never read a partial graph
+    if(std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        throw std::fstream::failure("Can't replace " + path);
+    }
+
+    return result;
+}
+
+void SuccessorGraph::write(std::ostream& stream) const {
+    const std::ios_base::iostate exceptions = stream.exceptions();
+    stream.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
+    const std::uint32_t header[CACHE_HEADER_VALUES] = {getRideCount(), maxSuccessors,
+                                                       static_cast<std::uint32_t>(rides.size())};
+    stream.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+    stream.write(reinterpret_cast<const char*>(&inputFingerprint), sizeof(inputFingerprint));
+
+    for(const std::vector<std::uint32_t>* values : {&offsets, &rides, &distances, &slacks}) {
+        stream.write(reinterpret_cast<const char*>(values->data()),
+                     values->size() * sizeof(std::uint32_t));
+    }
+
+    stream.exceptions(exceptions);
+}
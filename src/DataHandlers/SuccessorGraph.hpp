@@ -0,0 +1,167 @@
+#ifndef SUCCESSOR_GRAPH_H
+#define SUCCESSOR_GRAPH_H
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "InputData.hpp"
+
+/**
+ * Sparse graph of the rides that can follow each ride in time.
+ *
+ * Ride s can follow ride r if a car finishing r as early as possible (started on time) can
+ * still finish s in time. For each ride the graph keeps the best M such successors, ordered by
+ * the time the car is idle in between (driving empty and waiting for the start of s), together
+ * with the transition distance from the end of r to the start of s and the slack, i.e. how
+ * many steps the car may arrive later at the start of s and still finish it in time.
+ *
+ * Successors starting before r is finished (the car would have to be late for them) are only
+ * searched among the SuccessorGraph::LATE_SCAN rides starting right before; all others are
+ * found exactly. The graph is stored in compressed sparse rows of 32 bit values and can be
+ * cached on disk (see SuccessorGraph::write).
+ */
+class SuccessorGraph {
+public:
+
+    /** First bytes of a cached graph (see SuccessorGraph::write). */
+    static constexpr char CACHE_MAGIC[8] = {'R', 'D', 'S', 'U', 'C', 'C', '0', '1'};
+
+    /** Rides starting before a ride is finished that are checked as successors. */
+    static constexpr unsigned LATE_SCAN = 256;
+
+    /** Successors of a ride, ordered by idle time. */
+    struct Successors {
+        /** Indices of the successors. */
+        const std::uint32_t* rides;
+        /** Distances from the end of the ride to the starts of the successors. */
+        const std::uint32_t* distances;
+        /** Steps the car may arrive later at the starts of the successors. */
+        const std::uint32_t* slacks;
+        /** Number of successors. */
+        unsigned size;
+    };
+
+    /**
+     * Builds the graph of the given InputData.
+     *
+     * \param [in] inputData InputData representing the simulation enviroment
+     * \param [in] maxSuccessors successors kept per ride (M)
+     * \param [in] nThreads number of threads used to build the graph (0: one per core)
+     * \return std::shared_ptr<SuccessorGraph> generated object
+     */
+    static std::shared_ptr<SuccessorGraph> genFromInput(const InputData& inputData,
+            const unsigned maxSuccessors, const unsigned nThreads = 0);
+
+    /**
+     * Reads a cached graph (see SuccessorGraph::write).
+     *
+     * \param [in,out] stream stream positioned at the start of the cached graph
+     * \param [in] inputData InputData the graph has to belong to
+     * \throw std::ios_base::failure if the stream isn't a cached graph of the given InputData,
+     *        ends early or its offsets or successors are out of range
+     * \return std::shared_ptr<SuccessorGraph> generated object
+     */
+    static std::shared_ptr<SuccessorGraph> genFromStream(std::istream& stream,
+            const InputData& inputData);
+
+    /**
+     * Reads the graph from the given cache file if it belongs to the given InputData and has
+     * the given number of successors, otherwise builds the graph and (re)writes the file.
+     * The graph is written to a temporary file next to it (named by the process id and a
+     * counter) and renamed, so concurrent runs never read a partial graph.
+     *
+     * \param [in] inputData InputData representing the simulation enviroment
+     * \param [in] maxSuccessors successors kept per ride (M)
+     * \param [in] path path of the cache file
+     * \param [in] nThreads number of threads used to build the graph (0: one per core)
+     * \throw std::fstream::failure if the cache file can't be written
+     * \return std::shared_ptr<SuccessorGraph> generated object
+     */
+    static std::shared_ptr<SuccessorGraph> genCached(const InputData& inputData,
+            const unsigned maxSuccessors, const std::string& path, const unsigned nThreads = 0);
+
+    /**
+     * Writes the graph: SuccessorGraph::CACHE_MAGIC, nRides, maxSuccessors and the number of
+     * edges as 32 bit unsigned integers, a 64 bit fingerprint of the InputData, then the row
+     * offsets, successors, distances and slacks as 32 bit unsigned integers (native byte
+     * order).
+     *
+     * \param [out] stream stream the graph is written to
+     * \throw std::ios_base::failure if the stream can't be written
+     */
+    void write(std::ostream& stream) const;
+
+    /**
+     * Successors of a ride.
+     *
+     * \param [in] ride index of the ride
+     * \return Successors successors ordered by idle time
+     */
+    Successors successors(const unsigned ride) const {
+        const std::uint32_t begin = offsets[ride];
+        return {rides.data() + begin, distances.data() + begin, slacks.data() + begin,
+                offsets[ride + 1] - begin};
+    }
+
+    /**
+     * Number of rides of the graph.
+     *
+     * \return unsigned number of rides
+     */
+    unsigned getRideCount() const {return offsets.size() - 1;}
+
+    /**
+     * Maximal number of successors per ride (M).
+     *
+     * \return unsigned successors kept per ride
+     */
+    unsigned getMaxSuccessors() const {return maxSuccessors;}
+
+    /**
+     * Number of edges of the graph.
+     *
+     * \return std::size_t number of edges
+     */
+    std::size_t getEdgeCount() const {return rides.size();}
+
+    /**
+     * Fingerprint of an InputData, stored with cached graphs.
+     *
+     * \param [in] inputData InputData representing the simulation enviroment
+     * \return std::uint64_t FNV-1a hash of the header and all rides
+     */
+    static std::uint64_t fingerprint(const InputData& inputData);
+
+private:
+
+    /**
+     * Creates an empty graph.
+     *
+     * \param [in] maxSuccessors successors kept per ride (M)
+     * \param [in] fingerprint fingerprint of the InputData
+     */
+    SuccessorGraph(const unsigned maxSuccessors, const std::uint64_t fingerprint);
+
+    /** Successors kept per ride. */
+    unsigned maxSuccessors;
+
+    /** Fingerprint of the InputData. */
+    std::uint64_t inputFingerprint;
+
+    /** Start of the successors of each ride, followed by the number of edges. */
+    std::vector<std::uint32_t> offsets;
+
+    /** Successors of all rides. */
+    std::vector<std::uint32_t> rides;
+
+    /** Transition distances of all edges. */
+    std::vector<std::uint32_t> distances;
+
+    /** Slacks of all edges. */
+    std::vector<std::uint32_t> slacks;
+};
+
+#endif // SUCCESSOR_GRAPH_H
@@ -38,7 +38,7 @@ class Tensor {
 public:
 
     /** Creates an empty Tensor. */
-    Tensor(): size(0) {};
+    Tensor(): size(0), capacity(0) {};
 
     /**
      * Creates a n-dimensional Tensor.
@@ -108,6 +108,16 @@ public:
      */
     Tensor<T>& operator=(const Tensor<T>& rhs);
 
+    /**
+     * Changes the dimensions of this Tensor. The internal data structure is only
+     * reallocated if it is too small, so a Tensor can be reused as workspace.
+     *
+     * \note The entries are not initialized after reshaping.
+     *
+     * \param [in] dims list that defines the new dimensions of this Tensor
+     */
+    void reshape(const std::vector<unsigned> dims);
+
     /**
      * Total number of elements that can be stored in this tensor.
      *
@@ -124,9 +134,12 @@ public:
 
 private:
 
-    /** Size of internal data structure. */
+    /** Number of elements (product of the dimensions). */
     unsigned size;
 
+    /** Size of internal data structure. */
+    unsigned capacity;
+
     /** Dimensions defined at initialization. */
     std::vector<unsigned> dims;
 
@@ -9,6 +9,8 @@ Tensor<T>::Tensor(const std::vector<unsigned> dims): dims(dims) {
         size *= dim;
     }
 
+    capacity = size;
+
     if(size == 0) {
         this->dims.clear();
     } else {
@@ -53,11 +55,29 @@ T& Tensor<T>::operator()(const int row, const int col, const int offset) const
 template<typename T>
 Tensor<T>& Tensor<T>::operator=(const Tensor<T>& rhs) {
     size = rhs.size;
+    capacity = rhs.capacity;
     dims = rhs.dims;
     data = rhs.data;
     return *this;
 }
 
+template<typename T>
+void Tensor<T>::reshape(const std::vector<unsigned> dims) {
+    this->dims = dims;
+    size = 1;
+
+    for(auto& dim : dims) {
+        size *= dim;
+    }
+
+    if(size == 0) {
+        this->dims.clear();
+    } else if(size > capacity) {
+        data = std::shared_ptr<T[]>(new T[size]);
+        capacity = size;
+    }
+}
+
 template<typename T>
 const unsigned Tensor<T>::getSize() const
 {return size;}
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include "RideScorer.hpp"
+
+RideScorer::RideScorer(const InputData& inputData, const unsigned nThreads):
+    inputData(inputData), nThreads(nThreads) {
+    if(this->nThreads == 0) {
+        this->nThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+RideScorer::Routes RideScorer::readFile(const std::string& path) {
+    std::ifstream file;
+    file.exceptions(std::fstream::failbit | std::fstream::badbit);
+    file.open(path, std::fstream::in | std::fstream::binary);
+
+    // one read of the whole file, parsing a buffer is much faster than formatted input
+    file.seekg(0, std::ios::end);
+    std::string text(static_cast<std::size_t>(file.tellg()), '\0');
+    file.seekg(0, std::ios::beg);
+    file.read(&text[0], text.size());
+    return parse(text.data(), text.data() + text.size());
+}
+
+RideScorer::Routes RideScorer::parse(const char* begin, const char* end) {
+    Routes routes;
+    routes.rides.reserve((end - begin) / 4);
+    const char* pos = begin;
+    unsigned line = 1;
+
+    auto skipBlanks = [&]() {
+        while(pos != end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) {++pos;}
+    };
+    auto readNumber = [&]() {
+        if(pos == end || *pos < '0' || *pos > '9') {
+            throw std::invalid_argument("Line " + std::to_string(line) + ": number expected");
+        }
+
+        unsigned long long value = 0;
+
+        for(; pos != end && *pos >= '0' && *pos <= '9'; ++pos) {
+            value = value * 10 + (*pos - '0');
+
+            if(value > 0xffffffffULL) {
+                throw std::invalid_argument("Line " + std::to_string(line) + ": number too large");
+            }
+        }
+
+        skipBlanks();
+        return static_cast<unsigned>(value);
+    };
+
+    for(skipBlanks(); pos != end; ++line) {
+        // empty lines at the end of the file are allowed
+        if(*pos == '\n') {
+            for(; pos != end && (*pos == '\n' || *pos == ' ' || *pos == '\t' || *pos == '\r');
+                ++pos) {}
+
+            if(pos != end) {
+                throw std::invalid_argument("Line " + std::to_string(line) + ": empty line");
+            }
+
+            break;
+        }
+
+        const unsigned count = readNumber();
+
+        for(unsigned i = 0; i < count; ++i) {
+            routes.rides.push_back(readNumber());
+        }
+
+        if(pos != end && *pos != '\n') {
+            throw std::invalid_argument("Line " + std::to_string(line) + ": more than " +
+                                        std::to_string(count) + " rides");
+        }
+
+        routes.offsets.push_back(routes.rides.size());
+
+        if(pos != end) {
+            ++pos;
+            skipBlanks();
+        }
+    }
+
+    return routes;
+}
+
+RideScorer::Routes RideScorer::flatten(const Solution& solution) {
+    Routes routes;
+    routes.offsets.reserve(solution.routes.size() + 1);
+
+    for(const std::vector<unsigned>& route : solution.routes) {
+        routes.rides.insert(routes.rides.end(), route.begin(), route.end());
+        routes.offsets.push_back(routes.rides.size());
+    }
+
+    return routes;
+}
+
+long RideScorer::simulate(const Routes& routes, const unsigned firstCar,
+                          const unsigned lastCar,
+                          std::vector<std::atomic<unsigned long long>>& assigned,
+                          Report& report) const {
+    for(unsigned car = firstCar; car < lastCar; ++car) {
+        int x = 0;
+        int y = 0;
+        int t = 0;
+
+        for(unsigned i = routes.offsets[car]; i < routes.offsets[car + 1]; ++i) {
+            const unsigned ride = routes.rides[i];
+            const unsigned long long bit = 1ULL << (ride % 64);
+
+            if(ride >= inputData.nRides ||
+               (assigned[ride / 64].fetch_or(bit, std::memory_order_relaxed) & bit)) {
+                return i;
+            }
+
+            const int idle = std::abs(x - inputData.startX(ride)) +
+                             std::abs(y - inputData.startY(ride));
+            const int startTime = std::max(t + idle, inputData.startT(ride));
+            t = startTime + inputData.distances(ride);
+            x = inputData.endX(ride);
+            y = inputData.endY(ride);
+            report.idleDistance += idle;
+
+            // same rules as RoutePlan
+            if(inputData.endT(ride) >= t) {
+                report.score += inputData.distances(ride);
+                ++report.onTimeCount;
+            }
+
+            if(inputData.startT(ride) == startTime) {
+                report.score += inputData.bonus;
+                ++report.bonusCount;
+            }
+        }
+
+        report.assigned += routes.offsets[car + 1] - routes.offsets[car];
+    }
+
+    return -1;
+}
+
+RideScorer::Report RideScorer::score(const Routes& routes) const {
+    const unsigned nCars = routes.offsets.size() - 1;
+
+    if(nCars != inputData.fleetSize) {
+        throw std::invalid_argument("Solution has " + std::to_string(nCars) + " cars, expected " +
+                                    std::to_string(inputData.fleetSize));
+    }
+
+    // blocks of consecutive cars with about the same number of rides
+    const unsigned nBlocks = std::max(1u, std::min(nThreads, nCars));
+    std::vector<unsigned> firstCars(nBlocks + 1, nCars);
+
+    for(unsigned block = 0; block < nBlocks; ++block) {
+        const unsigned long target = static_cast<unsigned long>(routes.rides.size()) * block /
+                                     nBlocks;
+        firstCars[block] = std::lower_bound(routes.offsets.begin(), routes.offsets.end() - 1,
+                                            target) - routes.offsets.begin();
+    }
+
+    std::vector<std::atomic<unsigned long long>> assigned((inputData.nRides + 63) / 64);
+    std::vector<Report> reports(nBlocks);
+    std::vector<long> errors(nBlocks, -1);
+    std::vector<std::thread> threads;
+
+    for(unsigned block = 1; block < nBlocks; ++block) {
+        threads.emplace_back([&, block]() {
+            errors[block] = simulate(routes, firstCars[block], firstCars[block + 1], assigned,
+                                     reports[block]);
+        });
+    }
+
+    errors[0] = simulate(routes, firstCars[0], firstCars[1], assigned, reports[0]);
+
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+
+    Report report;
+
+    for(unsigned block = 0; block < nBlocks; ++block) {
+        if(errors[block] >= 0) {
+            const unsigned ride = routes.rides[errors[block]];
+            const unsigned car = std::upper_bound(routes.offsets.begin(), routes.offsets.end(),
+                                                  errors[block]) - routes.offsets.begin() - 1;
+            throw std::invalid_argument("Car " + std::to_string(car) + ": ride " +
+                                        std::to_string(ride) + (ride >= inputData.nRides ?
+                                                " doesn't exist" : " is assigned twice"));
+        }
+
+        report.score += reports[block].score;
+        report.assigned += reports[block].assigned;
+        report.bonusCount += reports[block].bonusCount;
+        report.onTimeCount += reports[block].onTimeCount;
+        report.idleDistance += reports[block].idleDistance;
+    }
+
+    return report;
+}
@@ -0,0 +1,124 @@
+#ifndef RIDE_SCORER_H
+#define RIDE_SCORER_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "InputData.hpp"
+#include "Solution.hpp"
+
+/**
+ * Validates and scores output files without the overhead of RoutePlan.
+ *
+ * The routes are stored flat (all rides in one array, one offset per car). The cars are
+ * simulated in parallel, split into contiguous blocks of about the same number of rides;
+ * every thread marks its rides in a shared bitset with atomic operations to detect rides
+ * assigned twice. Scoring follows RoutePlan: a ride earns its distance if it finishes in
+ * time and the bonus if it starts at its earliest start.
+ */
+class RideScorer {
+public:
+
+    /** Statistics of a valid solution. */
+    struct Report {
+        /** Total score (points of rides finished in time and bonuses). */
+        long score = 0;
+        /** Number of assigned rides. */
+        unsigned assigned = 0;
+        /** Number of rides started at their earliest start. */
+        unsigned bonusCount = 0;
+        /** Number of rides finished in time. */
+        unsigned onTimeCount = 0;
+        /** Distance driven without a passenger (to the start of each ride). */
+        long idleDistance = 0;
+    };
+
+    /**
+     * Routes of all cars in a flat representation.
+     * The rides of car i are rides[offsets[i]] ... rides[offsets[i + 1] - 1].
+     */
+    struct Routes {
+        /** Index of the first ride of each car in Routes#rides and the total count. */
+        std::vector<unsigned> offsets{0};
+        /** Rides of all cars in order. */
+        std::vector<unsigned> rides;
+    };
+
+    /**
+     * Creates a scorer.
+     *
+     * \param [in] inputData InputData the solutions belong to
+     * \param [in] nThreads number of threads simulating cars (0: one per core)
+     */
+    RideScorer(const InputData& inputData, const unsigned nThreads = 0);
+
+    /**
+     * Parses an output file, the number of rides of each line is checked.
+     *
+     * \param [in] path path of the output file
+     * \throw std::fstream::failure if the file can't be read
+     * \throw std::invalid_argument if the file isn't a valid output file
+     * \return Routes routes of all cars
+     */
+    static Routes readFile(const std::string& path);
+
+    /**
+     * Parses the text of an output file.
+     *
+     * \param [in] begin first character
+     * \param [in] end character behind the last one
+     * \throw std::invalid_argument if the text isn't a valid output file
+     * \return Routes routes of all cars
+     */
+    static Routes parse(const char* begin, const char* end);
+
+    /**
+     * Converts a Solution to the flat representation.
+     *
+     * \param [in] solution routes of all cars
+     * \return Routes routes of all cars
+     */
+    static Routes flatten(const Solution& solution);
+
+    /**
+     * Validates and scores the routes of all cars.
+     *
+     * \param [in] routes routes of all cars
+     * \throw std::invalid_argument if the number of cars doesn't match, a ride doesn't exist
+     *        or is assigned twice
+     * \return Report score and statistics
+     */
+    Report score(const Routes& routes) const;
+
+    /**
+     * Validates and scores a solution.
+     *
+     * \param [in] solution routes of all cars
+     * \throw std::invalid_argument see RideScorer::score(const Routes&)
+     * \return Report score and statistics
+     */
+    Report score(const Solution& solution) const {return score(flatten(solution));}
+
+private:
+
+    /**
+     * Simulates a block of cars.
+     *
+     * \param [in] routes routes of all cars
+     * \param [in] firstCar first car of the block
+     * \param [in] lastCar car behind the block
+     * \param [in,out] assigned bitset of assigned rides (64 rides per word)
+     * \param [out] report statistics of the block
+     * \return long first ride that is invalid or assigned twice (-1: none)
+     */
+    long simulate(const Routes& routes, const unsigned firstCar, const unsigned lastCar,
+                  std::vector<std::atomic<unsigned long long>>& assigned, Report& report) const;
+
+    /** InputData the solutions belong to. */
+    const InputData& inputData;
+
+    /** Number of threads simulating cars. */
+    unsigned nThreads;
+};
+
+#endif // RIDE_SCORER_H
@@ -0,0 +1,81 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "InputData.hpp"
+#include "RideScorer.hpp"
+
+/**
+ * Validates and scores output files.
+ *
+ * \code
+ * RideScorer [--threads <n>] <input path> <output path>...
+ * \endcode
+ */
+int main(int argc, char *argv[]) {
+    unsigned nThreads = 0;
+    std::vector<std::string> positional;
+
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+
+        if(arg == "--threads" && i + 1 < argc) {
+            std::istringstream(argv[++i]) >> nThreads;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    if(positional.size() < 2) {
+        std::cerr << "Usage: RideScorer [--threads <n>] <input path> <output path>..."
+                  << std::endl;
+        return 1;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    std::shared_ptr<InputData> inputData;
+
+    try { inputData = InputData::genFromFile(positional[0]); }
+    catch(const std::fstream::failure& e) {
+        std::cerr << e.what() << "(Invalid file or path)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Input read in " << std::chrono::duration<double>(Clock::now() - start).count()
+              << " s" << std::endl;
+    const RideScorer scorer(*inputData, nThreads);
+    unsigned invalid = 0;
+
+    for(unsigned i = 1; i < positional.size(); ++i) {
+        std::cout << positional[i] << ": ";
+
+        try {
+            start = Clock::now();
+            const RideScorer::Routes routes = RideScorer::readFile(positional[i]);
+            const auto parsed = Clock::now();
+            const RideScorer::Report report = scorer.score(routes);
+            const auto scored = Clock::now();
+
+            std::cout << "score " << report.score << std::endl;
+            std::cout << "  assigned rides: " << report.assigned << " of " << inputData->nRides
+                      << ", on time: " << report.onTimeCount << ", bonus: "
+                      << report.bonusCount << std::endl;
+            std::cout << "  idle distance: " << report.idleDistance << std::endl;
+            std::cout << "  parsed in " << std::chrono::duration<double>(parsed - start).count()
+                      << " s, scored in " << std::chrono::duration<double>(scored - parsed).count()
+                      << " s" << std::endl;
+        } catch(const std::fstream::failure& e) {
+            std::cout << "invalid (" << e.what() << ")" << std::endl;
+            ++invalid;
+        } catch(const std::invalid_argument& e) {
+            std::cout << "invalid (" << e.what() << ")" << std::endl;
+            ++invalid;
+        }
+    }
+
+    return invalid > 0 ? 1 : 0;
+}
@@ -0,0 +1,65 @@
+#include <sstream>
+#include <stdexcept>
+#include "Client.hpp"
+
+std::string Client::readResponse() {
+    std::string line;
+
+    if(!connection.readLine(line)) {
+        throw std::runtime_error("Connection lost");
+    }
+
+    if(line.compare(0, 6, "ERROR ") == 0) {
+        throw std::runtime_error(line.substr(6));
+    }
+
+    return line;
+}
+
+Client::Response Client::solve(const std::string& instance, const bool binary,
+                               const double seconds) {
+    std::ostringstream request;
+    request << "SOLVE " << (binary ? "binary" : "text") << " " << instance.size();
+
+    if(seconds > 0) {request << " " << seconds;}
+
+    request << "\n";
+
+    if(!connection.write(request.str()) || !connection.write(instance)) {
+        throw std::runtime_error("Connection lost");
+    }
+
+    std::istringstream header(readResponse());
+    std::string field;
+    std::size_t size = 0;
+    Response response;
+    header >> field;
+
+    // fields are key=value pairs after "OK"
+    while(header >> field) {
+        const std::size_t separator = field.find('=');
+        const std::string key = field.substr(0, separator);
+        std::istringstream value(field.substr(separator + 1));
+
+        if(key == "score") {value >> response.score;}
+        else if(key == "rides") {value >> response.rides;}
+        else if(key == "queue_ms") {value >> response.queueMs;}
+        else if(key == "parse_ms") {value >> response.parseMs;}
+        else if(key == "solve_ms") {value >> response.solveMs;}
+        else if(key == "bytes") {value >> size;}
+    }
+
+    if(!connection.read(response.solution, size)) {
+        throw std::runtime_error("Connection lost");
+    }
+
+    return response;
+}
+
+std::string Client::stats() {
+    if(!connection.write("STATS\n")) {
+        throw std::runtime_error("Connection lost");
+    }
+
+    return readResponse();
+}
@@ -0,0 +1,70 @@
+#ifndef CLIENT_H
+#define CLIENT_H
+
+#include <string>
+#include "Connection.hpp"
+
+/**
+ * Client of the solve protocol of Server.
+ */
+class Client {
+public:
+
+    /** Solution and metrics of a solved instance. */
+    struct Response {
+        /** Score of the solution. */
+        long score = 0;
+        /** Number of assigned rides. */
+        unsigned rides = 0;
+        /** Milliseconds the connection waited for a worker of the server. */
+        double queueMs = 0;
+        /** Milliseconds spent reading the instance. */
+        double parseMs = 0;
+        /** Milliseconds spent solving the instance. */
+        double solveMs = 0;
+        /** Solution in the format of the output file. */
+        std::string solution;
+    };
+
+    /**
+     * Connects to a server.
+     *
+     * \param [in] socketPath path of the Unix domain socket of the server
+     * \throw std::runtime_error if the connection fails
+     */
+    Client(const std::string& socketPath): connection(Connection::connectTo(socketPath)) {};
+
+    /**
+     * Lets the server solve an instance.
+     *
+     * \param [in] instance content of an input file or a snapshot
+     * \param [in] binary true if the instance is a snapshot (see InputData::writeSnapshot)
+     * \param [in] seconds deadline of the computation (0: none)
+     * \throw std::runtime_error if the server answers with an error or the connection is lost
+     * \return Response solution and metrics
+     */
+    Response solve(const std::string& instance, const bool binary, const double seconds = 0);
+
+    /**
+     * Requests the counters of the server.
+     *
+     * \throw std::runtime_error if the connection is lost
+     * \return std::string response line of the STATS request
+     */
+    std::string stats();
+
+private:
+
+    /**
+     * Reads a response line and throws if it is an error.
+     *
+     * \throw std::runtime_error if the server answers with an error or the connection is lost
+     * \return std::string response line
+     */
+    std::string readResponse();
+
+    /** Connection to the server. */
+    Connection connection;
+};
+
+#endif // CLIENT_H
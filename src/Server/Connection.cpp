@@ -0,0 +1,120 @@
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Connection.hpp"
+
+/** Number of bytes received at once. */
+static constexpr std::size_t CHUNK_SIZE = 65536;
+
+Connection::~Connection() {
+    close(fd);
+}
+
+int Connection::connectTo(const std::string& path) {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+
+    if(path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+
+    std::strcpy(address.sun_path, path.c_str());
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if(fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        const std::string error = std::strerror(errno);
+
+        if(fd >= 0) {close(fd);}
+
+        throw std::runtime_error("Can't connect to " + path + ": " + error);
+    }
+
+    return fd;
+}
+
+bool Connection::fill() {
+    char chunk[CHUNK_SIZE];
+    ssize_t received;
+
+    do {
+        received = recv(fd, chunk, sizeof(chunk), 0);
+    } while(received < 0 && errno == EINTR);
+
+    if(received <= 0) {return false;}
+
+    buffer.append(chunk, received);
+    return true;
+}
+
+bool Connection::readLine(std::string& line) {
+    std::size_t end;
+
+    while((end = buffer.find('\n')) == std::string::npos) {
+        if(buffer.size() > MAX_LINE_LENGTH) {
+            exceeded = true;
+            return false;
+        }
+
+        if(!fill()) {return false;}
+    }
+
+    if(end > MAX_LINE_LENGTH) {
+        exceeded = true;
+        return false;
+    }
+
+    line.assign(buffer, 0, end);
+    buffer.erase(0, end + 1);
+    return true;
+}
+
+bool Connection::read(std::string& data, const std::size_t size) {
+    if(size > maxPayload) {
+        exceeded = true;
+        return false;
+    }
+
+    while(buffer.size() < size) {
+        if(!fill()) {return false;}
+    }
+
+    data.assign(buffer, 0, size);
+    buffer.erase(0, size);
+    return true;
+}
+
+bool Connection::write(const std::string& data) {
+    std::size_t sent = 0;
+
+    while(sent < data.size()) {
+        // a closed peer must not raise SIGPIPE
+        const ssize_t result = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+
+        if(result < 0 && errno == EINTR) {continue;}
+
+        if(result <= 0) {return false;}
+
+        sent += result;
+    }
+
+    return true;
+}
+
+bool Connection::waitReadable(const int milliseconds) {
+    if(!buffer.empty()) {return true;}
+
+    pollfd request = {fd, POLLIN, 0};
+    return poll(&request, 1, milliseconds) > 0;
+}
+
+void Connection::setReadTimeout(const double seconds) {
+    timeval timeout = {};
+    timeout.tv_sec = static_cast<time_t>(seconds);
+    timeout.tv_usec = static_cast<suseconds_t>((seconds - timeout.tv_sec) * 1e6);
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
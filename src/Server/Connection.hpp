@@ -0,0 +1,122 @@
+#ifndef CONNECTION_H
+#define CONNECTION_H
+
+#include <limits>
+#include <string>
+
+/**
+ * Stream socket with buffered reading of lines and byte blocks.
+ *
+ * Messages of the solve protocol (see Server) are a header line, optionally followed by a
+ * payload whose size is given in the header.
+ */
+class Connection {
+public:
+
+    /** Maximal length of a line, longer lines aren't read (see Connection::exceededLimit). */
+    static constexpr std::size_t MAX_LINE_LENGTH = 4096;
+
+    /**
+     * Takes ownership of a connected socket.
+     *
+     * \param [in] fd file descriptor of the socket
+     */
+    explicit Connection(const int fd): fd(fd) {};
+
+    /** Closes the socket. */
+    ~Connection();
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    /**
+     * Connects to a Unix domain socket.
+     *
+     * \param [in] path path of the socket
+     * \throw std::runtime_error if the connection fails
+     * \return int file descriptor of the connected socket
+     */
+    static int connectTo(const std::string& path);
+
+    /**
+     * Reads a line.
+     *
+     * \param [out] line line without the line break
+     * \return bool false if the peer closed the connection, an error occurred or the line is
+     *         longer than Connection::MAX_LINE_LENGTH
+     */
+    bool readLine(std::string& line);
+
+    /**
+     * Reads a given number of bytes.
+     *
+     * \param [out] data received bytes
+     * \param [in] size number of bytes
+     * \return bool false if the peer closed the connection, an error occurred or the size
+     *         exceeds the maximal payload (see Connection::setMaxPayload)
+     */
+    bool read(std::string& data, const std::size_t size);
+
+    /**
+     * Writes all bytes.
+     *
+     * \param [in] data bytes to send
+     * \return bool false if the peer closed the connection or an error occurred
+     */
+    bool write(const std::string& data);
+
+    /**
+     * Waits until data can be read.
+     *
+     * \param [in] milliseconds maximum time to wait
+     * \return bool true if data is available (or the peer closed the connection)
+     */
+    bool waitReadable(const int milliseconds);
+
+    /**
+     * Limits the time a read waits for more bytes, a stalled peer is treated like a closed
+     * connection.
+     *
+     * \param [in] seconds maximum time to wait for more bytes (0: no limit)
+     */
+    void setReadTimeout(const double seconds);
+
+    /**
+     * Limits the number of bytes of a single Connection::read, larger payloads are refused
+     * before any of their bytes are received.
+     *
+     * \param [in] bytes maximal size of a payload
+     */
+    void setMaxPayload(const std::size_t bytes) {maxPayload = bytes;}
+
+    /**
+     * Checks if the last failed read was refused because of its size rather than a closed
+     * connection. The rest of the message isn't consumed, the connection should be closed.
+     *
+     * \return bool true if a line or payload exceeded its limit
+     */
+    bool exceededLimit() const {return exceeded;}
+
+private:
+
+    /**
+     * Receives more bytes into Connection#buffer.
+     *
+     * \return bool false if the peer closed the connection or an error occurred
+     */
+    bool fill();
+
+    /** File descriptor of the socket. */
+    const int fd;
+
+    /** Received bytes that haven't been read yet. */
+    std::string buffer;
+
+    /** Maximal size of a payload (see Connection::setMaxPayload). */
+    std::size_t maxPayload = std::numeric_limits<std::size_t>::max();
+
+    /** Whether a line or payload exceeded its limit. */
+    bool exceeded = false;
+};
+
+#endif // CONNECTION_H
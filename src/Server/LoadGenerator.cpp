@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "InputData.hpp"
+#include "Client.hpp"
+#include "Options.hpp"
+
+/**
+ * Load generator for RideDistributor --serve: clients send the same instance repeatedly
+ * and the throughput and latencies of all requests are printed.
+ *
+ * \code
+ * RideLoadGenerator [--clients <n>] [--requests <n>] [--binary] [--seconds <s>] <socket> <input>
+ * \endcode
+ */
+int main(int argc, char *argv[]) {
+    unsigned nClients = 4;
+    unsigned nRequests = 100;
+    bool binary = false;
+    double seconds = 0;
+    std::vector<std::string> positional;
+
+    try {
+        for(int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+
+            if(arg == "--binary") {
+                binary = true;
+            } else if(arg.compare(0, 2, "--") == 0 && i + 1 < argc) {
+                const std::string value = argv[++i];
+
+                if(arg == "--clients") {
+                    nClients = Options::parseValue<unsigned>(arg, value);
+                } else if(arg == "--requests") {
+                    nRequests = Options::parseValue<unsigned>(arg, value);
+                } else if(arg == "--seconds") {
+                    seconds = Options::parseValue<double>(arg, value);
+                } else {
+                    throw std::invalid_argument("Unknown option: " + arg);
+                }
+            } else {
+                positional.push_back(arg);
+            }
+        }
+    } catch(const std::invalid_argument& e) {
+        std::cerr << e.what() << std::endl;
+        positional.clear();
+    }
+
+    if(positional.size() != 2 || nClients == 0) {
+        std::cerr << "Usage: RideLoadGenerator [--clients <n>] [--requests <n per client>]"
+                  " [--binary] [--seconds <deadline>] <socket> <input>" << std::endl;
+        return 1;
+    }
+
+    // the instance is read once and sent as text or snapshot
+    std::string instance;
+
+    try {
+        std::shared_ptr<InputData> inputData = InputData::genFromFile(positional[1]);
+        std::ostringstream stream;
+
+        if(binary) {
+            inputData->writeSnapshot(stream);
+            instance = stream.str();
+        } else {
+            std::ifstream file(positional[1], std::ifstream::binary);
+            stream << file.rdbuf();
+            instance = stream.str();
+        }
+    } catch(const std::exception& e) {
+        std::cerr << e.what() << "(Invalid file or path)" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<double>> latencies(nClients);
+    std::vector<double> solveMs(nClients, 0);
+    std::atomic<unsigned> errors(0);
+    std::atomic<long> score(0);
+    std::vector<std::thread> clients;
+    const auto start = std::chrono::steady_clock::now();
+
+    for(unsigned c = 0; c < nClients; ++c) {
+        clients.emplace_back([&, c]() {
+            try {
+                Client client(positional[0]);
+
+                for(unsigned r = 0; r < nRequests; ++r) {
+                    const auto requestStart = std::chrono::steady_clock::now();
+                    const Client::Response response = client.solve(instance, binary, seconds);
+                    latencies[c].push_back(std::chrono::duration<double>(
+                                               std::chrono::steady_clock::now() - requestStart).count());
+                    solveMs[c] += response.solveMs;
+                    score.store(response.score);
+                }
+            } catch(const std::exception& e) {
+                // e.g. rejected because the queue of the server is full
+                errors += nRequests - latencies[c].size();
+            }
+        });
+    }
+
+    for(std::thread& client : clients) {
+        client.join();
+    }
+
+    const double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                            start).count();
+    std::vector<double> all;
+    double totalSolveMs = 0;
+
+    for(unsigned c = 0; c < nClients; ++c) {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        totalSolveMs += solveMs[c];
+    }
+
+    std::sort(all.begin(), all.end());
+    auto percentile = [&all](const double p) {
+        return all.empty() ? 0 : all[std::min<std::size_t>(all.size() - 1, p * all.size())] * 1000;
+    };
+
+    std::cout << "Requests: " << all.size() << " ok, " << errors << " failed, score "
+              << score << std::endl;
+    std::cout << "Throughput: " << all.size() / wallTime << " requests/s" << std::endl;
+    std::cout << "Latency: p50 " << percentile(0.5) << " ms, p99 " << percentile(0.99)
+              << " ms, max " << percentile(1) << " ms" << std::endl;
+    std::cout << "Server solve time: " << (all.empty() ? 0 : totalSolveMs / all.size())
+              << " ms per request" << std::endl;
+
+    try {
+        std::cout << Client(positional[0]).stats() << std::endl;
+    } catch(const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+    }
+
+    return errors > 0 ? 1 : 0;
+}
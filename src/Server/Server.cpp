@@ -0,0 +1,304 @@
+#include <csignal>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Server.hpp"
+#include "InputData.hpp"
+#include "Algorithm.hpp"
+#include "Deadline.hpp"
+
+/** Milliseconds between two checks whether the server stops. */
+static constexpr int POLL_INTERVAL = 100;
+
+/** Forwards SIGTERM and SIGINT as a stop request to the server and all deadlines. */
+extern "C" void handleStop(int) {
+    Deadline::requestStop();
+}
+
+Server::Server(const std::string& socketPath, const Options& options,
+               const unsigned nWorkers, const unsigned queueSize):
+    socketPath(socketPath), options(options), nWorkers(nWorkers),
+    queueSize(queueSize), start(Clock::now()) {
+    if(this->nWorkers == 0) {
+        this->nWorkers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // requests run in parallel, so each of them is solved by a single thread
+    this->options.threads = 1;
+    this->options.deadline = 0;
+    this->options.streamLead = -1;
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+
+    if(socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + socketPath);
+    }
+
+    std::strcpy(address.sun_path, socketPath.c_str());
+    unlink(socketPath.c_str());
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if(listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&address),
+                            sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0) {
+        const std::string error = std::strerror(errno);
+
+        if(listener >= 0) {close(listener);}
+
+        throw std::runtime_error("Can't listen on " + socketPath + ": " + error);
+    }
+}
+
+Server::~Server() {
+    close(listener);
+    unlink(socketPath.c_str());
+}
+
+bool Server::isStopping() const {
+    return stopping.load() || Deadline::stopRequested();
+}
+
+Server::Stats Server::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats result = stats;
+    result.queued = queue.size();
+    result.uptime = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+void Server::run() {
+    std::signal(SIGTERM, handleStop);
+    std::signal(SIGINT, handleStop);
+    std::vector<std::thread> workers;
+
+    for(unsigned i = 0; i < nWorkers; ++i) {
+        workers.emplace_back(&Server::work, this);
+    }
+
+    while(!isStopping()) {
+        pollfd request = {listener, POLLIN, 0};
+
+        if(poll(&request, 1, POLL_INTERVAL) <= 0) {continue;}
+
+        const int fd = accept(listener, nullptr, nullptr);
+
+        if(fd < 0) {continue;}
+
+        std::unique_lock<std::mutex> lock(mutex);
+
+        if(queue.size() >= queueSize) {
+            ++stats.rejected;
+            lock.unlock();
+            Connection(fd).write("ERROR busy\n");
+            continue;
+        }
+
+        queue.emplace_back(fd, Clock::now());
+        lock.unlock();
+        queueChanged.notify_one();
+    }
+
+    stopping.store(true);
+    queueChanged.notify_all();
+
+    for(std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // connections that never got a worker
+    for(const auto& entry : queue) {
+        close(entry.first);
+    }
+
+    queue.clear();
+    std::signal(SIGTERM, SIG_DFL);
+    std::signal(SIGINT, SIG_DFL);
+}
+
+void Server::work() {
+    std::shared_ptr<Generator::Workspace> workspace = std::make_shared<Generator::Workspace>();
+
+    while(true) {
+        std::unique_lock<std::mutex> lock(mutex);
+        queueChanged.wait_for(lock, std::chrono::milliseconds(POLL_INTERVAL), [this]() {
+            return !queue.empty() || isStopping();
+        });
+
+        if(isStopping()) {return;}
+
+        if(queue.empty()) {continue;}
+
+        const std::pair<int, Clock::time_point> entry = queue.front();
+        queue.pop_front();
+        lock.unlock();
+
+        Connection connection(entry.first);
+        serve(connection, std::chrono::duration<double>(Clock::now() - entry.second).count(),
+              workspace);
+    }
+}
+
+void Server::serve(Connection& connection, double queueTime,
+                   std::shared_ptr<Generator::Workspace> workspace) {
+    std::string line;
+    // a client stalled within a request is dropped as well
+    connection.setReadTimeout(options.idleTimeout);
+    connection.setMaxPayload(options.maxPayload);
+    Clock::time_point lastRequest = Clock::now();
+
+    while(!isStopping()) {
+        if(!connection.waitReadable(POLL_INTERVAL)) {
+            const double idle = std::chrono::duration<double>(Clock::now() -
+                                lastRequest).count();
+
+            if(options.idleTimeout > 0 && idle >= options.idleTimeout) {
+                connection.write("ERROR idle timeout\n");
+                return;
+            }
+
+            continue;
+        }
+
+        if(!connection.readLine(line)) {
+            if(connection.exceededLimit()) {reject(connection);}
+
+            return;
+        }
+
+        std::istringstream header(line);
+        std::string command;
+        header >> command;
+        std::string response;
+
+        if(command == "SOLVE") {
+            std::string format;
+            std::size_t size = 0;
+            double seconds = 0;
+            std::string payload;
+
+            if(!(header >> format >> size) || (format != "text" && format != "binary")) {
+                response = "ERROR invalid request: " + line + "\n";
+            } else if(!connection.read(payload, size)) {
+                if(connection.exceededLimit()) {reject(connection);}
+
+                return;
+            } else {
+                // the deadline is optional
+                header >> seconds;
+
+                try {
+                    response = solve(format, payload, seconds, queueTime, workspace);
+                } catch(const std::exception& e) {
+                    response = std::string("ERROR invalid instance: ") + e.what() + "\n";
+                }
+            }
+
+            // only the first request of a connection waited in the queue
+            queueTime = 0;
+        } else if(command == "STATS") {
+            const Stats current = getStats();
+            std::ostringstream result;
+            result << "STATS served=" << current.served << " failed=" << current.failed
+                   << " rejected=" << current.rejected << " queued=" << current.queued
+                   << " solve_ms=" << (current.served > 0 ? current.solveSeconds * 1000 /
+                                       current.served : 0)
+                   << " uptime_s=" << current.uptime << "\n";
+            response = result.str();
+        } else if(command == "QUIT") {
+            return;
+        } else {
+            response = "ERROR unknown command: " + command + "\n";
+        }
+
+        if(response.compare(0, 5, "ERROR") == 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++stats.failed;
+        }
+
+        if(!connection.write(response)) {return;}
+
+        lastRequest = Clock::now();
+    }
+}
+
+void Server::reject(Connection& connection) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++stats.failed;
+    }
+
+    connection.write("ERROR request too large\n");
+}
+
+void Server::checkHeader(const std::string& format, const std::string& payload) const {
+    unsigned long fleetSize = 0;
+
+    if(format == "binary") {
+        // a snapshot too short for a header is reported by InputData::genFromSnapshot
+        std::uint32_t header[6];
+
+        if(payload.size() < sizeof(InputData::SNAPSHOT_MAGIC) + sizeof(header)) {return;}
+
+        std::memcpy(header, payload.data() + sizeof(InputData::SNAPSHOT_MAGIC), sizeof(header));
+        fleetSize = header[2];
+    } else {
+        std::istringstream stream(payload);
+        unsigned long rows, cols, nRides;
+
+        if(!(stream >> rows >> cols >> fleetSize >> nRides)) {return;}
+
+        if(nRides > payload.size() / MIN_RIDE_BYTES) {
+            throw std::invalid_argument("More rides than the request holds");
+        }
+    }
+
+    if(fleetSize > options.maxPayload / MIN_RIDE_BYTES) {
+        throw std::invalid_argument("More cars than rides of the largest request");
+    }
+}
+
+std::string Server::solve(const std::string& format, const std::string& payload,
+                          const double seconds, const double queueTime,
+                          std::shared_ptr<Generator::Workspace> workspace) {
+    const Clock::time_point parseStart = Clock::now();
+    checkHeader(format, payload);
+    std::istringstream stream(payload);
+    std::shared_ptr<InputData> inputData = format == "binary" ?
+                                           InputData::genFromSnapshot(stream) :
+                                           InputData::genFromStream(stream);
+
+    const Clock::time_point solveStart = Clock::now();
+    // the progress of a request isn't printed
+    std::ostream discard(nullptr);
+    Algorithm algorithm(*inputData, "", options, discard);
+    algorithm.setWorkspace(workspace);
+    const RoutePlan plan = algorithm.computeRoutes(Deadline(seconds));
+    const Clock::time_point solveEnd = Clock::now();
+
+    std::ostringstream solution;
+    plan.toSolution().write(solution);
+    const std::string body = solution.str();
+    const double solveTime = std::chrono::duration<double>(solveEnd - solveStart).count();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++stats.served;
+        stats.solveSeconds += solveTime;
+    }
+
+    std::ostringstream response;
+    response << "OK score=" << plan.getScore() << " rides="
+             << inputData->nRides - plan.getUnassigned().size() << " queue_ms="
+             << queueTime * 1000 << " parse_ms="
+             << std::chrono::duration<double>(solveStart - parseStart).count() * 1000
+             << " solve_ms=" << solveTime * 1000 << " bytes=" << body.size() << "\n" << body;
+    return response.str();
+}
@@ -0,0 +1,190 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include "Options.hpp"
+#include "Generator.hpp"
+#include "Connection.hpp"
+
+/**
+ * Daemon solving instances sent over a Unix domain socket, so that process startup and
+ * allocations are not repeated for every instance.
+ *
+ * Accepted connections wait in a bounded queue until one of the worker threads is free;
+ * if the queue is full, the connection is rejected with "ERROR busy". A worker serves all
+ * requests of a connection and reuses its Generator::Workspace for all of them. A connection
+ * idle for Options#idleTimeout seconds is closed, so that it doesn't keep the worker from
+ * the queue. Header lines longer than Connection::MAX_LINE_LENGTH and payloads larger than
+ * Options#maxPayload are answered by "ERROR request too large" and close the connection. The
+ * header of an instance is checked before it's read: a text instance can't have more rides
+ * than its payload has lines of Server::MIN_RIDE_BYTES bytes, and no instance more cars than
+ * Options#maxPayload / Server::MIN_RIDE_BYTES (the rides of the largest request). Each
+ * request is solved single-threaded by Algorithm::computeRoutes with the options of the
+ * server. Protocol (one request after another, header lines end with '\n'):
+ *
+ * \code
+ * SOLVE <text|binary> <payload bytes> [<seconds>]    instance as input file or snapshot
+ * OK score=<s> rides=<r> queue_ms=<q> parse_ms=<p> solve_ms=<t> bytes=<n>
+ * <solution in the format of the output file, n bytes>
+ *
+ * STATS
+ * STATS served=<n> failed=<n> rejected=<n> queued=<n> solve_ms=<average> uptime_s=<s>
+ *
+ * QUIT                                               closes the connection
+ * \endcode
+ *
+ * Failed requests are answered by "ERROR <message>". The optional seconds of a SOLVE
+ * request are the deadline of the computation.
+ */
+class Server {
+public:
+
+    /** Bytes of the shortest ride line of a text instance ("0 0 0 0 0 0\n"). */
+    static constexpr std::size_t MIN_RIDE_BYTES = 12;
+
+    /** Counters of all requests since the server started. */
+    struct Stats {
+        /** Number of solved requests. */
+        unsigned long served = 0;
+        /** Number of requests answered with an error. */
+        unsigned long failed = 0;
+        /** Number of connections rejected because the queue was full. */
+        unsigned long rejected = 0;
+        /** Number of connections waiting for a worker. */
+        unsigned queued = 0;
+        /** Time spent solving requests in seconds. */
+        double solveSeconds = 0;
+        /** Time since the server started in seconds. */
+        double uptime = 0;
+    };
+
+    /**
+     * Creates the socket and starts listening.
+     *
+     * \param [in] socketPath path of the Unix domain socket (an existing file is replaced)
+     * \param [in] options options used to solve all requests
+     * \param [in] nWorkers number of connections served concurrently (0: one per core)
+     * \param [in] queueSize maximum number of connections waiting for a worker
+     * \throw std::runtime_error if the socket can't be created
+     */
+    Server(const std::string& socketPath, const Options& options, const unsigned nWorkers = 0,
+           const unsigned queueSize = 64);
+
+    /** Closes and removes the socket. */
+    ~Server();
+
+    /**
+     * Accepts connections until Server::stop is called, SIGTERM or SIGINT is received.
+     * Returns after all workers finished their current request.
+     */
+    void run();
+
+    /** Stops accepting connections, Server::run returns soon. */
+    void stop() {stopping.store(true);}
+
+    /**
+     * Counters of all requests since the server started.
+     *
+     * \return Stats current counters
+     */
+    Stats getStats() const;
+
+private:
+
+    using Clock = std::chrono::steady_clock;
+
+    /** Worker loop: serves connections of the queue until the server stops. */
+    void work();
+
+    /**
+     * Answers all requests of a connection.
+     *
+     * \param [in,out] connection connection of a client
+     * \param [in] queueTime seconds the connection waited for a worker
+     * \param [in] workspace matrices of the worker
+     */
+    void serve(Connection& connection, double queueTime,
+               std::shared_ptr<Generator::Workspace> workspace);
+
+    /**
+     * Answers a request exceeding the limits of the connection (see
+     * Connection::exceededLimit) with an error, the rest of it can't be skipped.
+     *
+     * \param [in,out] connection connection of the client, should be closed afterwards
+     */
+    void reject(Connection& connection);
+
+    /**
+     * Checks the numbers of rides and cars in the header of an instance, so that a small
+     * request can't make InputData or the solution allocate for billions of them.
+     *
+     * \param [in] format "text" or "binary"
+     * \param [in] payload instance as input file or snapshot
+     * \throw std::invalid_argument if the header claims more rides or cars than allowed
+     */
+    void checkHeader(const std::string& format, const std::string& payload) const;
+
+    /**
+     * Solves the instance of a SOLVE request.
+     *
+     * \param [in] format "text" or "binary"
+     * \param [in] payload instance as input file or snapshot
+     * \param [in] seconds deadline of the computation (0: none)
+     * \param [in] queueTime seconds the request waited for a worker
+     * \param [in] workspace matrices of the worker
+     * \throw std::exception if the instance can't be read
+     * \return std::string response
+     */
+    std::string solve(const std::string& format, const std::string& payload,
+                      const double seconds, const double queueTime,
+                      std::shared_ptr<Generator::Workspace> workspace);
+
+    /**
+     * Checks if the server should stop.
+     *
+     * \return bool true if Server::stop was called or a stop has been requested
+     */
+    bool isStopping() const;
+
+    /** Path of the socket. */
+    const std::string socketPath;
+
+    /** Options used to solve all requests. */
+    Options options;
+
+    /** Number of connections served concurrently. */
+    unsigned nWorkers;
+
+    /** Maximum number of connections waiting for a worker. */
+    const unsigned queueSize;
+
+    /** File descriptor of the listening socket. */
+    int listener;
+
+    /** Point in time the server started. */
+    const Clock::time_point start;
+
+    /** Set by Server::stop. */
+    std::atomic<bool> stopping{false};
+
+    /** Accepted connections waiting for a worker and the point in time of their acceptance. */
+    std::deque<std::pair<int, Clock::time_point>> queue;
+
+    /** Guards Server#queue and Server#stats. */
+    mutable std::mutex mutex;
+
+    /** Signals new connections in the queue. */
+    std::condition_variable queueChanged;
+
+    /** Counters of all requests. */
+    Stats stats;
+};
+
+#endif // SERVER_H
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include "InstanceGenerator.hpp"
+
+/** Names of all distributions. */
+static const char* const DISTRIBUTIONS[] = {"uniform", "hotspot", "rush-hour"};
+
+/** Share of the rides of the rush-hour distribution that don't belong to a peak. */
+static constexpr double OFF_PEAK_SHARE = 0.2;
+
+InstanceGenerator::InstanceGenerator(const Parameters& parameters):
+    parameters(parameters), random(parameters.seed) {
+    const std::vector<std::string> names = distributionNames();
+
+    if(std::find(names.begin(), names.end(), parameters.distribution) == names.end()) {
+        throw std::invalid_argument("Unknown distribution: " + parameters.distribution);
+    }
+
+    if(parameters.rows == 0 || parameters.cols == 0 || parameters.maxTime == 0) {
+        throw std::invalid_argument("Empty grid or simulation");
+    }
+
+    for(unsigned i = 0; i < std::max(1u, parameters.hotspots); ++i) {
+        centers.push_back(uniformPoint());
+    }
+}
+
+std::vector<std::string> InstanceGenerator::distributionNames() {
+    return std::vector<std::string>(std::begin(DISTRIBUTIONS), std::end(DISTRIBUTIONS));
+}
+
+InstanceGenerator::Point InstanceGenerator::uniformPoint() {
+    std::uniform_int_distribution<int> row(0, parameters.rows - 1);
+    std::uniform_int_distribution<int> col(0, parameters.cols - 1);
+    const int x = row(random);
+    return {x, col(random)};
+}
+
+InstanceGenerator::Point InstanceGenerator::hotspotPoint() {
+    std::uniform_int_distribution<unsigned> hotspot(0, centers.size() - 1);
+    const Point& center = centers[hotspot(random)];
+    // hotspots cover about a tenth of the grid in each dimension
+    std::normal_distribution<double> row(center.x, std::max(1.0, parameters.rows / 40.0));
+    std::normal_distribution<double> col(center.y, std::max(1.0, parameters.cols / 40.0));
+    const int x = std::lround(row(random));
+    const int y = std::lround(col(random));
+    return {std::min(std::max(x, 0), static_cast<int>(parameters.rows) - 1),
+            std::min(std::max(y, 0), static_cast<int>(parameters.cols) - 1)};
+}
+
+int InstanceGenerator::earliestStart(int& peak) {
+    std::uniform_int_distribution<int> uniform(0, parameters.maxTime - 1);
+    peak = 0;
+
+    if(parameters.distribution != "rush-hour" ||
+       std::uniform_real_distribution<double>(0, 1)(random) < OFF_PEAK_SHARE) {
+        return uniform(random);
+    }
+
+    // peaks at 30 % and 70 % of the simulation
+    peak = std::bernoulli_distribution(0.5)(random) ? 1 : 2;
+    std::normal_distribution<double> time(parameters.maxTime * (peak == 1 ? 0.3 : 0.7),
+                                          parameters.maxTime / 20.0);
+    const long startT = std::lround(time(random));
+    return std::min(std::max(startT, 0L), static_cast<long>(parameters.maxTime) - 1);
+}
+
+std::shared_ptr<InputData> InstanceGenerator::generate() {
+    std::vector<int> rides;
+    rides.reserve(static_cast<std::size_t>(parameters.nRides) * 6);
+    std::uniform_int_distribution<unsigned> slack(0, parameters.slack);
+    const bool hotspot = parameters.distribution == "hotspot";
+
+    for(unsigned ride = 0; ride < parameters.nRides; ++ride) {
+        int peak;
+        int startT = earliestStart(peak);
+        Point start;
+        Point end;
+
+        if(hotspot) {
+            start = hotspotPoint();
+            end = hotspotPoint();
+        } else if(peak > 0) {
+            // commuters: to the hotspots in the morning, back in the evening
+            start = peak == 1 ? uniformPoint() : hotspotPoint();
+            end = peak == 1 ? hotspotPoint() : uniformPoint();
+        } else {
+            start = uniformPoint();
+            end = uniformPoint();
+        }
+
+        const long distance = std::abs(start.x - end.x) + std::abs(start.y - end.y);
+        const long endT = std::min(static_cast<long>(startT) + distance + slack(random),
+                                   static_cast<long>(parameters.maxTime));
+
+        // rides have to be possible within the simulation if the grid allows it
+        if(startT + distance > endT) {
+            startT = std::max(0L, endT - distance);
+        }
+
+        rides.insert(rides.end(), {start.x, start.y, end.x, end.y, startT,
+                                   static_cast<int>(endT)
+                                  });
+    }
+
+    return InputData::genFromValues(parameters.rows, parameters.cols, parameters.fleetSize,
+                                    parameters.bonus, parameters.maxTime, rides);
+}
@@ -0,0 +1,117 @@
+#ifndef INSTANCE_GENERATOR_H
+#define INSTANCE_GENERATOR_H
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "InputData.hpp"
+
+/**
+ * Creates synthetic inputs of arbitrary size for stress and scaling tests.
+ *
+ * Three distributions are available:
+ * - uniform: starts, ends and earliest starts are uniformly distributed (like the inputs of
+ *   the contest)
+ * - hotspot: starts and ends are normally distributed around a few hotspots (city centers),
+ *   earliest starts are uniformly distributed
+ * - rush-hour: most earliest starts are concentrated in a morning and an evening peak; in
+ *   the morning rides lead from anywhere to a hotspot, in the evening back; the remaining
+ *   rides are uniformly distributed
+ *
+ * The latest finish of each ride is its earliest start plus its distance plus a random
+ * slack. Equal parameters and seeds produce equal inputs (with the same standard library).
+ */
+class InstanceGenerator {
+public:
+
+    /** Parameters of the generated input. */
+    struct Parameters {
+        /** Number of rows of the grid. */
+        unsigned rows = 10000;
+        /** Number of columns of the grid. */
+        unsigned cols = 10000;
+        /** Number of cars. */
+        unsigned fleetSize = 1000;
+        /** Number of rides. */
+        unsigned nRides = 100000;
+        /** Bonus for starting a ride on time. */
+        unsigned bonus = 25;
+        /** Number of steps of the simulation. */
+        unsigned maxTime = 100000;
+        /** Maximal steps between the earliest start plus distance and the latest finish. */
+        unsigned slack = 5000;
+        /** Name of the distribution: uniform, hotspot or rush-hour. */
+        std::string distribution = "uniform";
+        /** Number of hotspots of the hotspot and rush-hour distributions. */
+        unsigned hotspots = 8;
+        /** Seed of the random number generator. */
+        unsigned long seed = 1;
+    };
+
+    /**
+     * Creates a generator.
+     *
+     * \param [in] parameters parameters of the generated input
+     * \throw std::invalid_argument if the distribution is unknown or the grid is empty
+     */
+    InstanceGenerator(const Parameters& parameters);
+
+    /**
+     * Generates the input.
+     *
+     * \return std::shared_ptr<InputData> generated input
+     */
+    std::shared_ptr<InputData> generate();
+
+    /**
+     * Names of all distributions.
+     *
+     * \return std::vector<std::string> names
+     */
+    static std::vector<std::string> distributionNames();
+
+private:
+
+    /** An intersection of the grid. */
+    struct Point {
+        /** Row coordinate. */
+        int x;
+        /** Column coordinate. */
+        int y;
+    };
+
+    /**
+     * Random intersection.
+     *
+     * \return Point uniformly distributed intersection
+     */
+    Point uniformPoint();
+
+    /**
+     * Random intersection near a random hotspot.
+     *
+     * \return Point normally distributed intersection around a hotspot
+     */
+    Point hotspotPoint();
+
+    /**
+     * Random earliest start.
+     *
+     * \param [out] peak peak the start belongs to (rush-hour only, 0: off-peak,
+     *             1: morning, 2: evening)
+     * \return int earliest start
+     */
+    int earliestStart(int& peak);
+
+    /** Parameters of the generated input. */
+    const Parameters parameters;
+
+    /** Random number generator. */
+    std::mt19937_64 random;
+
+    /** Centers of the hotspots. */
+    std::vector<Point> centers;
+};
+
+#endif // INSTANCE_GENERATOR_H
@@ -0,0 +1,111 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "InstanceGenerator.hpp"
+#include "Options.hpp"
+
+/**
+ * Writes a synthetic input file or snapshot.
+ *
+ * \code
+ * RideInstanceGenerator [options] [--binary] <output path>
+ * \endcode
+ */
+int main(int argc, char *argv[]) {
+    InstanceGenerator::Parameters parameters;
+    bool binary = false;
+    std::string outputPath;
+
+    try {
+        for(int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+
+            if(arg == "--binary") {
+                binary = true;
+                continue;
+            } else if(arg.compare(0, 2, "--") != 0) {
+                if(!outputPath.empty()) {throw std::invalid_argument("Too many paths");}
+
+                outputPath = arg;
+                continue;
+            } else if(i + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+
+            const std::string value = argv[++i];
+
+            if(arg == "--rows") {
+                parameters.rows = Options::parseValue<unsigned>(arg, value);
+            } else if(arg == "--cols") {
+                parameters.cols = Options::parseValue<unsigned>(arg, value);
+            } else if(arg == "--cars") {
+                parameters.fleetSize = Options::parseValue<unsigned>(arg, value);
+            } else if(arg == "--rides") {
+                parameters.nRides = Options::parseValue<unsigned>(arg, value);
+            } else if(arg == "--bonus") {
+                parameters.bonus = Options::parseValue<unsigned>(arg, value);
+            } else if(arg == "--steps") {
+                parameters.maxTime = Options::parseValue<unsigned>(arg, value);
+            } else if(arg == "--slack") {
+                parameters.slack = Options::parseValue<unsigned>(arg, value);
+            } else if(arg == "--distribution") {
+                parameters.distribution = value;
+            } else if(arg == "--hotspots") {
+                parameters.hotspots = Options::parseValue<unsigned>(arg, value);
+            } else if(arg == "--seed") {
+                parameters.seed = Options::parseValue<unsigned long>(arg, value);
+            } else {
+                throw std::invalid_argument("Unknown option: " + arg);
+            }
+        }
+
+        if(outputPath.empty()) {throw std::invalid_argument("No output path set.");}
+    } catch(const std::invalid_argument& e) {
+        std::cerr << e.what() << std::endl <<
+                  "Usage: RideInstanceGenerator [options] <output path>\n"
+                  "Options:\n"
+                  "  --rows <n>, --cols <n>  size of the grid (10000)\n"
+                  "  --cars <n>              number of cars (1000)\n"
+                  "  --rides <n>             number of rides (100000)\n"
+                  "  --bonus <n>             bonus for starting on time (25)\n"
+                  "  --steps <n>             steps of the simulation (100000)\n"
+                  "  --slack <n>             maximal slack of the latest finish (5000)\n"
+                  "  --distribution <name>   uniform, hotspot or rush-hour (uniform)\n"
+                  "  --hotspots <n>          number of hotspots (8)\n"
+                  "  --seed <n>              seed of the random number generator (1)\n"
+                  "  --binary                write a binary snapshot\n";
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<InputData> inputData;
+
+    try { inputData = InstanceGenerator(parameters).generate(); }
+    catch(const std::invalid_argument& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    try {
+        std::fstream outFile;
+        outFile.exceptions(std::fstream::failbit | std::fstream::badbit);
+        outFile.open(outputPath, std::fstream::out | std::fstream::binary);
+
+        if(binary) {
+            inputData->writeSnapshot(outFile);
+        } else {
+            inputData->write(outFile);
+        }
+    } catch(const std::fstream::failure& e) {
+        std::cerr << e.what() << "(Invalid file or path)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Wrote " << inputData->nRides << " rides and " << inputData->fleetSize
+              << " cars to " << outputPath << " in "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+              << " s" << std::endl;
+    return 0;
+}
@@ -2,30 +2,74 @@
 #include <fstream>
 #include <memory>
 #include <numeric>
+#include <stdexcept>
 #include "InputData.hpp"
+#include "Options.hpp"
 #include "Algorithm.hpp"
+#include "Batch.hpp"
+#include "Server.hpp"
 
 /**
  * Solution to the problem statement of the HashCode online quallification round 2018.
  * \see https://hashcode.withgoogle.com/2018/tasks/hashcode2018_qualification_task.pdf
  */
 int main(int argc, char *argv[]) {
-    if(argc != 3) {
-        std::cerr << "No input path and output path set." << std::endl;
+    Options options;
+
+    try { options = Options::genFromArgs(argc, argv); }
+    catch(const std::invalid_argument& e) {
+        std::cerr << e.what() << std::endl << Options::usage();
         return 1;
     }
 
+    if(!options.servePath.empty()) {
+        std::unique_ptr<Server> server;
+
+        try { server.reset(new Server(options.servePath, options, options.threads, options.queueSize)); }
+        catch(const std::runtime_error& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+
+        std::cout << "Listening on " << options.servePath << std::endl;
+        server->run();
+        const Server::Stats stats = server->getStats();
+        std::cout << "Served " << stats.served << " requests (" << stats.failed << " failed, "
+                  << stats.rejected << " rejected)." << std::endl;
+        return 0;
+    }
+
+    if(!options.batchDirectory.empty()) {
+        std::unique_ptr<Batch> batch;
+
+        try { batch.reset(new Batch(options)); }
+        catch(const std::invalid_argument& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+
+        const unsigned failed = batch->run();
+        batch->printSummary(std::cout);
+        return failed > 0 ? 1 : 0;
+    }
+
     std::shared_ptr<InputData> inputData;
 
-    try { inputData = InputData::genFromFile(argv[1]); }
+    try { inputData = InputData::genFromFile(options.inputPath); }
     catch(const std::fstream::failure e) {
         std::cerr << e.what() << "(Invalid file or path)" << std::endl;
         return 1;
     }
 
-    std::string outputPath = argv[2];
-    Algorithm algorithm(*inputData, outputPath);
-    algorithm.run();
+    std::unique_ptr<Algorithm> algorithm;
+
+    try { algorithm.reset(new Algorithm(*inputData, options.outputPath, options)); }
+    catch(const std::invalid_argument& e) {
+        std::cerr << e.what() << std::endl << Options::usage();
+        return 1;
+    }
+
+    algorithm->run();
 
     return 0;
 }
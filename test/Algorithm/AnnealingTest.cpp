@@ -0,0 +1,68 @@
+#include <vector>
+#include "AnnealingTest.hpp"
+#include "Annealing.hpp"
+#include "RoutePlan.hpp"
+#include "InstanceGenerator.hpp"
+
+AnnealingTest::AnnealingTest() {
+    InstanceGenerator::Parameters parameters;
+    parameters.rows = 100;
+    parameters.cols = 100;
+    parameters.fleetSize = 10;
+    parameters.nRides = 200;
+    parameters.maxTime = 2000;
+    parameters.seed = 3;
+    uniform = InstanceGenerator(parameters).generate();
+};
+
+bool AnnealingTest::isValid(const Solution& solution) {
+    if(solution.routes.size() != uniform->fleetSize) {return false;}
+
+    std::vector<bool> taken(uniform->nRides, false);
+
+    for(const std::vector<unsigned>& route : solution.routes) {
+        for(const unsigned ride : route) {
+            if(ride >= uniform->nRides || taken[ride]) {return false;}
+
+            taken[ride] = true;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * \test Successfull if annealing with a fixed seed and a short budget returns a valid
+ *       solution that scores at least as much as the initial one.
+ */
+TEST_F(AnnealingTest, neverWorse) {
+    // every car takes every tenth ride, most of them too late
+    Solution initial(uniform->fleetSize);
+
+    for(unsigned ride = 0; ride < uniform->nRides; ++ride) {
+        initial.routes[ride % uniform->fleetSize].push_back(ride);
+    }
+
+    const RoutePlan plan(*uniform, initial);
+    const Solution result = Annealing(*uniform, 0.2, 2, 0.05, 42).run(plan);
+
+    EXPECT_TRUE(isValid(result));
+    EXPECT_GE(RoutePlan(*uniform, result).getScore(), plan.getScore());
+};
+
+/**
+ * \test Successfull if annealing fills an empty solution.
+ */
+TEST_F(AnnealingTest, fillsEmptySolution) {
+    const RoutePlan plan(*uniform, Solution(uniform->fleetSize));
+    const Solution result = Annealing(*uniform, 0.1, 1, 0.05, 7).run(plan);
+
+    EXPECT_TRUE(isValid(result));
+    EXPECT_GT(RoutePlan(*uniform, result).getScore(), 0);
+};
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
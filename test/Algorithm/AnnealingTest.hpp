@@ -0,0 +1,25 @@
+#ifndef ANNEALING_TEST_H
+#define ANNEALING_TEST_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "InputData.hpp"
+#include "Solution.hpp"
+
+class AnnealingTest : public ::testing::Test {
+protected:
+    AnnealingTest();
+
+    /**
+     * Checks that every ride of a solution exists and is taken by at most one car.
+     *
+     * \param [in] solution routes of all cars
+     * \return bool true if the solution is valid
+     */
+    bool isValid(const Solution& solution);
+
+    /** Uniform instance with more rides than the cars can take. */
+    std::shared_ptr<InputData> uniform;
+};
+
+#endif // ANNEALING_TEST_H
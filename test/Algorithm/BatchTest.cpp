@@ -0,0 +1,98 @@
+#include <filesystem>
+#include <fstream>
+#include "BatchTest.hpp"
+#include "ExampleInstance.hpp"
+#include "Batch.hpp"
+
+BatchTest::BatchTest(): directory("testBatchDirectory") {};
+
+void BatchTest::SetUp() {
+    std::filesystem::create_directory(directory);
+
+    for(const std::string name : {"a1.in", "a2.in", "b.in", "a.txt"}) {
+        std::fstream file;
+        file.exceptions(std::fstream::failbit | std::fstream::badbit);
+        file.open(directory + "/" + name, std::fstream::out);
+        file << ExampleInstance::text;
+    }
+};
+
+void BatchTest::TearDown() {
+    std::filesystem::remove_all(directory);
+};
+
+/**
+ * \test Checks the wildcard expansion of Batch::expand.
+ */
+TEST_F(BatchTest, expand) {
+    EXPECT_EQ(Batch::expand(directory + "/a*.in"),
+              std::vector<std::string>({directory + "/a1.in", directory + "/a2.in"}));
+    EXPECT_EQ(Batch::expand(directory + "/?.*"),
+              std::vector<std::string>({directory + "/a.txt", directory + "/b.in"}));
+    EXPECT_EQ(Batch::expand(directory + "/*").size(), 4);
+    EXPECT_EQ(Batch::expand(directory + "/b.in"), std::vector<std::string>({directory + "/b.in"}));
+    EXPECT_TRUE(Batch::expand(directory + "/c.in").empty());
+    EXPECT_TRUE(Batch::expand(directory + "/*.out").empty());
+}
+
+/**
+ * \test Successfull if all jobs are solved and their solutions are written.
+ */
+TEST_F(BatchTest, run) {
+    Options options;
+    options.batchDirectory = directory + "/out";
+    options.inputPaths = {directory + "/a*.in", directory + "/b.in"};
+    options.threads = 2;
+    Batch batch(options);
+
+    EXPECT_EQ(batch.run(), 0);
+    ASSERT_EQ(batch.getJobs().size(), 3);
+
+    for(const Batch::Job& job : batch.getJobs()) {
+        EXPECT_TRUE(job.error.empty());
+        EXPECT_EQ(job.nRides, 3);
+        EXPECT_EQ(job.fleetSize, 2);
+        EXPECT_EQ(job.score, 10);
+        EXPECT_TRUE(std::filesystem::exists(job.outputPath));
+    }
+
+    EXPECT_EQ(batch.getJobs()[2].outputPath, options.batchDirectory + "/b.out");
+
+    options.inputPaths = {directory + "/c.in"};
+    EXPECT_THROW(Batch batch(options), std::invalid_argument);
+}
+
+/**
+ * \test Successfull if input files with the same output file are rejected: the same file
+ *       name in two directories, the same name with another extension or the same file twice.
+ */
+TEST_F(BatchTest, duplicateOutputs) {
+    std::filesystem::create_directory(directory + "/other");
+
+    for(const std::string name : {"other/b.in", "b.txt"}) {
+        std::fstream file;
+        file.exceptions(std::fstream::failbit | std::fstream::badbit);
+        file.open(directory + "/" + name, std::fstream::out);
+        file << ExampleInstance::text;
+    }
+
+    Options options;
+    options.batchDirectory = directory + "/out";
+    options.inputPaths = {directory + "/b.in", directory + "/other/b.in"};
+    EXPECT_THROW(Batch batch(options), std::invalid_argument);
+
+    options.inputPaths = {directory + "/b.*"};
+    EXPECT_THROW(Batch batch(options), std::invalid_argument);
+
+    options.inputPaths = {directory + "/a.*", directory + "/a1.in", directory + "/b.in"};
+    EXPECT_NO_THROW(Batch batch(options));
+
+    options.inputPaths = {directory + "/a1.in", directory + "/a*.in"};
+    EXPECT_THROW(Batch batch(options), std::invalid_argument);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
@@ -0,0 +1,16 @@
+#ifndef BATCH_TEST_H
+#define BATCH_TEST_H
+
+#include <string>
+#include <gtest/gtest.h>
+
+class BatchTest : public ::testing::Test {
+protected:
+    BatchTest();
+    virtual void SetUp();
+    virtual void TearDown();
+
+    std::string directory;
+};
+
+#endif // BATCH_TEST_H
@@ -0,0 +1,154 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <thread>
+#include "CheckpointTest.hpp"
+#include "Checkpoint.hpp"
+
+CheckpointTest::CheckpointTest(): outputPath("testCheckpointFile.out") {};
+
+void CheckpointTest::TearDown() {
+    remove(outputPath.c_str());
+    remove((outputPath + ".tmp").c_str());
+};
+
+std::string CheckpointTest::readFile(const std::string& path) {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+std::string CheckpointTest::format(const Solution& solution) {
+    std::ostringstream stream;
+    solution.write(stream);
+    return stream.str();
+}
+
+Solution CheckpointTest::uniformSolution(const unsigned fleetSize, const unsigned ridesPerCar) {
+    Solution solution(fleetSize);
+
+    for(unsigned car = 0; car < fleetSize; ++car) {
+        for(unsigned ride = 0; ride < ridesPerCar; ++ride) {
+            solution.routes[car].push_back(car * ridesPerCar + ride);
+        }
+    }
+
+    return solution;
+}
+
+/**
+ * \test Successfull if a reader never sees a partial output file while solutions are
+ *       replaced continuously, and no temporary file is left.
+ */
+TEST_F(CheckpointTest, atomicReplace) {
+    const unsigned fleetSize = 200;
+    std::atomic<bool> done(false);
+    unsigned partial = 0;
+    unsigned reads = 0;
+
+    {
+        Checkpoint checkpoint(outputPath, 0, Deadline());
+        checkpoint.offer(uniformSolution(fleetSize, 1), 1);
+
+        std::thread reader([&]() {
+            while(!done) {
+                std::istringstream content(readFile(outputPath));
+                std::string line;
+                unsigned lines = 0;
+
+                // every line starts with the number of rides that follow
+                while(std::getline(content, line)) {
+                    std::istringstream values(line);
+                    unsigned count, ride, rides = 0;
+                    values >> count;
+
+                    while(values >> ride) {++rides;}
+
+                    partial += rides != count;
+                    ++lines;
+                }
+
+                partial += lines != fleetSize;
+                ++reads;
+            }
+        });
+
+        for(unsigned score = 2; score < 100; ++score) {
+            checkpoint.offer(uniformSolution(fleetSize, score % 7 + 1), score);
+        }
+
+        done = true;
+        reader.join();
+        checkpoint.flush();
+    }
+
+    EXPECT_GT(reads, 0);
+    EXPECT_EQ(partial, 0);
+    EXPECT_EQ(readFile(outputPath), format(uniformSolution(fleetSize, 99 % 7 + 1)));
+    EXPECT_FALSE(std::ifstream(outputPath + ".tmp").good());
+};
+
+/**
+ * \test Successfull if a solution with a lower score than the best one is ignored.
+ */
+TEST_F(CheckpointTest, ignoresWorseScore) {
+    Checkpoint checkpoint(outputPath, 0, Deadline());
+    const Solution best = uniformSolution(3, 2);
+    checkpoint.offer(best, 10);
+    checkpoint.offer(uniformSolution(3, 1), 5);
+    checkpoint.flush();
+
+    EXPECT_EQ(checkpoint.getBestScore(), 10);
+    EXPECT_EQ(readFile(outputPath), format(best));
+};
+
+/**
+ * \test Successfull if solutions offered within the interval are only written by a flush,
+ *       and a flush without a new solution doesn't write.
+ */
+TEST_F(CheckpointTest, flushWritesUnwritten) {
+    Checkpoint checkpoint(outputPath, 1000, Deadline());
+    const Solution first = uniformSolution(3, 1);
+    const Solution second = uniformSolution(3, 2);
+
+    // the first offer is due, the second one isn't
+    checkpoint.offer(first, 1);
+    EXPECT_EQ(readFile(outputPath), format(first));
+    checkpoint.offer(second, 2);
+    EXPECT_EQ(readFile(outputPath), format(first));
+
+    checkpoint.flush();
+    EXPECT_EQ(readFile(outputPath), format(second));
+
+    remove(outputPath.c_str());
+    checkpoint.flush();
+    EXPECT_FALSE(std::ifstream(outputPath).good());
+};
+
+/**
+ * \test Successfull if the watchdog writes the best solution and exits the process when the
+ *       deadline expires while the computation is still busy.
+ */
+TEST_F(CheckpointTest, watchdogExitsAtDeadline) {
+    const Solution first = uniformSolution(3, 1);
+    const Solution best = uniformSolution(3, 2);
+
+    EXPECT_EXIT({
+        Checkpoint checkpoint(outputPath, 1000, Deadline(0.2));
+        checkpoint.offer(first, 1);
+        checkpoint.offer(best, 2);
+        std::this_thread::sleep_for(std::chrono::seconds(5));
+        std::exit(1);
+    }, ::testing::ExitedWithCode(0), "");
+
+    EXPECT_EQ(readFile(outputPath), format(best));
+};
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
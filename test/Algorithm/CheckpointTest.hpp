@@ -0,0 +1,41 @@
+#ifndef CHECKPOINT_TEST_H
+#define CHECKPOINT_TEST_H
+
+#include <string>
+#include <gtest/gtest.h>
+#include "Solution.hpp"
+
+class CheckpointTest : public ::testing::Test {
+protected:
+    CheckpointTest();
+    virtual void TearDown();
+
+    /**
+     * Reads a whole file.
+     *
+     * \param [in] path path of the file
+     * \return std::string content (empty if the file doesn't exist)
+     */
+    std::string readFile(const std::string& path);
+
+    /**
+     * Output file content of a solution.
+     *
+     * \param [in] solution routes of all cars
+     * \return std::string content written by Solution::write
+     */
+    std::string format(const Solution& solution);
+
+    /**
+     * Creates a solution in which every car takes the same number of rides.
+     *
+     * \param [in] fleetSize number of cars
+     * \param [in] ridesPerCar number of rides of each car
+     * \return Solution routes of all cars
+     */
+    Solution uniformSolution(const unsigned fleetSize, const unsigned ridesPerCar);
+
+    std::string outputPath;
+};
+
+#endif // CHECKPOINT_TEST_H
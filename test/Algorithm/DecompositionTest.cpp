@@ -0,0 +1,39 @@
+#include <set>
+#include "DecompositionTest.hpp"
+#include "ExampleInstance.hpp"
+#include "Decomposition.hpp"
+
+DecompositionTest::DecompositionTest(): inputData(ExampleInstance::genInputData()) {};
+
+/**
+ * \test Successfull if the merged routes of all regions and time slices
+ *       contain every ride at most once and the score matches the routes.
+ */
+TEST_F(DecompositionTest, validRoutes) {
+    for(unsigned gridSize = 1; gridSize <= 3; ++gridSize) {
+        for(unsigned timeSlices = 1; timeSlices <= 3; ++timeSlices) {
+            Decomposition decomposition(*inputData, "time-left", gridSize, timeSlices, -1, 2);
+            const RoutePlan plan = decomposition.run();
+            const Solution solution = plan.toSolution();
+            std::set<unsigned> rides;
+            unsigned nRides = 0;
+
+            for(const std::vector<unsigned>& route : solution.routes) {
+                rides.insert(route.begin(), route.end());
+                nRides += route.size();
+            }
+
+            EXPECT_EQ(rides.size(), nRides);
+            EXPECT_EQ(nRides + plan.getUnassigned().size(), inputData->nRides);
+            EXPECT_EQ(plan.getScore(), RoutePlan(*inputData, solution).getScore());
+            EXPECT_GE(plan.getScore(), decomposition.getRegionScore());
+            EXPECT_GT(plan.getScore(), 0);
+        }
+    }
+};
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
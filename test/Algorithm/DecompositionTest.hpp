@@ -0,0 +1,16 @@
+#ifndef DECOMPOSITION_TEST_H
+#define DECOMPOSITION_TEST_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "InputData.hpp"
+
+class DecompositionTest : public ::testing::Test {
+protected:
+    DecompositionTest();
+
+    /** Example of the problem statement (see ExampleInstance). */
+    std::shared_ptr<InputData> inputData;
+};
+
+#endif // DECOMPOSITION_TEST_H
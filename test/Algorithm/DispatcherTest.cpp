@@ -0,0 +1,124 @@
+#include <numeric>
+#include <sstream>
+#include "DispatcherTest.hpp"
+#include "Dispatcher.hpp"
+#include "InstanceGenerator.hpp"
+
+DispatcherTest::DispatcherTest() {
+    std::istringstream originStream(
+        "10 10 4 8 0 1000\n"
+        "0 0 0 1 0 1000\n"
+        "0 0 0 2 0 1000\n"
+        "0 0 0 3 0 1000\n"
+        "0 0 0 4 0 1000\n"
+        "0 0 0 5 0 1000\n"
+        "0 0 0 6 0 1000\n"
+        "0 0 0 7 0 1000\n"
+        "0 0 0 8 0 1000\n");
+    origin = InputData::genFromStream(originStream);
+
+    InstanceGenerator::Parameters parameters;
+    parameters.rows = 200;
+    parameters.cols = 200;
+    parameters.fleetSize = 40;
+    parameters.nRides = 600;
+    parameters.maxTime = 5000;
+    parameters.slack = 400;
+    parameters.distribution = "rush-hour";
+    rushHour = InstanceGenerator(parameters).generate();
+};
+
+/**
+ * \test Successfull if a batch only contains the cars free within the window after the
+ *       earliest car, the other cars keep their state.
+ */
+TEST_F(DispatcherTest, window) {
+    std::unique_ptr<Generator> generator = Generator::create(*origin, "time-left");
+    Dispatcher dispatcher(*generator, 10);
+
+    std::vector<int> unassigned(origin->nRides);
+    std::iota(unassigned.begin(), unassigned.end(), 0);
+    Types::CarData cars(origin->fleetSize);
+    cars.t(1) = 5;
+    cars.t(2) = 20;
+    cars.t(3) = 30;
+    dispatcher.reset(cars);
+
+    std::shared_ptr<SearchGraphNode> node;
+    node = dispatcher.generate(unassigned, cars, node);
+
+    ASSERT_TRUE(node);
+    EXPECT_EQ(dispatcher.getBatchSize(), 2);
+    EXPECT_EQ(unassigned.size(), origin->nRides - 2);
+    EXPECT_GT(cars.t(0), 0);
+    EXPECT_GT(cars.t(1), 5);
+    EXPECT_EQ(cars.t(2), 20);
+    EXPECT_EQ(cars.t(3), 30);
+    EXPECT_EQ(dispatcher.getActiveCount(), origin->fleetSize);
+};
+
+/**
+ * \test Successfull if at most 32 cars form a batch even if more are free at the same time,
+ *       the others form the next batch.
+ */
+TEST_F(DispatcherTest, maxBatchSize) {
+    std::unique_ptr<Generator> generator = Generator::create(*rushHour, "time-left");
+    Dispatcher dispatcher(*generator, 0);
+
+    std::vector<int> unassigned(rushHour->nRides);
+    std::iota(unassigned.begin(), unassigned.end(), 0);
+    Types::CarData cars(rushHour->fleetSize);
+    dispatcher.reset(cars);
+
+    std::shared_ptr<SearchGraphNode> node;
+    node = dispatcher.generate(unassigned, cars, node);
+    EXPECT_EQ(dispatcher.getBatchSize(), 32);
+    EXPECT_EQ(unassigned.size(), rushHour->nRides - 32);
+
+    // the assigned cars are free later, the cars left at 0 form the next batch
+    node = dispatcher.generate(unassigned, cars, node);
+    EXPECT_EQ(dispatcher.getBatchSize(), rushHour->fleetSize - 32);
+    EXPECT_EQ(unassigned.size(), rushHour->nRides - rushHour->fleetSize);
+};
+
+/**
+ * \test Successfull if batches of the cars free at the same point in time (window 0) still
+ *       assign every ride that can be finished in time.
+ */
+TEST_F(DispatcherTest, zeroWindow) {
+    std::unique_ptr<Generator> generator = Generator::create(*origin, "time-left");
+    Dispatcher dispatcher(*generator, 0);
+
+    std::vector<int> unassigned(origin->nRides);
+    std::iota(unassigned.begin(), unassigned.end(), 0);
+    Types::CarData cars(origin->fleetSize);
+    cars.t(1) = 1;
+    cars.t(2) = 2;
+    cars.t(3) = 3;
+    dispatcher.reset(cars);
+
+    std::shared_ptr<SearchGraphNode> node;
+    node = dispatcher.generate(unassigned, cars, node);
+    EXPECT_EQ(dispatcher.getBatchSize(), 1);
+
+    while(dispatcher.getActiveCount() > 0) {
+        node = dispatcher.generate(unassigned, cars, node);
+    }
+
+    ASSERT_TRUE(node);
+    EXPECT_TRUE(unassigned.empty());
+
+    unsigned assigned = 0;
+
+    for(const std::vector<unsigned>& route : node->toSolution(origin->fleetSize).routes) {
+        assigned += route.size();
+    }
+
+    EXPECT_EQ(assigned, origin->nRides);
+};
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
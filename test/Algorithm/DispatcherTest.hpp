@@ -0,0 +1,19 @@
+#ifndef DISPATCHER_TEST_H
+#define DISPATCHER_TEST_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "InputData.hpp"
+
+class DispatcherTest : public ::testing::Test {
+protected:
+    DispatcherTest();
+
+    /** Four cars and short rides at the origin, every car can take several of them. */
+    std::shared_ptr<InputData> origin;
+
+    /** Rush hour with more cars than fit into one batch. */
+    std::shared_ptr<InputData> rushHour;
+};
+
+#endif // DISPATCHER_TEST_H
@@ -0,0 +1,34 @@
+#include "ExpiryIndexTest.hpp"
+#include "ExampleInstance.hpp"
+#include "ExpiryIndex.hpp"
+
+ExpiryIndexTest::ExpiryIndexTest(): inputData(ExampleInstance::genInputData()) {};
+
+/**
+ * \test Checks that rides are retired once their latest feasible start (5, 7, 7)
+ *       lies before the given time.
+ */
+TEST_F(ExpiryIndexTest, retireExpiredRides) {
+    ExpiryIndex index(*inputData);
+    std::vector<int> unassigned = {0, 1, 2};
+
+    EXPECT_EQ(index.retire(unassigned, 5), 0);
+    EXPECT_EQ(unassigned, std::vector<int>({0, 1, 2}));
+
+    EXPECT_EQ(index.retire(unassigned, 6), 1);
+    EXPECT_EQ(unassigned, std::vector<int>({1, 2}));
+
+    EXPECT_EQ(index.retire(unassigned, 8), 2);
+    EXPECT_TRUE(unassigned.empty());
+
+    index.reset();
+    unassigned = {0, 2};
+    EXPECT_EQ(index.retire(unassigned, 7), 1);
+    EXPECT_EQ(unassigned, std::vector<int>({2}));
+};
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
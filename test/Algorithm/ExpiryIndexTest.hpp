@@ -0,0 +1,16 @@
+#ifndef EXPIRY_INDEX_TEST_H
+#define EXPIRY_INDEX_TEST_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "InputData.hpp"
+
+class ExpiryIndexTest : public ::testing::Test {
+protected:
+    ExpiryIndexTest();
+
+    /** Example of the problem statement (see ExampleInstance). */
+    std::shared_ptr<InputData> inputData;
+};
+
+#endif // EXPIRY_INDEX_TEST_H
@@ -0,0 +1,79 @@
+#include <set>
+#include <sstream>
+#include "FlowPlannerTest.hpp"
+#include "ExampleInstance.hpp"
+#include "FlowPlanner.hpp"
+
+FlowPlannerTest::FlowPlannerTest(): example(ExampleInstance::genInputData()) {
+    std::istringstream chainStream(
+        "10 10 1 3 2 100\n"
+        "0 0 0 3 0 10\n"
+        "0 3 3 3 3 20\n"
+        "3 3 3 0 6 30\n");
+    chain = InputData::genFromStream(chainStream);
+
+    std::istringstream handOverStream(
+        "10 10 2 2 2 100\n"
+        "0 0 0 3 0 10\n"
+        "0 3 3 3 3 20\n");
+    handOver = InputData::genFromStream(handOverStream);
+};
+
+/**
+ * \test Successfull if the routes contain every ride at most once and the score matches
+ *       the routes for all chain lengths.
+ */
+TEST_F(FlowPlannerTest, validRoutes) {
+    for(unsigned chainLength = 1; chainLength <= 3; ++chainLength) {
+        FlowPlanner planner(*example, chainLength);
+        const RoutePlan plan = planner.run();
+        const Solution solution = plan.toSolution();
+        std::set<unsigned> rides;
+        unsigned nRides = 0;
+
+        for(const std::vector<unsigned>& route : solution.routes) {
+            rides.insert(route.begin(), route.end());
+            nRides += route.size();
+        }
+
+        EXPECT_EQ(rides.size(), nRides);
+        EXPECT_EQ(nRides, planner.getAssigned());
+        EXPECT_EQ(plan.getScore(), RoutePlan(*example, solution).getScore());
+        EXPECT_GT(plan.getScore(), 0);
+    }
+};
+
+/**
+ * \test Successfull if a chain of k rides is assigned by one solve instead of k.
+ */
+TEST_F(FlowPlannerTest, chainsSaveSolves) {
+    FlowPlanner single(*chain, 1);
+    const RoutePlan singlePlan = single.run();
+    EXPECT_EQ(single.getSolveCount(), 3);
+    EXPECT_EQ(singlePlan.getScore(), 15);
+
+    FlowPlanner chained(*chain, 3);
+    const RoutePlan chainedPlan = chained.run();
+    EXPECT_EQ(chained.getSolveCount(), 1);
+    EXPECT_EQ(chainedPlan.getScore(), 15);
+    EXPECT_EQ(chainedPlan.toSolution().routes[0], std::vector<unsigned>({0, 1, 2}));
+};
+
+/**
+ * \test Successfull if a chain isn't planned past k rides: the ride following the first
+ *       car's ride is left to the second car in the same solve instead of being reserved.
+ */
+TEST_F(FlowPlannerTest, chainLimit) {
+    FlowPlanner planner(*handOver, 1);
+    const RoutePlan plan = planner.run();
+    EXPECT_EQ(planner.getSolveCount(), 1);
+    EXPECT_EQ(plan.toSolution().routes[0], std::vector<unsigned>({0}));
+    EXPECT_EQ(plan.toSolution().routes[1], std::vector<unsigned>({1}));
+    EXPECT_EQ(plan.getScore(), 10);
+};
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
@@ -0,0 +1,25 @@
+#ifndef FLOW_PLANNER_TEST_H
+#define FLOW_PLANNER_TEST_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "InputData.hpp"
+
+class FlowPlannerTest : public ::testing::Test {
+protected:
+    FlowPlannerTest();
+
+    /** Example of the problem statement (see ExampleInstance). */
+    std::shared_ptr<InputData> example;
+
+    /** One car and three rides that can be taken back-to-back with bonus. */
+    std::shared_ptr<InputData> chain;
+
+    /**
+     * Two cars and two rides, the second ride follows the first with bonus and can be
+     * started on time by the second car as well.
+     */
+    std::shared_ptr<InputData> handOver;
+};
+
+#endif // FLOW_PLANNER_TEST_H
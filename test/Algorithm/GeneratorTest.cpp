@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include "GeneratorTest.hpp"
+#include "InstanceGenerator.hpp"
+#include "RoutePlan.hpp"
+
+GeneratorTest::GeneratorTest() {
+    InstanceGenerator::Parameters parameters;
+    parameters.rows = 200;
+    parameters.cols = 200;
+    parameters.fleetSize = 40;
+    parameters.nRides = 600;
+    parameters.maxTime = 5000;
+    parameters.slack = 400;
+    parameters.distribution = "rush-hour";
+    rushHour = InstanceGenerator(parameters).generate();
+};
+
+long GeneratorTest::timeLeftScore(Types::CarData& cars) {
+    long score = 0;
+
+    for(unsigned car = 0; car < rushHour->fleetSize; ++car) {
+        score += std::max(static_cast<int>(rushHour->maxTime) - cars.t(car), 0) + cars.p(car);
+    }
+
+    return score;
+}
+
+/**
+ * \test Successfull if pruning columns by reduced costs removes columns without changing the
+ *       optimal sum of the scores of any iteration, and every iteration is certified optimal.
+ */
+TEST_F(GeneratorTest, exactDualPruning) {
+    std::unique_ptr<Generator> reference = Generator::create(*rushHour, "time-left");
+    std::unique_ptr<Generator> pruning = Generator::create(*rushHour, "time-left");
+    pruning->setDualPruning(std::numeric_limits<double>::infinity());
+
+    std::vector<int> unassigned(rushHour->nRides);
+    std::iota(unassigned.begin(), unassigned.end(), 0);
+    Types::CarData cars(rushHour->fleetSize);
+    std::shared_ptr<SearchGraphNode> node, prunedNode;
+
+    // both generators solve the same iterations (optimal assignments may differ on ties)
+    do {
+        std::vector<int> prunedUnassigned = unassigned;
+        Types::CarData prunedCars(cars);
+        prunedNode = pruning->generate(prunedUnassigned, prunedCars, prunedNode);
+        node = reference->generate(unassigned, cars, node);
+
+        EXPECT_EQ(timeLeftScore(prunedCars), timeLeftScore(cars));
+    } while(!reference->getActiveCars().empty());
+
+    EXPECT_GT(pruning->getPrunedColumns(), 0);
+    EXPECT_EQ(pruning->getUncertifiedIterations(), 0);
+};
+
+/**
+ * \test Successfull if a slack below the gap prunes columns and the loss bound is only
+ *       counted for uncertified iterations.
+ */
+TEST_F(GeneratorTest, heuristicDualPruning) {
+    std::unique_ptr<Generator> heuristic = Generator::create(*rushHour, "time-left");
+    heuristic->setDualPruning(50);
+
+    std::vector<int> unassigned(rushHour->nRides);
+    std::iota(unassigned.begin(), unassigned.end(), 0);
+    Types::CarData cars(rushHour->fleetSize);
+    std::shared_ptr<SearchGraphNode> node;
+
+    do {
+        node = heuristic->generate(unassigned, cars, node);
+    } while(!heuristic->getActiveCars().empty());
+
+    EXPECT_GT(heuristic->getPrunedColumns(), 0);
+    EXPECT_EQ(heuristic->getUncertifiedIterations() == 0,
+              heuristic->getPruningLossBound() == 0);
+};
+
+/**
+ * \test Successfull if every scoring name creates a generator that assigns rides and an
+ *       unknown name is rejected.
+ */
+TEST_F(GeneratorTest, scoringNames) {
+    for(const std::string& name : Generator::scoringNames()) {
+        std::unique_ptr<Generator> generator = Generator::create(*rushHour, name);
+        ASSERT_TRUE(generator) << name;
+
+        std::vector<int> unassigned(rushHour->nRides);
+        std::iota(unassigned.begin(), unassigned.end(), 0);
+        Types::CarData cars(rushHour->fleetSize);
+        std::shared_ptr<SearchGraphNode> node;
+        node = generator->generate(unassigned, cars, node);
+
+        EXPECT_TRUE(node) << name;
+        EXPECT_LT(unassigned.size(), rushHour->nRides) << name;
+    }
+
+    EXPECT_THROW(Generator::create(*rushHour, "unknown"), std::invalid_argument);
+};
+
+/**
+ * \test Successfull if the time-left policy reproduces the score of the baseline on
+ *       b_should_be_easy.
+ */
+TEST_F(GeneratorTest, timeLeftBaseline) {
+    std::shared_ptr<InputData> easy = InputData::genFromFile(RESOURCES_DIR "/b_should_be_easy.in");
+    std::unique_ptr<Generator> generator = Generator::create(*easy, "time-left");
+
+    std::vector<int> unassigned(easy->nRides);
+    std::iota(unassigned.begin(), unassigned.end(), 0);
+    Types::CarData cars(easy->fleetSize);
+    std::shared_ptr<SearchGraphNode> node;
+
+    do {
+        node = generator->generate(unassigned, cars, node);
+    } while(!generator->getActiveCars().empty());
+
+    ASSERT_TRUE(node);
+    EXPECT_EQ(RoutePlan(*easy, node->toSolution(easy->fleetSize)).getScore(), 176877);
+};
+
+/**
+ * \test Successfull if cars past the end of the simulation or unable to reach any remaining
+ *       ride in time are retired, while the other cars keep getting rides.
+ */
+TEST_F(GeneratorTest, retireCars) {
+    std::istringstream stream(
+        "10 10 3 2 0 100\n"
+        "0 0 0 5 0 100\n"
+        "9 9 9 8 0 100\n");
+    std::shared_ptr<InputData> small = InputData::genFromStream(stream);
+    std::unique_ptr<Generator> generator = Generator::create(*small, "time-left");
+
+    std::vector<int> unassigned({0, 1});
+    Types::CarData cars(small->fleetSize);
+    // car 1 is past the end, car 2 can't reach any ride in time
+    cars.t(1) = 150;
+    cars.t(2) = 97;
+    std::shared_ptr<SearchGraphNode> node;
+    node = generator->generate(unassigned, cars, node);
+
+    ASSERT_TRUE(node);
+    EXPECT_EQ(generator->getActiveCars(), std::vector<unsigned>({0}));
+    EXPECT_EQ(unassigned.size(), 1);
+    EXPECT_EQ(cars.t(1), 150);
+    EXPECT_EQ(cars.t(2), 97);
+
+    node = generator->generate(unassigned, cars, node);
+    EXPECT_TRUE(unassigned.empty());
+    EXPECT_EQ(cars.p(0), 6);
+};
+
+/**
+ * \test Successfull if only rides starting within the horizon after the earliest car become
+ *       columns, and the horizon is doubled while there are fewer of them than cars.
+ */
+TEST_F(GeneratorTest, horizon) {
+    std::istringstream stream(
+        "10 10 3 5 0 1000\n"
+        "0 0 0 1 0 5\n"
+        "0 0 0 1 10 15\n"
+        "0 0 0 1 20 25\n"
+        "0 0 0 1 30 35\n"
+        "0 0 0 1 40 45\n");
+    std::shared_ptr<InputData> starts = InputData::genFromStream(stream);
+
+    // the ride starting at 0 expired, the rides starting at 10 and 20 are within 15 steps
+    std::unique_ptr<Generator> fixed = Generator::create(*starts, "time-left");
+    fixed->setHorizon(15);
+    std::vector<int> unassigned({0, 1, 2, 3, 4});
+    Types::CarData cars(starts->fleetSize);
+    cars.t(0) = 10;
+    std::vector<unsigned> batch({0});
+    std::shared_ptr<SearchGraphNode> node;
+    node = fixed->generate(unassigned, cars, node, batch);
+
+    ASSERT_TRUE(node);
+    EXPECT_EQ(fixed->getRetiredCount(), 1);
+    EXPECT_DOUBLE_EQ(fixed->getAverageColumns(), 2);
+
+    // three cars at 0 need the rides up to 20: the horizon of 5 is doubled twice
+    std::unique_ptr<Generator> extended = Generator::create(*starts, "time-left");
+    extended->setHorizon(5);
+    unassigned = {0, 1, 2, 3, 4};
+    Types::CarData startCars(starts->fleetSize);
+    std::shared_ptr<SearchGraphNode> startNode;
+    startNode = extended->generate(unassigned, startCars, startNode);
+
+    ASSERT_TRUE(startNode);
+    EXPECT_DOUBLE_EQ(extended->getAverageColumns(), 3);
+    EXPECT_EQ(unassigned, std::vector<int>({3, 4}));
+};
+
+/**
+ * \test Successfull if the lookahead prefers the ride with the best follow-up, and follow-ups
+ *       are only recomputed for new candidate rides or when the follow-up ride was taken.
+ */
+TEST_F(GeneratorTest, followUps) {
+    // rides R0 to R3, one car at the origin
+    std::istringstream stream(
+        "10 10 1 4 10 100\n"
+        "0 0 0 5 0 100\n"
+        "5 0 9 0 5 100\n"
+        "0 0 5 0 0 100\n"
+        "9 9 5 1 50 100\n");
+    std::shared_ptr<InputData> small = InputData::genFromStream(stream);
+    std::unique_ptr<Generator> generator = Generator::create(*small, "time-left");
+    generator->setHorizon(100);
+    generator->setLookahead(1);
+
+    std::vector<int> unassigned({0, 1, 2, 3});
+    Types::CarData cars(small->fleetSize);
+    std::shared_ptr<SearchGraphNode> node;
+    node = generator->generate(unassigned, cars, node);
+
+    ASSERT_TRUE(node);
+    // R2 ends where R1 starts in time for the bonus, R0 has no follow-up worth it
+    EXPECT_EQ(unassigned, std::vector<int>({0, 1, 3}));
+    EXPECT_EQ(cars.x(0), 5);
+    EXPECT_EQ(cars.y(0), 0);
+    EXPECT_EQ(generator->getRecomputedFollowUps(), 4);
+
+    // the follow-up R1 of R2 is taken, but R2 isn't a candidate anymore
+    node = generator->generate(unassigned, cars, node);
+    EXPECT_EQ(unassigned, std::vector<int>({0, 3}));
+    EXPECT_EQ(generator->getRecomputedFollowUps(), 4);
+
+    // the follow-up R1 of R3 is taken
+    node = generator->generate(unassigned, cars, node);
+    EXPECT_EQ(unassigned, std::vector<int>({3}));
+    EXPECT_EQ(generator->getRecomputedFollowUps(), 5);
+
+    // without lookahead R0 and R2 score the same, the first one is taken
+    std::unique_ptr<Generator> greedy = Generator::create(*small, "time-left");
+    greedy->setHorizon(100);
+    unassigned = {0, 1, 2, 3};
+    Types::CarData greedyCars(small->fleetSize);
+    std::shared_ptr<SearchGraphNode> greedyNode;
+    greedyNode = greedy->generate(unassigned, greedyCars, greedyNode);
+
+    ASSERT_TRUE(greedyNode);
+    EXPECT_EQ(unassigned, std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(greedy->getRecomputedFollowUps(), 0);
+};
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
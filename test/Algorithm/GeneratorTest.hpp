@@ -0,0 +1,26 @@
+#ifndef GENERATOR_TEST_H
+#define GENERATOR_TEST_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "InputData.hpp"
+#include "Generator.hpp"
+
+class GeneratorTest : public ::testing::Test {
+protected:
+    GeneratorTest();
+
+    /**
+     * Sum of the time-left scores of all cars: the steps left after the point in time of the
+     * car plus its points. An iteration increases it by the sum of the assigned scores.
+     *
+     * \param [in] cars state of all cars
+     * \return long sum of the scores
+     */
+    long timeLeftScore(Types::CarData& cars);
+
+    /** Rush hour with more cars than fit into a square of the columns. */
+    std::shared_ptr<InputData> rushHour;
+};
+
+#endif // GENERATOR_TEST_H
@@ -0,0 +1,57 @@
+#include "LocalSearchTest.hpp"
+#include "ExampleInstance.hpp"
+#include "RoutePlan.hpp"
+#include "LocalSearch.hpp"
+
+LocalSearchTest::LocalSearchTest(): inputData(ExampleInstance::genInputData()) {};
+
+/**
+ * \test Checks the prefix arrays and constant time evaluations of RoutePlan
+ *       against a simulation of the changed routes.
+ */
+TEST_F(LocalSearchTest, routePlanEvaluation) {
+    Solution solution(2);
+    solution.routes[0] = {0, 1};
+    solution.routes[1] = {2};
+    RoutePlan plan(*inputData, solution);
+
+    EXPECT_EQ(plan.getScore(), 10);
+    EXPECT_TRUE(plan.getUnassigned().empty());
+    EXPECT_EQ(plan.getRoute(0).finish, std::vector<int>({6, 9}));
+    EXPECT_EQ(plan.getRoute(0).points, std::vector<int>({6, 8}));
+
+    // removing ride 0 loses its points and bonus, ride 1 is still on time
+    EXPECT_EQ(plan.removeDelta(0, 0), -6);
+    // ride 0 after ride 2 is too late
+    EXPECT_EQ(plan.insertDelta(1, 1, 0), 0);
+    // ride 1 after ride 2 is on time
+    EXPECT_EQ(plan.replaceDelta(1, 0, 1), 0);
+    // ride 1 moves to the end of car 1
+    EXPECT_EQ(plan.exchangeDelta(0, 1, 1, 1), 0);
+};
+
+/**
+ * \test Successfull if the local search fills an empty solution with
+ *       unassigned rides and never decreases the score.
+ */
+TEST_F(LocalSearchTest, improvesSolution) {
+    RoutePlan plan(*inputData, Solution(inputData->fleetSize));
+    EXPECT_EQ(plan.getScore(), 0);
+    EXPECT_EQ(plan.getUnassigned().size(), 3);
+
+    const unsigned nMoves = LocalSearch(*inputData, 2).run(plan);
+
+    EXPECT_GT(nMoves, 0);
+    EXPECT_EQ(plan.getScore(), 10);
+    EXPECT_TRUE(plan.getUnassigned().empty());
+
+    // the result is stable
+    EXPECT_EQ(LocalSearch(*inputData, 2).run(plan), 0);
+    EXPECT_EQ(RoutePlan(*inputData, plan.toSolution()).getScore(), plan.getScore());
+};
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
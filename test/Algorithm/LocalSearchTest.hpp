@@ -0,0 +1,16 @@
+#ifndef LOCAL_SEARCH_TEST_H
+#define LOCAL_SEARCH_TEST_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "InputData.hpp"
+
+class LocalSearchTest : public ::testing::Test {
+protected:
+    LocalSearchTest();
+
+    /** Example of the problem statement (see ExampleInstance). */
+    std::shared_ptr<InputData> inputData;
+};
+
+#endif // LOCAL_SEARCH_TEST_H
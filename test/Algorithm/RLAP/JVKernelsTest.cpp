@@ -0,0 +1,142 @@
+#include <limits>
+#include "JVKernelsTest.hpp"
+#include "Tensor.hpp"
+#include "RLAPSolverJV.hpp"
+#include "RLAPSolverHungarian.hpp"
+
+JVKernelsTest::JVKernelsTest() : initial(JVKernels::current()), random(1) {
+    for(const JVKernels::Isa isa : {JVKernels::Isa::scalar, JVKernels::Isa::avx2,
+                                    JVKernels::Isa::avx512
+                                   }) {
+        if(JVKernels::supported(isa)) {isas.push_back(isa);}
+    }
+};
+
+void JVKernelsTest::TearDown() {
+    JVKernels::use(initial);
+};
+
+/**
+ * \test Successfull if all instruction sets find the same minimum and second minimum,
+ *       including ties (few distinct values) and lengths that aren't a multiple of the lanes.
+ */
+TEST_F(JVKernelsTest, minTwo) {
+    ASSERT_TRUE(JVKernels::supported(JVKernels::Isa::scalar));
+
+    for(const unsigned n : {1u, 2u, 3u, 7u, 8u, 17u, 100u, 1001u}) {
+        std::uniform_int_distribution<int> value(0, 5);
+        std::vector<double> cost(n);
+        std::vector<double> v(n);
+
+        for(unsigned j = 0; j < n; ++j) {
+            cost[j] = value(random);
+            v[j] = value(random);
+        }
+
+        JVKernels::use(JVKernels::Isa::scalar);
+        const JVKernels::MinTwo expected = JVKernels::minTwo(cost.data(), v.data(), n, 1e15);
+
+        if(n == 1) {EXPECT_EQ(expected.second, 1e15);}
+
+        for(const JVKernels::Isa isa : isas) {
+            JVKernels::use(isa);
+            const JVKernels::MinTwo result = JVKernels::minTwo(cost.data(), v.data(), n, 1e15);
+            EXPECT_EQ(result.min, expected.min) << JVKernels::name(isa) << " " << n;
+            EXPECT_EQ(result.index, expected.index) << JVKernels::name(isa) << " " << n;
+            EXPECT_EQ(result.second, expected.second) << JVKernels::name(isa) << " " << n;
+
+            if(n > 1) {
+                EXPECT_EQ(result.secondIndex, expected.secondIndex) << JVKernels::name(isa);
+            }
+        }
+    }
+}
+
+/**
+ * \test Successfull if all instruction sets relax the same distances and skip excluded
+ *       columns.
+ */
+TEST_F(JVKernelsTest, relax) {
+    const double inf = std::numeric_limits<double>::infinity();
+    const unsigned n = 203;
+    std::uniform_int_distribution<int> value(0, 20);
+    std::vector<double> cost(n);
+    std::vector<double> w(n);
+    std::vector<double> initialD(n);
+
+    for(unsigned j = 0; j < n; ++j) {
+        cost[j] = value(random);
+        w[j] = j % 5 == 0 ? -inf : value(random);
+        initialD[j] = j % 5 == 0 ? inf : value(random);
+    }
+
+    std::vector<double> expectedD = initialD;
+    std::vector<int> expectedPred(n, -1);
+    unsigned expectedArgmin;
+    JVKernels::use(JVKernels::Isa::scalar);
+    const double expectedMin = JVKernels::relax(cost.data(), w.data(), 3, 7, expectedD.data(),
+                               expectedPred.data(), n, expectedArgmin);
+    EXPECT_NE(expectedArgmin % 5, 0);
+
+    for(unsigned j = 0; j < n; j += 5) {
+        EXPECT_EQ(expectedD[j], inf);
+        EXPECT_EQ(expectedPred[j], -1);
+    }
+
+    for(const JVKernels::Isa isa : isas) {
+        JVKernels::use(isa);
+        std::vector<double> d = initialD;
+        std::vector<int> pred(n, -1);
+        unsigned argmin;
+        EXPECT_EQ(JVKernels::relax(cost.data(), w.data(), 3, 7, d.data(), pred.data(), n, argmin),
+                  expectedMin);
+        EXPECT_EQ(argmin, expectedArgmin) << JVKernels::name(isa);
+        EXPECT_EQ(d, expectedD) << JVKernels::name(isa);
+        EXPECT_EQ(pred, expectedPred) << JVKernels::name(isa);
+    }
+}
+
+/**
+ * \test Successfull if RLAPSolverJV finds optimal assignments of random matrices with every
+ *       instruction set (compared with RLAPSolverHungarian).
+ */
+TEST_F(JVKernelsTest, optimalAssignments) {
+    std::uniform_int_distribution<int> score(0, 30);
+
+    for(const std::vector<unsigned>& dims : std::vector<std::vector<unsigned>>({{5, 40}, {17, 17}, {30, 9}})) {
+        Tensor<int> scores(dims);
+
+        for(unsigned row = 0; row < dims[0]; ++row) {
+            for(unsigned col = 0; col < dims[1]; ++col) {
+                scores(row, col) = score(random);
+            }
+        }
+
+        const unsigned nAssignments = std::min(dims[0], dims[1]);
+        Tensor<unsigned> assignments({nAssignments, 2});
+        RLAPSolverHungarian().solve(scores, RLAPSolver::Objective::maximize, assignments);
+        int expected = 0;
+
+        for(unsigned i = 0; i < nAssignments; ++i) {
+            expected += scores(assignments(i, 0), assignments(i, 1));
+        }
+
+        for(const JVKernels::Isa isa : isas) {
+            JVKernels::use(isa);
+            RLAPSolverJV().solve(scores, RLAPSolver::Objective::maximize, assignments);
+            int sum = 0;
+
+            for(unsigned i = 0; i < nAssignments; ++i) {
+                sum += scores(assignments(i, 0), assignments(i, 1));
+            }
+
+            EXPECT_EQ(sum, expected) << JVKernels::name(isa);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
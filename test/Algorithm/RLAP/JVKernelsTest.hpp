@@ -0,0 +1,23 @@
+#ifndef JV_KERNELS_TEST_H
+#define JV_KERNELS_TEST_H
+
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "JVKernels.hpp"
+
+class JVKernelsTest : public ::testing::Test {
+protected:
+    JVKernelsTest();
+    virtual void TearDown();
+
+    /** Instruction sets supported by the CPU. */
+    std::vector<JVKernels::Isa> isas;
+
+    /** Instruction set selected before the test. */
+    JVKernels::Isa initial;
+
+    std::mt19937 random;
+};
+
+#endif // JV_KERNELS_TEST_H
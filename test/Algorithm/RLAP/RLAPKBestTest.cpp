@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <functional>
+#include <set>
+#include "RLAPKBestTest.hpp"
+#include "RLAPKBest.hpp"
+
+RLAPKBestTest::RLAPKBestTest(): random(1) {};
+
+std::vector<long> RLAPKBestTest::allSums(const Tensor<int>& costs,
+        const RLAPSolver::Objective objective) {
+    const unsigned rows = costs.getDims()[0];
+    const unsigned cols = costs.getDims()[1];
+    const bool transposed = rows > cols;
+    const unsigned n = std::min(rows, cols);
+    const unsigned m = std::max(rows, cols);
+    std::vector<long> sums;
+    std::vector<char> used(m, 0);
+
+    // every injective map of the smaller dimension into the larger one
+    std::function<void(unsigned, long)> assign = [&](const unsigned i, const long sum) {
+        if(i == n) {
+            sums.push_back(sum);
+            return;
+        }
+
+        for(unsigned j = 0; j < m; ++j) {
+            if(used[j]) {continue;}
+
+            used[j] = 1;
+            assign(i + 1, sum + (transposed ? costs(j, i) : costs(i, j)));
+            used[j] = 0;
+        }
+    };
+    assign(0, 0);
+
+    std::sort(sums.begin(), sums.end());
+
+    if(objective == RLAPSolver::Objective::maximize) {std::reverse(sums.begin(), sums.end());}
+
+    return sums;
+}
+
+Tensor<int> RLAPKBestTest::randomMatrix(const unsigned rows, const unsigned cols) {
+    Tensor<int> matrix({rows, cols});
+    std::uniform_int_distribution<int> values(0, 9);
+
+    for(unsigned i = 0; i < rows * cols; ++i) {
+        matrix(i) = values(random);
+    }
+
+    return matrix;
+}
+
+/**
+ * \test Successfull if the k best solutions have the k best sums of all solutions found by
+ *       brute force (square and rectangular matrices, both objectives, one and three threads)
+ *       and every solution is a distinct valid assignment with the returned sum.
+ */
+TEST_F(RLAPKBestTest, bruteForce) {
+    const std::vector<std::pair<unsigned, unsigned>> shapes = {
+        {1, 1}, {1, 4}, {4, 1}, {3, 3}, {4, 4}, {3, 6}, {6, 3}, {5, 7}
+    };
+
+    for(const unsigned nThreads : {1u, 3u}) {
+        RLAPKBest enumerator(nThreads);
+
+        for(const auto& shape : shapes) {
+            for(unsigned trial = 0; trial < 4; ++trial) {
+                for(const RLAPSolver::Objective objective : {RLAPSolver::Objective::minimize,
+                                                             RLAPSolver::Objective::maximize
+                                                            }) {
+                    const Tensor<int> matrix = randomMatrix(shape.first, shape.second);
+                    const std::vector<long> expected = allSums(matrix, objective);
+                    const unsigned k = 25;
+                    const std::vector<RLAPKBest::RankedAssignment> best =
+                        enumerator.solve(matrix, objective, k);
+
+                    ASSERT_EQ(best.size(), std::min<std::size_t>(k, expected.size()));
+                    std::set<std::vector<unsigned>> distinct;
+
+                    for(unsigned i = 0; i < best.size(); ++i) {
+                        EXPECT_EQ(best[i].objective, expected[i]);
+
+                        const Tensor<unsigned>& assignments = best[i].assignments;
+                        std::set<unsigned> rows, cols;
+                        std::vector<unsigned> entries;
+                        long sum = 0;
+
+                        for(unsigned j = 0; j < assignments.getDims()[0]; ++j) {
+                            rows.insert(assignments(j, 0));
+                            cols.insert(assignments(j, 1));
+                            entries.insert(entries.end(),
+                                           {assignments(j, 0), assignments(j, 1)});
+                            sum += matrix(assignments(j, 0), assignments(j, 1));
+                        }
+
+                        EXPECT_EQ(rows.size(), std::min(shape.first, shape.second));
+                        EXPECT_EQ(cols.size(), std::min(shape.first, shape.second));
+                        EXPECT_EQ(sum, best[i].objective);
+                        EXPECT_TRUE(distinct.insert(entries).second);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \test Successfull if the lower bounds leave subproblems unsolved when only a few
+ *       solutions of a larger matrix are needed.
+ */
+TEST_F(RLAPKBestTest, skipsSubproblems) {
+    RLAPKBest enumerator;
+    const Tensor<int> matrix = randomMatrix(20, 40);
+    const std::vector<RLAPKBest::RankedAssignment> best =
+        enumerator.solve(matrix, RLAPSolver::Objective::maximize, 5);
+
+    ASSERT_EQ(best.size(), 5);
+    EXPECT_GT(enumerator.getSkippedCount(), 0);
+
+    for(unsigned i = 1; i < best.size(); ++i) {
+        EXPECT_LE(best[i].objective, best[i - 1].objective);
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+}
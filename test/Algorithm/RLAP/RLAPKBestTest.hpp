@@ -0,0 +1,35 @@
+#ifndef RLAP_K_BEST_TEST_H
+#define RLAP_K_BEST_TEST_H
+
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Tensor.hpp"
+#include "RLAPSolver.hpp"
+
+class RLAPKBestTest : public ::testing::Test {
+protected:
+    RLAPKBestTest();
+
+    /**
+     * Sums of all solutions of a small RLAP, found by trying every assignment.
+     *
+     * \param [in] costs matrix of the problem
+     * \param [in] objective whether the sums are sorted ascending or descending
+     * \return std::vector<long> sums of all solutions, best first
+     */
+    std::vector<long> allSums(const Tensor<int>& costs, const RLAPSolver::Objective objective);
+
+    /**
+     * Creates a random matrix with few distinct values (many ties).
+     *
+     * \param [in] rows number of rows
+     * \param [in] cols number of columns
+     * \return Tensor<int> random matrix
+     */
+    Tensor<int> randomMatrix(const unsigned rows, const unsigned cols);
+
+    std::mt19937 random;
+};
+
+#endif // RLAP_K_BEST_TEST_H
@@ -1,23 +1,14 @@
+#include <random>
 #include <unordered_set>
 #include "Tensor.hpp"
 #include "RLAPSolverTest.hpp"
 #include "RLAPSolverHungarian.hpp"
 #include "RLAPSolverJV.hpp"
+#include "RLAPSolverGreedyRegret.hpp"
 
 RLAPSolverTest::RLAPSolverTest() {
-    solvers.push_back([](const Tensor<int>& m) -> RLAPSolver* {
-        int maxEntry = 0;
-
-        for(unsigned row = 0; row < m.getDims()[0]; ++row) {
-            for(unsigned col = 0; col < m.getDims()[1]; ++col) {
-                if(maxEntry < m(row, col)) {
-                    maxEntry = m(row, col);
-                }
-            }
-        }
-        return new RLAPSolverHungarian(m, maxEntry);
-    });
-    solvers.push_back([](const Tensor<int>& m) -> RLAPSolver* {return new RLAPSolverJV(m); });
+    solvers.push_back(std::make_shared<RLAPSolverHungarian>());
+    solvers.push_back(std::make_shared<RLAPSolverJV>());
 }
 
 void RLAPSolverTest::uniqueEntries(const Tensor<unsigned>& assignments,
@@ -84,11 +75,10 @@ TEST_P(RLAPSolverTest, TestingWithRLAPParams) {
                                            inputMatrix.getDims()[1]);
     int expectedSum = param.expectedSum;
 
-    for(SolverCreator sc : solvers) {
-        std::unique_ptr<RLAPSolver> solver(sc(param.inputMatrix));
+    for(std::shared_ptr<RLAPSolver> solver : solvers) {
         Tensor<unsigned> assignments({ nAssignments, 2 }, 0);
 
-        solver->solve(assignments);
+        solver->solve(inputMatrix, RLAPSolver::Objective::maximize, assignments);
         unsigned uniqueRows, uniqueCols;
         uniqueEntries(assignments, uniqueRows, uniqueCols);
 
@@ -98,6 +88,222 @@ TEST_P(RLAPSolverTest, TestingWithRLAPParams) {
     }
 }
 
+/**
+ * \test Successfull if all RLAPSolver implementations minimize the sum when asked to
+ *       and can be reused for all RLA Matrices (growing and shrinking).
+ */
+TEST_F(RLAPSolverTest, MinimizeAndReuse) {
+    const std::vector<std::pair<Tensor<int>, int>> minimal = {
+        {Tensor<int>({3, 3}, {1, 1, 8, 19, 0, 9, 8, 13, 11}), 12},
+        {Tensor<int>({2, 3}, {4, 1, 3, 2, 0, 5}), 3},
+        {Tensor<int>({3, 2}, {4, 2, 1, 0, 3, 5}), 3},
+        {Tensor<int>({1, 1}, 42), 42}
+    };
+
+    for(std::shared_ptr<RLAPSolver> solver : solvers) {
+        for(unsigned repeat = 0; repeat < 2; ++repeat) {
+            for(const auto& test : minimal) {
+                const unsigned nAssignments = std::min(test.first.getDims()[0],
+                                                       test.first.getDims()[1]);
+                Tensor<unsigned> assignments({ nAssignments, 2 }, 0);
+
+                solver->solve(test.first, RLAPSolver::Objective::minimize, assignments);
+                unsigned uniqueRows, uniqueCols;
+                uniqueEntries(assignments, uniqueRows, uniqueCols);
+
+                EXPECT_EQ(nAssignments, uniqueRows);
+                EXPECT_EQ(nAssignments, uniqueCols);
+                EXPECT_EQ(test.second, assignmentSum(assignments, test.first));
+            }
+        }
+    }
+}
+
+/**
+ * \test Successfull if RLAPSolverJV keeps its buffers for smaller problems.
+ */
+TEST_F(RLAPSolverTest, JVKeepsBuffers) {
+    RLAPSolverJV solver;
+    Tensor<unsigned> assignments({ 4, 2 }, 0);
+    solver.solve(Tensor<int>({4, 6}, 1), RLAPSolver::Objective::maximize, assignments);
+    EXPECT_EQ(solver.getCapacity(), 6);
+
+    Tensor<unsigned> fewer({ 2, 2 }, 0);
+    solver.solve(Tensor<int>({2, 2}, {1, 2, 3, 4}), RLAPSolver::Objective::maximize, fewer);
+    EXPECT_EQ(solver.getCapacity(), 6);
+    EXPECT_EQ(assignmentSum(fewer, Tensor<int>({2, 2}, {1, 2, 3, 4})), 5);
+}
+
+/**
+ * \test Successfull if the duals of RLAPSolverJV are feasible and optimal: all reduced costs
+ *       are at least 0, those of the assigned entries are 0 and the dual objective equals the
+ *       (negated) maximal sum.
+ */
+TEST_F(RLAPSolverTest, JVDuals) {
+    RLAPSolverJV solver;
+
+    for(const RLAPTest& test : testParams) {
+        const Tensor<int>& matrix = test.inputMatrix;
+        const unsigned rows = matrix.getDims()[0];
+        const unsigned cols = matrix.getDims()[1];
+        const unsigned size = std::max(rows, cols);
+        Tensor<unsigned> assignments({ std::min(rows, cols), 2 }, 0);
+        solver.solve(matrix, RLAPSolver::Objective::maximize, assignments);
+
+        const std::vector<double>& u = solver.getRowDuals();
+        const std::vector<double>& v = solver.getColumnDuals();
+        double dual = 0;
+
+        for(unsigned row = 0; row < size; ++row) {
+            dual += u[row] + v[row];
+
+            for(unsigned col = 0; col < size; ++col) {
+                const double cost = row < rows && col < cols ? -matrix(row, col) : 0;
+                EXPECT_GE(cost - u[row] - v[col], -1e-9);
+            }
+        }
+
+        for(unsigned i = 0; i < assignments.getDims()[0]; ++i) {
+            const unsigned row = assignments(i, 0);
+            const unsigned col = assignments(i, 1);
+            EXPECT_NEAR(-matrix(row, col) - u[row] - v[col], 0, 1e-9);
+        }
+
+        EXPECT_NEAR(dual, -test.expectedSum, 1e-9);
+    }
+}
+
+/**
+ * \test Successfull if RLAPSolverJV completes an RLAP greedily when its deadline has expired:
+ *       the assignment is valid, not flagged optimal, and its loss is within the bound. An
+ *       RLAP without deadline is solved optimally.
+ */
+TEST_F(RLAPSolverTest, JVDeadline) {
+    std::mt19937 random(11);
+    std::uniform_int_distribution<int> value(0, 1000);
+    RLAPSolverJV solver;
+    unsigned expired = 0;
+
+    for(unsigned trial = 0; trial < 8; ++trial) {
+        const unsigned rows = trial % 2 == 0 ? 60 : 90;
+        const unsigned cols = trial % 2 == 0 ? 90 : 60;
+        const RLAPSolver::Objective objective = trial % 4 < 2 ?
+                                                RLAPSolver::Objective::maximize :
+                                                RLAPSolver::Objective::minimize;
+        Tensor<int> matrix({rows, cols});
+
+        for(unsigned row = 0; row < rows; ++row) {
+            for(unsigned col = 0; col < cols; ++col) {
+                matrix(row, col) = value(random);
+            }
+        }
+
+        const unsigned nAssignments = std::min(rows, cols);
+        Tensor<unsigned> assignments({ nAssignments, 2 }, 0);
+        EXPECT_TRUE(solver.solve(matrix, objective, assignments, Deadline()));
+        EXPECT_EQ(solver.getLossBound(), 0);
+        const int optimum = assignmentSum(assignments, matrix);
+
+        const bool optimal = solver.solve(matrix, objective, assignments, Deadline(1e-9));
+        const int sum = assignmentSum(assignments, matrix);
+        unsigned uniqueRows, uniqueCols;
+        uniqueEntries(assignments, uniqueRows, uniqueCols);
+
+        EXPECT_EQ(uniqueRows, nAssignments);
+        EXPECT_EQ(uniqueCols, nAssignments);
+
+        if(optimal) {
+            EXPECT_EQ(sum, optimum);
+            continue;
+        }
+
+        ++expired;
+        const int loss = objective == RLAPSolver::Objective::maximize ? optimum - sum :
+                         sum - optimum;
+        EXPECT_GE(loss, 0);
+        EXPECT_LE(loss, solver.getLossBound() + 1e-6);
+    }
+
+    EXPECT_GT(expired, 0);
+}
+
+/**
+ * \test Successfull if RLAPSolverGreedyRegret finds valid assignments that are at most as good
+ *       as the optimal ones, exact on the small matrices and by regret instead of by the
+ *       largest entry.
+ */
+TEST_F(RLAPSolverTest, GreedyRegret) {
+    for(const unsigned bids : {0u, 100u}) {
+        RLAPSolverGreedyRegret solver(bids);
+
+        for(const RLAPTest& test : testParams) {
+            const Tensor<int>& matrix = test.inputMatrix;
+            const unsigned nAssignments = std::min(matrix.getDims()[0], matrix.getDims()[1]);
+            Tensor<unsigned> assignments({ nAssignments, 2 }, 0);
+            solver.solve(matrix, RLAPSolver::Objective::maximize, assignments);
+            unsigned uniqueRows, uniqueCols;
+            uniqueEntries(assignments, uniqueRows, uniqueCols);
+
+            EXPECT_EQ(nAssignments, uniqueRows);
+            EXPECT_EQ(nAssignments, uniqueCols);
+            EXPECT_LE(assignmentSum(assignments, matrix), test.expectedSum);
+
+            if(matrix.getDims()[0] == 1 || matrix.getDims()[1] <= 3) {
+                EXPECT_EQ(assignmentSum(assignments, matrix), test.expectedSum);
+            }
+        }
+
+        // the second row loses more without its best column
+        const Tensor<int> regret({2, 2}, {10, 9, 10, 1});
+        Tensor<unsigned> assignments({ 2, 2 }, 0);
+        solver.solve(regret, RLAPSolver::Objective::maximize, assignments);
+        EXPECT_EQ(assignmentSum(assignments, regret), 19);
+
+        solver.solve(regret, RLAPSolver::Objective::minimize, assignments);
+        EXPECT_EQ(assignmentSum(assignments, regret), 11);
+    }
+}
+
+/**
+ * \test Successfull if the auction polish of RLAPSolverGreedyRegret never makes an assignment
+ *       worse and gets close to the optimum (within one per row) on wide random matrices.
+ */
+TEST_F(RLAPSolverTest, GreedyRegretAuction) {
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> value(0, 1000);
+    RLAPSolverJV exact;
+    RLAPSolverGreedyRegret greedy;
+    RLAPSolverGreedyRegret polished(100000);
+
+    for(unsigned trial = 0; trial < 10; ++trial) {
+        const unsigned rows = 5 + trial * 3;
+        const unsigned cols = rows * (1 + trial % 4);
+        Tensor<int> matrix({rows, cols});
+
+        for(unsigned row = 0; row < rows; ++row) {
+            for(unsigned col = 0; col < cols; ++col) {
+                matrix(row, col) = value(random);
+            }
+        }
+
+        Tensor<unsigned> assignments({ rows, 2 }, 0);
+        exact.solve(matrix, RLAPSolver::Objective::maximize, assignments);
+        const int optimum = assignmentSum(assignments, matrix);
+        greedy.solve(matrix, RLAPSolver::Objective::maximize, assignments);
+        const int greedySum = assignmentSum(assignments, matrix);
+        polished.solve(matrix, RLAPSolver::Objective::maximize, assignments);
+        const int polishedSum = assignmentSum(assignments, matrix);
+        unsigned uniqueRows, uniqueCols;
+        uniqueEntries(assignments, uniqueRows, uniqueCols);
+
+        EXPECT_EQ(uniqueRows, rows);
+        EXPECT_EQ(uniqueCols, rows);
+        EXPECT_LE(greedySum, polishedSum);
+        EXPECT_LE(polishedSum, optimum);
+        EXPECT_GE(polishedSum + static_cast<int>(rows), optimum);
+    }
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
@@ -2,7 +2,6 @@
 #define RLAP_SOLVER_TEST_H
 
 #include <list>
-#include <functional>
 #include <memory>
 #include <gtest/gtest.h>
 #include "RLAPSolver.hpp"
@@ -18,14 +17,13 @@ struct RLAPTest {
 
 class RLAPSolverTest: public ::testing::TestWithParam<RLAPTest> {
 protected:
-    using SolverCreator = std::function<RLAPSolver*(const Tensor<int>&)>;
-
     int assignmentSum(const Tensor<unsigned>& assignments, const Tensor<int>& inputMatrix);
     void uniqueEntries(const Tensor<unsigned>& assignments, unsigned& uniqueRows,
                        unsigned& uniqueCols);
     RLAPSolverTest();
 
-    std::list<SolverCreator> solvers;
+    /** All RLAPSolver implementations, reused for every matrix of a test. */
+    std::list<std::shared_ptr<RLAPSolver>> solvers;
 };
 
 #endif // RLAP_SOLVER_TEST_H
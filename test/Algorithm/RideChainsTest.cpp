@@ -0,0 +1,91 @@
+#include <numeric>
+#include <sstream>
+#include "RideChainsTest.hpp"
+#include "RideChains.hpp"
+#include "Generator.hpp"
+#include "RoutePlan.hpp"
+
+RideChainsTest::RideChainsTest() {
+    std::istringstream chainStream(
+        "10 10 1 3 2 100\n"
+        "0 0 0 3 0 10\n"
+        "0 3 3 3 3 20\n"
+        "3 3 3 0 6 30\n");
+    chain = InputData::genFromStream(chainStream);
+    successors = SuccessorGraph::genFromInput(*chain, 4);
+};
+
+/**
+ * \test Successfull if the three rides become one job with the aggregated time window,
+ *       points and bonuses.
+ */
+TEST_F(RideChainsTest, merge) {
+    const RideChains chains(*chain, *successors, 3, 0);
+    const std::shared_ptr<InputData> jobs = chains.getJobs();
+
+    ASSERT_EQ(jobs->nRides, 1);
+    EXPECT_EQ(chains.getMembers()[0], std::vector<unsigned>({0, 1, 2}));
+    EXPECT_EQ(chains.getChainedCount(), 3);
+    EXPECT_EQ(jobs->startX(0), 0);
+    EXPECT_EQ(jobs->startY(0), 0);
+    EXPECT_EQ(jobs->endX(0), 3);
+    EXPECT_EQ(jobs->endY(0), 0);
+    EXPECT_EQ(jobs->startT(0), 0);
+    EXPECT_EQ(jobs->distances(0), 9);
+    // the first ride may start 7 steps late
+    EXPECT_EQ(jobs->endT(0), 16);
+    EXPECT_EQ(chains.getPoints()[0], 9);
+    EXPECT_EQ(chains.getBonuses()[0], 3);
+};
+
+/**
+ * \test Successfull if chains don't exceed the maximal length and no rides are linked if
+ *       the idle time between them is too long.
+ */
+TEST_F(RideChainsTest, limits) {
+    const RideChains pairs(*chain, *successors, 2, 0);
+    ASSERT_EQ(pairs.getJobs()->nRides, 2);
+    EXPECT_EQ(pairs.getMembers()[0], std::vector<unsigned>({0, 1}));
+    EXPECT_EQ(pairs.getMembers()[1], std::vector<unsigned>({2}));
+    EXPECT_EQ(pairs.getJobs()->endT(1), 30);
+
+    std::istringstream gapStream(
+        "10 10 1 2 2 100\n"
+        "0 0 0 3 0 10\n"
+        "0 3 3 3 8 20\n");
+    const std::shared_ptr<InputData> gap = InputData::genFromStream(gapStream);
+    const std::shared_ptr<SuccessorGraph> gapSuccessors = SuccessorGraph::genFromInput(*gap, 4);
+    EXPECT_EQ(RideChains(*gap, *gapSuccessors, 2, 4).getJobs()->nRides, 2);
+    EXPECT_EQ(RideChains(*gap, *gapSuccessors, 2, 5).getJobs()->nRides, 1);
+};
+
+/**
+ * \test Successfull if a generator assigns the job in one iteration and the expanded routes
+ *       earn the points and bonuses of all rides.
+ */
+TEST_F(RideChainsTest, generate) {
+    const RideChains chains(*chain, *successors, 3, 0);
+    std::unique_ptr<Generator> generator = Generator::create(*chains.getJobs(), "time-left");
+    generator->setJobPoints(chains.getPoints(), chains.getBonuses());
+
+    std::vector<int> unassigned(chains.getJobs()->nRides);
+    std::iota(unassigned.begin(), unassigned.end(), 0);
+    Types::CarData cars(chain->fleetSize);
+    std::shared_ptr<SearchGraphNode> node;
+    node = generator->generate(unassigned, cars, node);
+
+    ASSERT_TRUE(node);
+    EXPECT_TRUE(unassigned.empty());
+    EXPECT_EQ(cars.p(0), 15);
+    EXPECT_EQ(cars.t(0), 9);
+
+    const Solution solution = node->toSolution(chain->fleetSize, chains.getMembers());
+    EXPECT_EQ(solution.routes[0], std::vector<unsigned>({0, 1, 2}));
+    EXPECT_EQ(RoutePlan(*chain, solution).getScore(), 15);
+};
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
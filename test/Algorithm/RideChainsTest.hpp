@@ -0,0 +1,20 @@
+#ifndef RIDE_CHAINS_TEST_H
+#define RIDE_CHAINS_TEST_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "InputData.hpp"
+#include "SuccessorGraph.hpp"
+
+class RideChainsTest : public ::testing::Test {
+protected:
+    RideChainsTest();
+
+    /** One car and three rides that can be taken back-to-back with bonus. */
+    std::shared_ptr<InputData> chain;
+
+    /** Successors of the rides of chain. */
+    std::shared_ptr<SuccessorGraph> successors;
+};
+
+#endif // RIDE_CHAINS_TEST_H
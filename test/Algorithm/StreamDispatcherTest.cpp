@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <sstream>
+#include <vector>
+#include "StreamDispatcherTest.hpp"
+#include "StreamDispatcher.hpp"
+#include "RoutePlan.hpp"
+#include "InstanceGenerator.hpp"
+
+StreamDispatcherTest::StreamDispatcherTest() {
+    InstanceGenerator::Parameters parameters;
+    parameters.rows = 200;
+    parameters.cols = 200;
+    parameters.fleetSize = 40;
+    parameters.nRides = 600;
+    parameters.maxTime = 5000;
+    parameters.slack = 400;
+    parameters.distribution = "rush-hour";
+    rushHour = InstanceGenerator(parameters).generate();
+};
+
+/**
+ * \test Successfull if a ride is only assigned once it's revealed: the car could reach the
+ *       far ride in time if it was known from the start, but not after it's revealed.
+ */
+TEST_F(StreamDispatcherTest, revealTime) {
+    std::istringstream stream(
+        "10 10 1 2 0 100\n"
+        "0 0 0 1 0 100\n"
+        "9 9 9 8 20 21\n");
+    std::shared_ptr<InputData> farRide = InputData::genFromStream(stream);
+    std::unique_ptr<Generator> generator = Generator::create(*farRide, "time-left");
+
+    const StreamDispatcher::Report late = StreamDispatcher(*farRide, *generator, 5, 0).run();
+    EXPECT_EQ(late.assigned, 1);
+    EXPECT_EQ(late.solution.routes[0], std::vector<unsigned>({0}));
+
+    const StreamDispatcher::Report early = StreamDispatcher(*farRide, *generator, 20, 0).run();
+    EXPECT_EQ(early.assigned, 2);
+    EXPECT_EQ(early.solution.routes[0], std::vector<unsigned>({0, 1}));
+
+    // no ride of a larger stream starts before it's revealed
+    const int leadTime = 100;
+    std::unique_ptr<Generator> rushGenerator = Generator::create(*rushHour, "time-left");
+    const StreamDispatcher::Report report = StreamDispatcher(*rushHour, *rushGenerator,
+                                            leadTime, 10).run();
+    const RoutePlan plan(*rushHour, report.solution);
+
+    for(unsigned car = 0; car < plan.getRouteCount(); ++car) {
+        const RoutePlan::Route& route = plan.getRoute(car);
+
+        for(unsigned i = 0; i < route.rides.size(); ++i) {
+            const int ride = route.rides[i];
+            EXPECT_GE(route.finish[i] - rushHour->distances(ride),
+                      rushHour->startT(ride) - leadTime);
+        }
+    }
+};
+
+/**
+ * \test Successfull if a committed ride isn't given up for a ride revealed later, although
+ *       taking the later ride first would serve both.
+ */
+TEST_F(StreamDispatcherTest, finalAssignments) {
+    std::istringstream stream(
+        "10 10 1 2 0 100\n"
+        "0 0 0 5 0 100\n"
+        "0 1 0 2 1 2\n");
+    std::shared_ptr<InputData> twoRides = InputData::genFromStream(stream);
+    std::unique_ptr<Generator> generator = Generator::create(*twoRides, "time-left");
+
+    const StreamDispatcher::Report report = StreamDispatcher(*twoRides, *generator, 0, 0).run();
+    EXPECT_EQ(report.assigned, 1);
+    EXPECT_EQ(report.solution.routes[0], std::vector<unsigned>({0}));
+
+    // every ride of a larger stream is committed to at most one car
+    std::unique_ptr<Generator> rushGenerator = Generator::create(*rushHour, "time-left");
+    const StreamDispatcher::Report rushReport = StreamDispatcher(*rushHour, *rushGenerator,
+            100, 10).run();
+    std::vector<bool> taken(rushHour->nRides, false);
+    unsigned assigned = 0;
+
+    for(const std::vector<unsigned>& route : rushReport.solution.routes) {
+        for(const unsigned ride : route) {
+            EXPECT_FALSE(taken[ride]);
+            taken[ride] = true;
+            ++assigned;
+        }
+    }
+
+    EXPECT_EQ(rushReport.assigned, assigned);
+};
+
+/**
+ * \test Successfull if every decision has a latency and the wall-clock time gives a
+ *       throughput.
+ */
+TEST_F(StreamDispatcherTest, statistics) {
+    std::unique_ptr<Generator> generator = Generator::create(*rushHour, "time-left");
+    const StreamDispatcher::Report report = StreamDispatcher(*rushHour, *generator, 100,
+                                            10).run();
+
+    ASSERT_FALSE(report.latencies.empty());
+    EXPECT_GE(*std::min_element(report.latencies.begin(), report.latencies.end()), 0);
+    EXPECT_LE(report.latency(0.5), report.latency(0.99));
+    EXPECT_LE(report.latency(0.99), report.latency(1));
+    EXPECT_GT(report.wallTime, 0);
+    EXPECT_GT(report.throughput(rushHour->nRides), 0);
+    EXPECT_GT(report.assigned, 0);
+};
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
@@ -0,0 +1,16 @@
+#ifndef STREAM_DISPATCHER_TEST_H
+#define STREAM_DISPATCHER_TEST_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "InputData.hpp"
+
+class StreamDispatcherTest : public ::testing::Test {
+protected:
+    StreamDispatcherTest();
+
+    /** Rush hour with rides revealed throughout the simulation. */
+    std::shared_ptr<InputData> rushHour;
+};
+
+#endif // STREAM_DISPATCHER_TEST_H
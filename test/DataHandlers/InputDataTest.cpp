@@ -1,4 +1,6 @@
+#include <cstdint>
 #include <fstream>
+#include <sstream>
 #include <stdio.h>
 #include "InputDataTest.hpp"
 
@@ -66,6 +68,68 @@ TEST_F(InputDataTest, stringOutput) {
     EXPECT_EQ(exampleInputData.str(), expectedOutput);
 };
 
+/**
+ * \test Checks if InputData::genFromRides takes over the selected rides in order.
+ */
+TEST_F(InputDataTest, subsetOfRides) {
+    const InputData exampleInputData = *InputData::genFromFile(inputFile);
+    const InputData subset = *InputData::genFromRides(exampleInputData, {2, 0}, 1);
+    EXPECT_EQ(subset.rows, 3);
+    EXPECT_EQ(subset.cols, 4);
+    EXPECT_EQ(subset.fleetSize, 1);
+    EXPECT_EQ(subset.nRides, 2);
+    EXPECT_EQ(subset.startX(0), 2);
+    EXPECT_EQ(subset.endY(0), 2);
+    EXPECT_EQ(subset.distances(0), 2);
+    EXPECT_EQ(subset.endY(1), 3);
+    EXPECT_EQ(subset.endT(1), 9);
+};
+
+/**
+ * \test Checks if InputData::writeSnapshot and InputData::genFromSnapshot restore all rides
+ *       and if InputData::genFromFile detects snapshots.
+ */
+TEST_F(InputDataTest, snapshot) {
+    const InputData exampleInputData = *InputData::genFromFile(inputFile);
+    std::stringstream stream;
+    exampleInputData.writeSnapshot(stream);
+    const InputData restored = *InputData::genFromSnapshot(stream);
+    EXPECT_EQ(restored.str(), exampleInputData.str());
+
+    for(unsigned ride = 0; ride < exampleInputData.nRides; ++ride) {
+        EXPECT_EQ(restored.startX(ride), exampleInputData.startX(ride));
+        EXPECT_EQ(restored.startY(ride), exampleInputData.startY(ride));
+        EXPECT_EQ(restored.endX(ride), exampleInputData.endX(ride));
+        EXPECT_EQ(restored.endY(ride), exampleInputData.endY(ride));
+        EXPECT_EQ(restored.startT(ride), exampleInputData.startT(ride));
+        EXPECT_EQ(restored.endT(ride), exampleInputData.endT(ride));
+        EXPECT_EQ(restored.distances(ride), exampleInputData.distances(ride));
+    }
+
+    std::fstream outFile(inputFile, std::fstream::out | std::fstream::binary);
+    exampleInputData.writeSnapshot(outFile);
+    outFile.close();
+    EXPECT_EQ(InputData::genFromFile(inputFile)->str(), exampleInputData.str());
+
+    std::istringstream invalid("RDSNAPXX");
+    EXPECT_THROW(InputData::genFromSnapshot(invalid), std::ios_base::failure);
+
+    // the number of rides of the header has to match the size of the payload
+    std::stringstream snapshot;
+    exampleInputData.writeSnapshot(snapshot);
+    std::string truncated = snapshot.str();
+    truncated.pop_back();
+    std::istringstream truncatedStream(truncated);
+    EXPECT_THROW(InputData::genFromSnapshot(truncatedStream), std::ios_base::failure);
+
+    std::string forged = snapshot.str();
+    const std::uint32_t nRides = 1u << 30;
+    forged.replace(sizeof(InputData::SNAPSHOT_MAGIC) + 3 * sizeof(std::uint32_t),
+                   sizeof(nRides), reinterpret_cast<const char*>(&nRides), sizeof(nRides));
+    std::istringstream forgedStream(forged);
+    EXPECT_THROW(InputData::genFromSnapshot(forgedStream), std::ios_base::failure);
+};
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
@@ -66,6 +66,20 @@ TEST_F(SearchGraphNodeTest, multipleEntries) {
     EXPECT_EQ(getOutputFileContent(), "2 0 1\n");
 }
 
+/** \test Composite jobs are replaced by their rides in the order they are taken. */
+TEST_F(SearchGraphNodeTest, expandJobs) {
+    std::unique_ptr<Tensor<unsigned>> entries1(new Tensor<unsigned>({2, 2}, {0, 1, 1, 0}));
+    std::unique_ptr<Tensor<unsigned>> entries2(new Tensor<unsigned>({1, 2}, {0, 2}));
+    std::shared_ptr<SearchGraphNode> parent(new SearchGraphNode(entries1));
+    SearchGraphNode sut(parent, entries2);
+    const std::vector<std::vector<unsigned>> jobs = {{3, 0}, {4}, {1, 5, 2}};
+
+    const Solution solution = sut.toSolution(2, jobs);
+
+    EXPECT_EQ(solution.routes[0], std::vector<unsigned>({4, 1, 5, 2}));
+    EXPECT_EQ(solution.routes[1], std::vector<unsigned>({3, 0}));
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
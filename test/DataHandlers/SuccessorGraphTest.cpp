@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdio.h>
+#include <utility>
+#include <vector>
+#include "SuccessorGraphTest.hpp"
+#include "ExampleInstance.hpp"
+#include "SuccessorGraph.hpp"
+
+SuccessorGraphTest::SuccessorGraphTest() {
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> coordinate(0, 49);
+    std::uniform_int_distribution<int> time(0, 400);
+    std::uniform_int_distribution<int> window(0, 60);
+    std::vector<int> rides;
+
+    for(unsigned i = 0; i < 200; ++i) {
+        const int startX = coordinate(generator), startY = coordinate(generator);
+        const int endX = coordinate(generator), endY = coordinate(generator);
+        const int startT = time(generator);
+        const int endT = startT + std::abs(startX - endX) + std::abs(startY - endY) +
+                         window(generator);
+        rides.insert(rides.end(), {startX, startY, endX, endY, startT, endT});
+    }
+
+    random = InputData::genFromValues(50, 50, 10, 5, 500, rides);
+};
+
+/**
+ * \test Successfull if the successors of every ride are the best feasible ones found by
+ *       checking all pairs, with the right distances and slacks.
+ */
+TEST_F(SuccessorGraphTest, bruteForce) {
+    const unsigned maxSuccessors = 6;
+    const std::shared_ptr<SuccessorGraph> graph = SuccessorGraph::genFromInput(*random,
+            maxSuccessors, 1);
+    ASSERT_EQ(graph->getRideCount(), random->nRides);
+    ASSERT_EQ(graph->getMaxSuccessors(), maxSuccessors);
+
+    for(unsigned ride = 0; ride < random->nRides; ++ride) {
+        const int finish = random->startT(ride) + random->distances(ride);
+        std::vector<std::pair<long, unsigned>> expected;
+
+        for(unsigned next = 0; next < random->nRides; ++next) {
+            const int distance = std::abs(random->endX(ride) - random->startX(next)) +
+                                 std::abs(random->endY(ride) - random->startY(next));
+
+            if(next != ride && finish + distance + random->distances(next) <= random->endT(next)) {
+                expected.push_back({std::max(distance, random->startT(next) - finish), next});
+            }
+        }
+
+        std::sort(expected.begin(), expected.end());
+        expected.resize(std::min<std::size_t>(expected.size(), maxSuccessors));
+        const SuccessorGraph::Successors successors = graph->successors(ride);
+        ASSERT_EQ(successors.size, expected.size());
+
+        for(unsigned k = 0; k < successors.size; ++k) {
+            const unsigned next = successors.rides[k];
+            const int distance = std::abs(random->endX(ride) - random->startX(next)) +
+                                 std::abs(random->endY(ride) - random->startY(next));
+            EXPECT_EQ(next, expected[k].second);
+            EXPECT_EQ(successors.distances[k], distance);
+            EXPECT_EQ(successors.slacks[k],
+                      random->endT(next) - random->distances(next) - finish - distance);
+        }
+    }
+};
+
+/**
+ * \test Successfull if the graph doesn't depend on the number of threads.
+ */
+TEST_F(SuccessorGraphTest, threads) {
+    // more rides than one thread takes at once
+    std::vector<int> rides;
+
+    for(unsigned i = 0; i < 1000; ++i) {
+        const int startT = (i * 37) % 900;
+        rides.insert(rides.end(), {static_cast<int>(i % 31), static_cast<int>(i % 17),
+                                   static_cast<int>(i % 13), static_cast<int>(i % 29),
+                                   startT, startT + 100});
+    }
+
+    const std::shared_ptr<InputData> many = InputData::genFromValues(40, 40, 10, 2, 1000, rides);
+    std::ostringstream single, parallel;
+    SuccessorGraph::genFromInput(*many, 8, 1)->write(single);
+    SuccessorGraph::genFromInput(*many, 8, 4)->write(parallel);
+    EXPECT_EQ(single.str(), parallel.str());
+};
+
+/**
+ * \test Successfull if a written graph is read back unchanged and only for its InputData.
+ */
+TEST_F(SuccessorGraphTest, cache) {
+    const std::shared_ptr<SuccessorGraph> graph = SuccessorGraph::genFromInput(*random, 4);
+    std::stringstream stream;
+    graph->write(stream);
+    const std::string written = stream.str();
+
+    const std::shared_ptr<SuccessorGraph> read = SuccessorGraph::genFromStream(stream, *random);
+    EXPECT_EQ(read->getEdgeCount(), graph->getEdgeCount());
+    EXPECT_EQ(read->getMaxSuccessors(), 4);
+    std::ostringstream rewritten;
+    read->write(rewritten);
+    EXPECT_EQ(rewritten.str(), written);
+
+    const std::shared_ptr<InputData> example = ExampleInstance::genInputData();
+    std::istringstream other(written);
+    EXPECT_THROW(SuccessorGraph::genFromStream(other, *example), std::ios_base::failure);
+
+    std::istringstream truncated(written.substr(0, written.size() / 2));
+    EXPECT_THROW(SuccessorGraph::genFromStream(truncated, *random), std::ios_base::failure);
+
+    std::istringstream text(ExampleInstance::text);
+    EXPECT_THROW(SuccessorGraph::genFromStream(text, *random), std::ios_base::failure);
+
+    // the offsets follow the magic, the header and the fingerprint, the successors the offsets
+    const std::size_t offsetsStart = sizeof(SuccessorGraph::CACHE_MAGIC) +
+                                     3 * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+    const std::size_t ridesStart = offsetsStart + (random->nRides + 1) * sizeof(std::uint32_t);
+    auto patched = [&](const std::size_t position, const std::uint32_t value) {
+        std::string result = written;
+        std::memcpy(&result[position], &value, sizeof(value));
+        return result;
+    };
+
+    std::istringstream decreasing(patched(offsetsStart + sizeof(std::uint32_t),
+                                          graph->getEdgeCount()));
+    EXPECT_THROW(SuccessorGraph::genFromStream(decreasing, *random), std::ios_base::failure);
+
+    std::istringstream outOfRange(patched(ridesStart, random->nRides));
+    EXPECT_THROW(SuccessorGraph::genFromStream(outOfRange, *random), std::ios_base::failure);
+};
+
+TEST_F(SuccessorGraphTest, cachedFile) {
+    const std::string path = "testSuccessorGraph.cache";
+    const std::shared_ptr<SuccessorGraph> built = SuccessorGraph::genCached(*random, 4, path);
+    EXPECT_TRUE(std::ifstream(path).good());
+
+    const std::shared_ptr<SuccessorGraph> cached = SuccessorGraph::genCached(*random, 4, path);
+    EXPECT_EQ(cached->getEdgeCount(), built->getEdgeCount());
+    remove(path.c_str());
+};
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
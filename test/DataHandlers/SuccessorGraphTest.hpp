@@ -0,0 +1,16 @@
+#ifndef SUCCESSOR_GRAPH_TEST_H
+#define SUCCESSOR_GRAPH_TEST_H
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "InputData.hpp"
+
+class SuccessorGraphTest : public ::testing::Test {
+protected:
+    SuccessorGraphTest();
+
+    /** Random rides, fewer than SuccessorGraph::LATE_SCAN so all successors are found. */
+    std::shared_ptr<InputData> random;
+};
+
+#endif // SUCCESSOR_GRAPH_TEST_H
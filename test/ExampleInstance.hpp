@@ -0,0 +1,34 @@
+#ifndef EXAMPLE_INSTANCE_H
+#define EXAMPLE_INSTANCE_H
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include "InputData.hpp"
+
+/**
+ * Example of the problem statement shared by the tests: 2 cars and 3 rides, the example
+ * solution scores 10.
+ */
+namespace ExampleInstance {
+
+/** Example as input file. */
+inline const std::string text =
+    "3 4 2 3 2 10\n"
+    "0 0 1 3 2 9\n"
+    "1 2 1 0 0 9\n"
+    "2 0 2 2 0 9\n";
+
+/**
+ * Reads the example without a file.
+ *
+ * \return std::shared_ptr<InputData> example instance
+ */
+inline std::shared_ptr<InputData> genInputData() {
+    std::istringstream stream(text);
+    return InputData::genFromStream(stream);
+}
+
+}
+
+#endif // EXAMPLE_INSTANCE_H
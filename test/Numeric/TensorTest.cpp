@@ -107,6 +107,31 @@ TEST(TensorTest, 3DIndexAccess) {
     }
 }
 
+/** \test Success if reshaping changes the dimensions and keeps large enough data. */
+TEST(TensorTest, Reshape) {
+    Tensor<int> sut({2, 3}, 7);
+    const int* data = &sut(0);
+
+    sut.reshape({3, 2});
+    EXPECT_EQ(sut.getSize(), 6);
+    EXPECT_THAT(sut.getDims(), ::testing::ElementsAre(3, 2));
+    EXPECT_EQ(&sut(0), data);
+    EXPECT_EQ(sut(2, 1), 7);
+
+    sut.reshape({1, 4});
+    EXPECT_EQ(sut.getSize(), 4);
+    EXPECT_EQ(&sut(0), data);
+
+    sut.reshape({4, 4});
+    EXPECT_EQ(sut.getSize(), 16);
+    sut(3, 3) = 1;
+    EXPECT_EQ(sut(15), 1);
+
+    sut.reshape({0});
+    EXPECT_EQ(sut.getSize(), 0);
+    EXPECT_TRUE(sut.getDims().empty());
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
@@ -0,0 +1,76 @@
+#include <fstream>
+#include <stdio.h>
+#include "RideScorerTest.hpp"
+#include "ExampleInstance.hpp"
+#include "RideScorer.hpp"
+#include "RoutePlan.hpp"
+
+RideScorerTest::RideScorerTest():
+    outputFile("testRideScorer.out"), inputData(ExampleInstance::genInputData()) {};
+
+void RideScorerTest::SetUp() {
+    // RideScorer::readFile reads the example solution from a file
+    std::fstream file;
+    file.exceptions(std::fstream::failbit | std::fstream::badbit);
+    file.open(outputFile, std::fstream::out);
+    file << "1 0\n2 2 1\n";
+};
+
+void RideScorerTest::TearDown() {
+    remove(outputFile.c_str());
+};
+
+/**
+ * \test Checks the score and statistics of the example solution.
+ */
+TEST_F(RideScorerTest, score) {
+    const RideScorer scorer(*inputData, 2);
+    const RideScorer::Report report = scorer.score(RideScorer::readFile(outputFile));
+    EXPECT_EQ(report.score, 10);
+    EXPECT_EQ(report.assigned, 3);
+    EXPECT_EQ(report.onTimeCount, 3);
+    EXPECT_EQ(report.bonusCount, 1);
+    EXPECT_EQ(report.idleDistance, 3);
+
+    EXPECT_THROW(RideScorer::readFile("noneExistingFile.out"), std::fstream::failure);
+}
+
+/**
+ * \test Successfull if the score equals the one of RoutePlan for a late ride.
+ */
+TEST_F(RideScorerTest, sameAsRoutePlan) {
+    Solution solution(2);
+    solution.routes[0] = {2, 0};
+    solution.routes[1] = {1};
+
+    for(const unsigned nThreads : {1u, 2u, 8u}) {
+        EXPECT_EQ(RideScorer(*inputData, nThreads).score(solution).score,
+                  RoutePlan(*inputData, solution).getScore());
+    }
+}
+
+/**
+ * \test Checks if invalid files and solutions are detected.
+ */
+TEST_F(RideScorerTest, invalidSolutions) {
+    const RideScorer scorer(*inputData, 2);
+    auto scoreText = [&](const std::string& text) {
+        return scorer.score(RideScorer::parse(text.data(), text.data() + text.size()));
+    };
+
+    EXPECT_EQ(scoreText("1 0\r\n2 2 1\r\n\n").score, 10);
+    EXPECT_EQ(scoreText("0\n0").score, 0);
+    EXPECT_THROW(scoreText("1 0\n2 2 0\n"), std::invalid_argument);
+    EXPECT_THROW(scoreText("1 0\n1 3\n"), std::invalid_argument);
+    EXPECT_THROW(scoreText("1 0\n"), std::invalid_argument);
+    EXPECT_THROW(scoreText("1 0\n\n1 1\n"), std::invalid_argument);
+    EXPECT_THROW(scoreText("1 0 1\n1 2\n"), std::invalid_argument);
+    EXPECT_THROW(scoreText("2 0\n1 1\n"), std::invalid_argument);
+    EXPECT_THROW(scoreText("1 x\n1 1\n"), std::invalid_argument);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
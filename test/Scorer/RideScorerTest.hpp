@@ -0,0 +1,21 @@
+#ifndef RIDE_SCORER_TEST_H
+#define RIDE_SCORER_TEST_H
+
+#include <memory>
+#include <string>
+#include <gtest/gtest.h>
+#include "InputData.hpp"
+
+class RideScorerTest : public ::testing::Test {
+protected:
+    RideScorerTest();
+    virtual void SetUp();
+    virtual void TearDown();
+
+    std::string outputFile;
+
+    /** Example of the problem statement (see ExampleInstance). */
+    std::shared_ptr<InputData> inputData;
+};
+
+#endif // RIDE_SCORER_TEST_H
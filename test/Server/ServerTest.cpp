@@ -0,0 +1,144 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include "ServerTest.hpp"
+#include "ExampleInstance.hpp"
+#include "Client.hpp"
+#include "InputData.hpp"
+
+ServerTest::ServerTest(): socketPath("testServer.sock") {};
+
+void ServerTest::SetUp() {
+    Options options;
+    options.idleTimeout = 0.5;
+    options.maxPayload = 1 << 16;
+    server.reset(new Server(socketPath, options, 2, 4));
+    thread = std::thread([this]() {server->run();});
+};
+
+void ServerTest::TearDown() {
+    server->stop();
+    thread.join();
+    server.reset();
+};
+
+/**
+ * \test Successfull if text and binary instances are solved on one connection and
+ *       the solutions are returned.
+ */
+TEST_F(ServerTest, solve) {
+    Client client(socketPath);
+    const Client::Response text = client.solve(ExampleInstance::text, false);
+    EXPECT_EQ(text.score, 10);
+    EXPECT_EQ(text.rides, 3);
+
+    std::ostringstream snapshot;
+    ExampleInstance::genInputData()->writeSnapshot(snapshot);
+    const Client::Response binary = client.solve(snapshot.str(), true, 1);
+    EXPECT_EQ(binary.score, 10);
+    EXPECT_EQ(binary.solution, text.solution);
+
+    EXPECT_EQ(server->getStats().served, 2);
+    EXPECT_EQ(client.stats().compare(0, 15, "STATS served=2 "), 0);
+}
+
+/**
+ * \test Successfull if an invalid instance is answered with an error and the connection
+ *       stays usable.
+ */
+TEST_F(ServerTest, invalidRequest) {
+    Client client(socketPath);
+    EXPECT_THROW(client.solve("RDSNAP01", true), std::runtime_error);
+    EXPECT_EQ(client.solve(ExampleInstance::text, false).score, 10);
+    EXPECT_EQ(server->getStats().failed, 1);
+}
+
+/**
+ * \test Successfull if several clients are served concurrently.
+ */
+TEST_F(ServerTest, concurrentClients) {
+    std::vector<std::thread> clients;
+    std::vector<long> scores(3, 0);
+
+    for(unsigned i = 0; i < scores.size(); ++i) {
+        clients.emplace_back([&, i]() {
+            scores[i] = Client(socketPath).solve(ExampleInstance::text, false).score;
+        });
+    }
+
+    for(std::thread& client : clients) {
+        client.join();
+    }
+
+    EXPECT_EQ(scores, std::vector<long>(3, 10));
+    EXPECT_EQ(server->getStats().served, 3);
+}
+
+/**
+ * \test Successfull if idle connections are closed, so that a client waiting behind them in
+ *       the queue is served although they keep all workers busy.
+ */
+TEST_F(ServerTest, idleTimeout) {
+    Client first(socketPath);
+    Client second(socketPath);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    EXPECT_EQ(Client(socketPath).solve(ExampleInstance::text, false).score, 10);
+    EXPECT_THROW(first.solve(ExampleInstance::text, false), std::runtime_error);
+    EXPECT_THROW(second.stats(), std::runtime_error);
+}
+
+/**
+ * \test Successfull if oversized header lines and payloads are refused with an error before
+ *       they are received, and snapshots whose number of rides doesn't match their size are
+ *       invalid instances.
+ */
+TEST_F(ServerTest, requestLimits) {
+    Connection connection(Connection::connectTo(socketPath));
+    ASSERT_TRUE(connection.write(std::string(Connection::MAX_LINE_LENGTH + 1, 'x')));
+    std::string line;
+    ASSERT_TRUE(connection.readLine(line));
+    EXPECT_EQ(line, "ERROR request too large");
+
+    EXPECT_THROW(Client(socketPath).solve(std::string(1 << 17, ' '), false),
+                 std::runtime_error);
+    EXPECT_EQ(server->getStats().failed, 2);
+
+    std::ostringstream snapshot;
+    ExampleInstance::genInputData()->writeSnapshot(snapshot);
+    Client client(socketPath);
+    EXPECT_THROW(client.solve(snapshot.str() + "x", true), std::runtime_error);
+    EXPECT_EQ(client.solve(snapshot.str(), true).score, 10);
+}
+
+/**
+ * \test Successfull if headers claiming more rides than the text holds or more cars than
+ *       allowed are answered with an error before the instance is read.
+ */
+TEST_F(ServerTest, forgedHeaders) {
+    Client client(socketPath);
+    EXPECT_THROW(client.solve("3 4 2 4000000000 2 10\n0 0 1 3 2 9\n", false),
+                 std::runtime_error);
+    EXPECT_THROW(client.solve("3 4 4000000000 0 2 10\n", false), std::runtime_error);
+
+    // a snapshot without rides and with a forged number of cars
+    std::istringstream input("3 4 2 0 2 10\n");
+    std::ostringstream snapshot;
+    InputData::genFromStream(input)->writeSnapshot(snapshot);
+    std::string forged = snapshot.str();
+    const std::uint32_t fleetSize = 4000000000u;
+    std::memcpy(&forged[sizeof(InputData::SNAPSHOT_MAGIC) + 2 * sizeof(std::uint32_t)],
+                &fleetSize, sizeof(fleetSize));
+    EXPECT_THROW(client.solve(forged, true), std::runtime_error);
+
+    EXPECT_EQ(client.solve(ExampleInstance::text, false).score, 10);
+    EXPECT_EQ(server->getStats().failed, 3);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
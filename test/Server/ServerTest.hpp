@@ -0,0 +1,21 @@
+#ifndef SERVER_TEST_H
+#define SERVER_TEST_H
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+#include "Server.hpp"
+
+class ServerTest : public ::testing::Test {
+protected:
+    ServerTest();
+    virtual void SetUp();
+    virtual void TearDown();
+
+    std::string socketPath;
+    std::unique_ptr<Server> server;
+    std::thread thread;
+};
+
+#endif // SERVER_TEST_H
@@ -0,0 +1,94 @@
+#include <sstream>
+#include <stdexcept>
+#include "InstanceGeneratorTest.hpp"
+
+InstanceGeneratorTest::InstanceGeneratorTest() {
+    parameters.rows = 50;
+    parameters.cols = 80;
+    parameters.fleetSize = 7;
+    parameters.nRides = 2000;
+    parameters.bonus = 3;
+    parameters.maxTime = 1000;
+    parameters.slack = 100;
+    parameters.hotspots = 2;
+};
+
+/**
+ * \test Successfull if the rides of all distributions are valid and can be finished in time.
+ */
+TEST_F(InstanceGeneratorTest, validRides) {
+    for(const std::string& distribution : InstanceGenerator::distributionNames()) {
+        parameters.distribution = distribution;
+        const InputData inputData = *InstanceGenerator(parameters).generate();
+        EXPECT_EQ(inputData.nRides, 2000);
+        EXPECT_EQ(inputData.fleetSize, 7);
+        EXPECT_EQ(inputData.bonus, 3);
+
+        for(unsigned ride = 0; ride < inputData.nRides; ++ride) {
+            ASSERT_GE(inputData.startX(ride), 0);
+            ASSERT_LT(inputData.startX(ride), 50);
+            ASSERT_GE(inputData.endY(ride), 0);
+            ASSERT_LT(inputData.endY(ride), 80);
+            ASSERT_GE(inputData.startT(ride), 0);
+            ASSERT_LE(inputData.startT(ride) + inputData.distances(ride), inputData.endT(ride));
+            ASSERT_LE(inputData.endT(ride), 1000);
+        }
+    }
+}
+
+/**
+ * \test Successfull if equal seeds produce equal inputs and the text output can be read.
+ */
+TEST_F(InstanceGeneratorTest, reproducible) {
+    parameters.distribution = "rush-hour";
+    std::ostringstream first;
+    std::ostringstream second;
+    InstanceGenerator(parameters).generate()->write(first);
+    InstanceGenerator(parameters).generate()->write(second);
+    EXPECT_EQ(first.str(), second.str());
+
+    parameters.seed = 2;
+    std::ostringstream other;
+    InstanceGenerator(parameters).generate()->write(other);
+    EXPECT_NE(first.str(), other.str());
+
+    std::istringstream input(first.str());
+    std::ostringstream copy;
+    InputData::genFromStream(input)->write(copy);
+    EXPECT_EQ(copy.str(), first.str());
+}
+
+/**
+ * \test Checks if the rush-hour distribution concentrates rides in its peaks.
+ */
+TEST_F(InstanceGeneratorTest, rushHourPeaks) {
+    parameters.distribution = "rush-hour";
+    const InputData inputData = *InstanceGenerator(parameters).generate();
+    unsigned inPeaks = 0;
+
+    for(unsigned ride = 0; ride < inputData.nRides; ++ride) {
+        const int startT = inputData.startT(ride);
+
+        if((startT >= 200 && startT < 400) || (startT >= 600 && startT < 800)) {++inPeaks;}
+    }
+
+    // uniform: 40 %, peaks: 80 % * 95 % + 20 % * 40 %
+    EXPECT_GT(inPeaks, inputData.nRides * 0.7);
+}
+
+/**
+ * \test Successfull if invalid parameters are rejected.
+ */
+TEST_F(InstanceGeneratorTest, invalidParameters) {
+    parameters.distribution = "gaussian";
+    EXPECT_THROW(InstanceGenerator generator(parameters), std::invalid_argument);
+    parameters.distribution = "uniform";
+    parameters.rows = 0;
+    EXPECT_THROW(InstanceGenerator generator(parameters), std::invalid_argument);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+};
@@ -0,0 +1,14 @@
+#ifndef INSTANCE_GENERATOR_TEST_H
+#define INSTANCE_GENERATOR_TEST_H
+
+#include <gtest/gtest.h>
+#include "InstanceGenerator.hpp"
+
+class InstanceGeneratorTest : public ::testing::Test {
+protected:
+    InstanceGeneratorTest();
+
+    InstanceGenerator::Parameters parameters;
+};
+
+#endif // INSTANCE_GENERATOR_TEST_H